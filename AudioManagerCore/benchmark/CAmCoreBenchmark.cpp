@@ -0,0 +1,41 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include "CAmLogWrapper.h"
+
+using namespace am;
+
+/**
+ * The benchmarks use google-benchmark, all its command line options apply.
+ * Machine readable results are written with --benchmark_out=<file> --benchmark_out_format=json
+ */
+int main(int argc, char **argv)
+{
+    CAmLogWrapper::instantiateOnce("CBEN", "Core Benchmark", LS_OFF, LOG_SERVICE_OFF);
+    ::benchmark::Initialize(&argc, argv);
+    if (::benchmark::ReportUnrecognizedArguments(argc, argv))
+    {
+        return (1);
+    }
+
+    ::benchmark::RunSpecifiedBenchmarks();
+    ::benchmark::Shutdown();
+    return (0);
+}
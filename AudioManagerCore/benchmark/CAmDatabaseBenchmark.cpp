@@ -0,0 +1,205 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <sstream>
+#include "CAmDatabaseHandlerMap.h"
+
+using namespace am;
+
+namespace
+{
+
+const uint16_t SOUND_PROPERTIES = 32;
+
+/**
+ * A database with one domain, one sink class and a given number of sinks.
+ */
+class CAmDatabaseFixture
+{
+public:
+    CAmDatabaseFixture(const int64_t sinks, const uint16_t soundProperties = 0)
+        : mDatabase()
+        , mDomainID(0)
+        , mSinkClassID(0)
+        , mListSinkIDs()
+    {
+        am_Domain_s domain;
+        domain.domainID = 0;
+        domain.name     = "benchmarkDomain";
+        domain.busname  = "benchmarkBus";
+        domain.nodename = "benchmarkNode";
+        domain.early    = false;
+        domain.complete = true;
+        domain.state    = DS_CONTROLLED;
+        mDatabase.enterDomainDB(domain, mDomainID);
+
+        am_SinkClass_s sinkClass;
+        sinkClass.sinkClassID = 0;
+        sinkClass.name        = "benchmarkSinkClass";
+        mDatabase.enterSinkClassDB(sinkClass, mSinkClassID);
+
+        for (int64_t i = 0; i < sinks; i++)
+        {
+            am_sinkID_t sinkID;
+            mDatabase.enterSinkDB(createSink(i, soundProperties), sinkID);
+            mListSinkIDs.push_back(sinkID);
+        }
+    }
+
+    am_Sink_s createSink(const int64_t number, const uint16_t soundProperties) const
+    {
+        std::ostringstream name;
+        name << "sink" << number;
+
+        am_Sink_s sink;
+        sink.sinkID       = 0;
+        sink.name         = name.str();
+        sink.domainID     = mDomainID;
+        sink.sinkClassID  = mSinkClassID;
+        sink.volume       = 0;
+        sink.visible      = true;
+        sink.available.availability       = A_AVAILABLE;
+        sink.available.availabilityReason = AR_UNKNOWN;
+        sink.muteState    = MS_UNMUTED;
+        sink.mainVolume   = 0;
+        sink.listConnectionFormats.push_back(CF_GENIVI_STEREO);
+        for (uint16_t type = 0; type < soundProperties; type++)
+        {
+            am_SoundProperty_s property;
+            property.type  = type + 1;
+            property.value = 0;
+            sink.listSoundProperties.push_back(property);
+        }
+
+        return (sink);
+    }
+
+    CAmDatabaseHandlerMap    mDatabase;
+    am_domainID_t            mDomainID;
+    am_sinkClass_t           mSinkClassID;
+    std::vector<am_sinkID_t> mListSinkIDs;
+};
+
+}
+
+/**
+ * Enters a sink into a populated database and removes it again.
+ */
+static void BM_DatabaseEnterRemoveSink(benchmark::State &state)
+{
+    CAmDatabaseFixture fixture(state.range(0));
+    const am_Sink_s    sink = fixture.createSink(state.range(0), 0);
+    am_sinkID_t        sinkID;
+
+    for (auto _ : state)
+    {
+        fixture.mDatabase.enterSinkDB(sink, sinkID);
+        fixture.mDatabase.removeSinkDB(sinkID);
+    }
+
+    state.SetItemsProcessed(state.iterations() * 2);
+}
+
+BENCHMARK(BM_DatabaseEnterRemoveSink)->Arg(10)->Arg(1000);
+
+/**
+ * Looks up the sinks of a populated database one after the other.
+ */
+static void BM_DatabaseGetSinkInfo(benchmark::State &state)
+{
+    CAmDatabaseFixture fixture(state.range(0));
+    am_Sink_s          sink;
+    size_t             index = 0;
+
+    for (auto _ : state)
+    {
+        fixture.mDatabase.getSinkInfoDB(fixture.mListSinkIDs[index], sink);
+        index = (index + 1) % fixture.mListSinkIDs.size();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_DatabaseGetSinkInfo)->Arg(10)->Arg(1000);
+
+static void BM_DatabaseGetListSinks(benchmark::State &state)
+{
+    CAmDatabaseFixture     fixture(state.range(0));
+    std::vector<am_Sink_s> listSinks;
+
+    for (auto _ : state)
+    {
+        fixture.mDatabase.getListSinks(listSinks);
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_DatabaseGetListSinks)->Arg(10)->Arg(1000);
+
+/**
+ * Changes every sound property of every sink in turn.
+ */
+static void BM_DatabaseChangeSinkSoundProperty(benchmark::State &state)
+{
+    CAmDatabaseFixture fixture(state.range(0), SOUND_PROPERTIES);
+    am_SoundProperty_s property;
+    size_t             index = 0;
+
+    property.type  = 1;
+    property.value = 0;
+    for (auto _ : state)
+    {
+        fixture.mDatabase.changeSinkSoundPropertyDB(property, fixture.mListSinkIDs[index]);
+        property.value++;
+        if (++property.type > SOUND_PROPERTIES)
+        {
+            property.type = 1;
+            index         = (index + 1) % fixture.mListSinkIDs.size();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_DatabaseChangeSinkSoundProperty)->Arg(1000);
+
+static void BM_DatabaseGetSinkSoundPropertyValue(benchmark::State &state)
+{
+    CAmDatabaseFixture            fixture(state.range(0), SOUND_PROPERTIES);
+    am_CustomSoundPropertyType_t  type  = 1;
+    size_t                        index = 0;
+    int16_t                       value;
+
+    for (auto _ : state)
+    {
+        fixture.mDatabase.getSinkSoundPropertyValue(fixture.mListSinkIDs[index], type, value);
+        benchmark::DoNotOptimize(value);
+        if (++type > SOUND_PROPERTIES)
+        {
+            type  = 1;
+            index = (index + 1) % fixture.mListSinkIDs.size();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_DatabaseGetSinkSoundPropertyValue)->Arg(1000);
@@ -0,0 +1,103 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <dirent.h>
+#include <unistd.h>
+#include <cstdlib>
+#include <fstream>
+#include <string>
+#include <vector>
+#include "CAmCommandSender.h"
+#include "CAmSocketHandler.h"
+
+using namespace am;
+
+namespace
+{
+
+/**
+ * copies the dummy plugins into a new directory. A library that is already loaded is not initialised
+ * again, so every iteration needs its own copies.
+ */
+std::string copyDummyPlugins(std::vector<std::string> &files)
+{
+    char        pattern[] = "/tmp/AmPluginLoadingXXXXXX";
+    std::string directory = mkdtemp(pattern);
+    DIR        *source    = opendir(DUMMY_PLUGIN_DIR);
+    if (source == NULL)
+    {
+        return (directory);
+    }
+
+    struct dirent *entry;
+    while ((entry = readdir(source)) != NULL)
+    {
+        std::string name(entry->d_name);
+        if ((name.size() > 3) && (name.compare(name.size() - 3, 3, ".so") == 0))
+        {
+            std::ifstream in(std::string(DUMMY_PLUGIN_DIR) + "/" + name, std::ios::binary);
+            std::ofstream out(directory + "/" + name, std::ios::binary);
+            out << in.rdbuf();
+            files.push_back(directory + "/" + name);
+        }
+    }
+
+    closedir(source);
+    return (directory);
+}
+
+}
+
+/**
+ * Loads eight command plugins that each spend 25ms in their static initialisation, which is the startup cost
+ * of the plugin loading. Note: glibc runs static initialisers under its loader lock, so opening the libraries
+ * on several threads does not shorten this.
+ */
+static void BM_CommandPluginLoading(benchmark::State &state)
+{
+    CAmSocketHandler handler;
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        std::vector<std::string> files;
+        std::vector<std::string> directories(1, copyDummyPlugins(files));
+        state.ResumeTiming();
+
+        CAmCommandSender sender(directories, &handler);
+
+        state.PauseTiming();
+        std::vector<std::string> plugins;
+        sender.getListPlugins(plugins);
+        if (plugins.size() != files.size())
+        {
+            state.SkipWithError("not all dummy plugins were loaded");
+        }
+
+        for (std::vector<std::string>::iterator it = files.begin(); it != files.end(); ++it)
+        {
+            unlink(it->c_str());
+        }
+
+        rmdir(directories.front().c_str());
+        state.ResumeTiming();
+    }
+}
+
+BENCHMARK(BM_CommandPluginLoading)->Iterations(3)->UseRealTime()->Unit(benchmark::kMillisecond);
@@ -0,0 +1,417 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include "CAmDatabaseHandlerMap.h"
+#include "CAmControlSender.h"
+#include "CAmRouter.h"
+#include "../test/IAmControlBackdoor.h"
+#include "../test/MockIAmControlSend.h"
+#include "../test/CAmTopologyGenerator.h"
+
+using namespace am;
+
+namespace
+{
+
+/**
+ * A controller that accepts all possible connection formats without going through gmock.
+ */
+class CAmAcceptAllController : public MockIAmControlSend
+{
+public:
+    am_Error_e getConnectionFormatChoice(const am_sourceID_t, const am_sinkID_t, const am_Route_s,
+        const std::vector<am_CustomConnectionFormat_t> listPossibleConnectionFormats,
+        std::vector<am_CustomConnectionFormat_t> &listPrioConnectionFormats) override
+    {
+        listPrioConnectionFormats = listPossibleConnectionFormats;
+        return (E_OK);
+    }
+};
+
+/**
+ * A ring of domains where every pair of neighbours is connected by a number of gateways in both directions,
+ * so the search has to deal with domain cycles. The source lives in the first domain, the sink in the one
+ * farthest away.
+ */
+class CAmRouterFixture
+{
+public:
+    CAmRouterFixture(const int64_t domains, const int64_t gateways)
+        : mDatabase()
+        , mControlSender()
+        , mController()
+        , mRouter(&mDatabase, &mControlSender)
+        , mGenerator(mDatabase)
+        , mSourceID(0)
+        , mSinkID(0)
+    {
+        IAmControlBackdoor backdoor;
+        backdoor.replaceController(&mControlSender, &mController);
+        mDatabase.registerObserver(&mRouter);
+
+        CAmTopologyGenerator::am_TopologyParameters_s parameters = CAmTopologyGenerator::defaultParameters();
+        parameters.domains               = domains;
+        parameters.sourcesPerDomain      = 1;
+        parameters.sinksPerDomain        = 1;
+        parameters.gatewaysPerDomainPair = gateways;
+        parameters.formats               = 1;
+        parameters.cycles                = true;
+        mGenerator.generate(parameters);
+        mSourceID = mGenerator.getListSourceIDs().front();
+        mSinkID   = mGenerator.getListSinkIDs()[domains / 2];
+    }
+
+    CAmDatabaseHandlerMap  mDatabase;
+    CAmControlSender       mControlSender;
+    CAmAcceptAllController mController;
+    CAmRouter              mRouter;
+    CAmTopologyGenerator   mGenerator;
+    am_sourceID_t          mSourceID;
+    am_sinkID_t            mSinkID;
+};
+
+}
+
+/**
+ * Route search on an already loaded routing graph.
+ */
+static void BM_RouterGetRoute(benchmark::State &state)
+{
+    CAmRouterFixture        fixture(state.range(0), state.range(1));
+    std::vector<am_Route_s> listRoutes;
+
+    for (auto _ : state)
+    {
+        fixture.mRouter.getRoute(false, fixture.mSourceID, fixture.mSinkID, listRoutes);
+    }
+
+    if (listRoutes.empty())
+    {
+        state.SkipWithError("no route found");
+    }
+
+    state.counters["routes"] = listRoutes.size();
+}
+
+BENCHMARK(BM_RouterGetRoute)->ArgNames({"domains", "gateways"})
+    ->Args({2, 1})->Args({4, 1})->Args({4, 2})->Args({8, 1})->Args({8, 2})->Args({16, 1});
+
+/**
+ * Route search with a trace report, the difference to BM_RouterGetRoute is the cost of the tracing.
+ */
+static void BM_RouterGetRouteTraced(benchmark::State &state)
+{
+    CAmRouterFixture        fixture(state.range(0), state.range(1));
+    std::vector<am_Route_s> listRoutes;
+    am_RouteTrace_s         trace;
+
+    for (auto _ : state)
+    {
+        fixture.mRouter.getRoute(false, fixture.mSourceID, fixture.mSinkID, listRoutes, trace);
+    }
+
+    if (listRoutes.empty())
+    {
+        state.SkipWithError("no route found");
+    }
+
+    state.counters["paths"] = trace.listPaths.size();
+    state.counters["edges"] = trace.edgesExplored;
+}
+
+BENCHMARK(BM_RouterGetRouteTraced)->ArgNames({"domains", "gateways"})->Args({8, 2});
+
+/**
+ * Route search after a change of the topology, this includes rebuilding the routing graph.
+ * A sink is added and removed again before every search.
+ */
+static void BM_RouterGetRouteReload(benchmark::State &state)
+{
+    CAmRouterFixture        fixture(state.range(0), state.range(1));
+    std::vector<am_Route_s> listRoutes;
+
+    am_Sink_s sink;
+    fixture.mDatabase.getSinkInfoDB(fixture.mSinkID, sink);
+    sink.sinkID = 0;
+    sink.name   = "changedSink";
+    for (auto _ : state)
+    {
+        am_sinkID_t sinkID;
+        fixture.mDatabase.enterSinkDB(sink, sinkID);
+        fixture.mDatabase.removeSinkDB(sinkID);
+        fixture.mRouter.getRoute(false, fixture.mSourceID, fixture.mSinkID, listRoutes);
+    }
+
+    if (listRoutes.empty())
+    {
+        state.SkipWithError("no route found");
+    }
+}
+
+BENCHMARK(BM_RouterGetRouteReload)->ArgNames({"domains", "gateways"})
+    ->Args({4, 1})->Args({8, 2})->Args({16, 1});
+
+namespace
+{
+
+/**
+ * A chain of domains with many sinks and sources each, neighbouring domains are connected by a large number of gateways.
+ * The source lives in the first domain, the sink in the last one.
+ */
+class CAmLargeRouterFixture
+{
+public:
+    CAmLargeRouterFixture(const int64_t elements, const int64_t gateways, const int64_t domains = 2)
+        : mDatabase()
+        , mControlSender()
+        , mController()
+        , mRouter(&mDatabase, &mControlSender)
+        , mGenerator(mDatabase)
+        , mSourceID(0)
+        , mSinkID(0)
+    {
+        IAmControlBackdoor backdoor;
+        backdoor.replaceController(&mControlSender, &mController);
+        mDatabase.registerObserver(&mRouter);
+
+        CAmTopologyGenerator::am_TopologyParameters_s parameters = CAmTopologyGenerator::defaultParameters();
+        parameters.domains               = domains;
+        parameters.sourcesPerDomain      = elements / domains;
+        parameters.sinksPerDomain        = elements / domains;
+        parameters.gatewaysPerDomainPair = gateways;
+        parameters.formats               = 1;
+        mGenerator.generate(parameters);
+        mSourceID = mGenerator.getListSourceIDs().front();
+        mSinkID   = mGenerator.getListSinkIDs().back();
+    }
+
+    CAmDatabaseHandlerMap  mDatabase;
+    CAmControlSender       mControlSender;
+    CAmAcceptAllController mController;
+    CAmRouter              mRouter;
+    CAmTopologyGenerator   mGenerator;
+    am_sourceID_t          mSourceID;
+    am_sinkID_t            mSinkID;
+};
+
+}
+
+/**
+ * Rebuilding the routing graph of a large topology.
+ */
+static void BM_RouterLoad(benchmark::State &state)
+{
+    CAmLargeRouterFixture fixture(state.range(0), state.range(1));
+
+    for (auto _ : state)
+    {
+        fixture.mRouter.load();
+    }
+}
+
+BENCHMARK(BM_RouterLoad)->ArgNames({"elements", "gateways"})->Args({2000, 200})->Unit(benchmark::kMillisecond);
+
+/**
+ * Route search on the already loaded graph of a large topology.
+ */
+static void BM_RouterGetRouteLarge(benchmark::State &state)
+{
+    CAmLargeRouterFixture   fixture(state.range(0), state.range(1));
+    std::vector<am_Route_s> listRoutes;
+    fixture.mRouter.load();
+
+    for (auto _ : state)
+    {
+        fixture.mRouter.getRouteFromLoadedNodes(false, fixture.mSourceID, fixture.mSinkID, listRoutes);
+    }
+
+    if (listRoutes.empty())
+    {
+        state.SkipWithError("no route found");
+    }
+
+    state.counters["routes"] = listRoutes.size();
+}
+
+BENCHMARK(BM_RouterGetRouteLarge)->ArgNames({"elements", "gateways"})->Args({2000, 200})->Unit(benchmark::kMicrosecond);
+
+/**
+ * Route search between a source and a sink in domains without a gateway path in this direction. The source lives in the
+ * middle of a chain of three domains, the sink in the first one.
+ */
+static void BM_RouterGetRouteUnreachable(benchmark::State &state)
+{
+    CAmLargeRouterFixture   fixture(state.range(0), state.range(1), 3);
+    std::vector<am_Route_s> listRoutes;
+    const am_sourceID_t     sourceID = fixture.mGenerator.getListSourceIDs()[fixture.mGenerator.getListSourceIDs().size() / 2];
+    const am_sinkID_t       sinkID   = fixture.mGenerator.getListSinkIDs().front();
+    fixture.mRouter.load();
+
+    for (auto _ : state)
+    {
+        fixture.mRouter.getRouteFromLoadedNodes(false, sourceID, sinkID, listRoutes);
+    }
+
+    if (!listRoutes.empty())
+    {
+        state.SkipWithError("unexpected route found");
+    }
+}
+
+BENCHMARK(BM_RouterGetRouteUnreachable)->ArgNames({"elements", "gateways"})->Args({2000, 100})->Unit(benchmark::kMicrosecond);
+
+/**
+ * Routes from one source to all sinks of a topology with two domains, computed with one call of getRoute per sink.
+ */
+static void BM_RouterRoutesToAllSinksPerPair(benchmark::State &state)
+{
+    CAmLargeRouterFixture           fixture(state.range(0), state.range(1));
+    const std::vector<am_sinkID_t> &listSinkIDs = fixture.mGenerator.getListSinkIDs();
+    std::vector<am_Route_s>         listRoutes, listAllRoutes;
+    fixture.mRouter.load();
+
+    for (auto _ : state)
+    {
+        listAllRoutes.clear();
+        for (auto it = listSinkIDs.begin(); it != listSinkIDs.end(); it++)
+        {
+            fixture.mRouter.getRouteFromLoadedNodes(false, fixture.mSourceID, *it, listRoutes);
+            listAllRoutes.insert(listAllRoutes.end(), listRoutes.begin(), listRoutes.end());
+        }
+    }
+
+    state.counters["sinks"]  = listSinkIDs.size();
+    state.counters["routes"] = listAllRoutes.size();
+}
+
+BENCHMARK(BM_RouterRoutesToAllSinksPerPair)->ArgNames({"elements", "gateways"})->Args({500, 10})->Unit(benchmark::kMillisecond);
+
+/**
+ * The same routes as BM_RouterRoutesToAllSinksPerPair computed in a single search.
+ */
+static void BM_RouterRoutesToAllSinks(benchmark::State &state)
+{
+    CAmLargeRouterFixture           fixture(state.range(0), state.range(1));
+    const std::vector<am_sinkID_t> &listSinkIDs = fixture.mGenerator.getListSinkIDs();
+    std::vector<am_Route_s>         listAllRoutes;
+    std::vector<bool>               listSelected;
+    for (auto it = listSinkIDs.begin(); it != listSinkIDs.end(); it++)
+    {
+        listSelected.resize(std::max<size_t>(listSelected.size(), *it + 1), false);
+        listSelected[*it] = true;
+    }
+
+    CAmRoutingSinkFilter filter = [&listSelected](const am_Sink_s &sink){
+            return sink.sinkID < listSelected.size() && listSelected[sink.sinkID];
+        };
+    fixture.mRouter.getRoutesToAllSinks(false, fixture.mSourceID, filter, listAllRoutes);
+
+    for (auto _ : state)
+    {
+        fixture.mRouter.getRoutesToAllSinks(false, fixture.mSourceID, filter, listAllRoutes);
+    }
+
+    state.counters["sinks"]  = listSinkIDs.size();
+    state.counters["routes"] = listAllRoutes.size();
+}
+
+BENCHMARK(BM_RouterRoutesToAllSinks)->ArgNames({"elements", "gateways"})->Args({500, 10})->Unit(benchmark::kMillisecond);
+
+/**
+ * Routes for 32 pairs of sources in the first and sinks in the second domain of a large topology, the graph is searched
+ * for the pairs on the given number of threads.
+ */
+static void BM_RouterGetRoutesBatch(benchmark::State &state)
+{
+    CAmLargeRouterFixture                                fixture(1000, 50);
+    const std::vector<am_sourceID_t>                    &listSourceIDs = fixture.mGenerator.getListSourceIDs();
+    const std::vector<am_sinkID_t>                      &listSinkIDs   = fixture.mGenerator.getListSinkIDs();
+    std::vector<std::pair<am_sourceID_t, am_sinkID_t> >  listPairs;
+    std::vector<std::vector<am_Route_s> >                listRoutes;
+    for (size_t i = 0; i < 32; i++)
+    {
+        listPairs.push_back(std::make_pair(listSourceIDs[i], listSinkIDs[listSinkIDs.size() - 1 - i]));
+    }
+
+    fixture.mRouter.setRoutingThreads(state.range(0));
+    fixture.mRouter.getRoutes(false, listPairs, listRoutes);
+
+    for (auto _ : state)
+    {
+        fixture.mRouter.getRoutes(false, listPairs, listRoutes);
+    }
+
+    if (listRoutes.back().empty())
+    {
+        state.SkipWithError("no route found");
+    }
+}
+
+BENCHMARK(BM_RouterGetRoutesBatch)->ArgNames({"threads"})->DenseRange(1, 8)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+/**
+ * Enumerates all paths between two nodes of a complete graph with the given number of nodes, either with the std::function
+ * callbacks and the search context of the graph or with lambdas and a search context of the caller.
+ */
+static void BM_GraphGetAllPaths(benchmark::State &state)
+{
+    typedef CAmGraph<int, int> CAmIntGraph;
+    CAmIntGraph                 graph;
+    std::vector<CAmNode<int> *> nodes;
+    for (int i = 0; i < state.range(0); i++)
+    {
+        nodes.push_back(&graph.addNode(i));
+    }
+
+    for (size_t i = 0; i < nodes.size(); i++)
+    {
+        for (size_t j = 0; j < nodes.size(); j++)
+        {
+            if (i != j)
+            {
+                graph.connectNodes(*nodes[i], *nodes[j], 0);
+            }
+        }
+    }
+
+    CAmIntGraph::CAmSearchContext context;
+    CAmIntGraph::weight_t         sum = 0;
+    auto                          cbShouldVisitNode = [](const CAmNode<int> *){ return true; };
+    auto                          cbVisitNode = [](const CAmNode<int> *){ };
+    auto                          cbDidFindPath = [&sum](const std::vector<CAmNode<int> *> &, const CAmIntGraph::weight_t weight){
+            sum += weight;
+        };
+
+    for (auto _ : state)
+    {
+        if (state.range(1))
+        {
+            graph.getAllPaths(*nodes.front(), *nodes.back(), context, cbShouldVisitNode, cbVisitNode, cbVisitNode, cbDidFindPath);
+        }
+        else
+        {
+            graph.getAllPaths(*nodes.front(), *nodes.back(), cbShouldVisitNode, cbVisitNode, cbVisitNode, cbDidFindPath);
+        }
+    }
+
+    benchmark::DoNotOptimize(sum);
+}
+
+BENCHMARK(BM_GraphGetAllPaths)->ArgNames({"nodes", "context"})->Args({8, 0})->Args({8, 1})->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,87 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include <unistd.h>
+#include "IAmCommand.h"
+
+/**
+ * A command plugin that does nothing but take DUMMY_INIT_DELAY_MS in its static initialisation,
+ * like plugins with heavy CommonAPI or D-Bus stubs do. It is built several times as
+ * lib<DUMMY_PLUGIN_NAME>.so to measure the plugin loading at startup.
+ */
+#define DUMMY_CONCAT(a, b)  a ## b
+#define DUMMY_FACTORY(name) DUMMY_CONCAT(name, Factory)
+#define DUMMY_DESTROY(name) DUMMY_CONCAT(destroy, name)
+
+using namespace am;
+
+namespace
+{
+
+struct CAmDummyStaticInit
+{
+    CAmDummyStaticInit()
+    {
+        usleep(DUMMY_INIT_DELAY_MS * 1000);
+    }
+} dummyStaticInit;
+
+class CAmDummyCommandPlugin : public IAmCommandSend
+{
+public:
+    void getInterfaceVersion(std::string &version) const { version = CommandVersion; }
+    am_Error_e startupInterface(IAmCommandReceive *) { return (E_OK); }
+    void setCommandReady(const uint16_t) {}
+    void setCommandRundown(const uint16_t) {}
+    void cbNewMainConnection(const am_MainConnectionType_s &) {}
+    void cbRemovedMainConnection(const am_mainConnectionID_t) {}
+    void cbNewSink(const am_SinkType_s &) {}
+    void cbRemovedSink(const am_sinkID_t) {}
+    void cbNewSource(const am_SourceType_s &) {}
+    void cbRemovedSource(const am_sourceID_t) {}
+    void cbNumberOfSinkClassesChanged() {}
+    void cbNumberOfSourceClassesChanged() {}
+    void cbMainConnectionStateChanged(const am_mainConnectionID_t, const am_ConnectionState_e) {}
+    void cbMainSinkSoundPropertyChanged(const am_sinkID_t, const am_MainSoundProperty_s &) {}
+    void cbMainSourceSoundPropertyChanged(const am_sourceID_t, const am_MainSoundProperty_s &) {}
+    void cbSinkAvailabilityChanged(const am_sinkID_t, const am_Availability_s &) {}
+    void cbSourceAvailabilityChanged(const am_sourceID_t, const am_Availability_s &) {}
+    void cbVolumeChanged(const am_sinkID_t, const am_mainVolume_t) {}
+    void cbSinkMuteStateChanged(const am_sinkID_t, const am_MuteState_e) {}
+    void cbSystemPropertyChanged(const am_SystemProperty_s &) {}
+    void cbTimingInformationChanged(const am_mainConnectionID_t, const am_timeSync_t) {}
+    void cbSinkUpdated(const am_sinkID_t, const am_sinkClass_t, const std::vector<am_MainSoundProperty_s> &) {}
+    void cbSourceUpdated(const am_sourceID_t, const am_sourceClass_t, const std::vector<am_MainSoundProperty_s> &) {}
+    void cbSinkNotification(const am_sinkID_t, const am_NotificationPayload_s &) {}
+    void cbSourceNotification(const am_sourceID_t, const am_NotificationPayload_s &) {}
+    void cbMainSinkNotificationConfigurationChanged(const am_sinkID_t, const am_NotificationConfiguration_s &) {}
+    void cbMainSourceNotificationConfigurationChanged(const am_sourceID_t, const am_NotificationConfiguration_s &) {}
+};
+
+}
+
+extern "C" IAmCommandSend *DUMMY_FACTORY(DUMMY_PLUGIN_NAME)()
+{
+    return (new CAmDummyCommandPlugin());
+}
+
+extern "C" void DUMMY_DESTROY(DUMMY_PLUGIN_NAME)(IAmCommandSend *plugin)
+{
+    delete plugin;
+}
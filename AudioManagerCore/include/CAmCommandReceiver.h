@@ -55,6 +55,9 @@ public:
     am_Error_e setSystemProperty(const am_SystemProperty_s &property);
     am_Error_e setSystemProperties(const std::vector<am_SystemProperty_s> &listSystemProperties);
     am_Error_e getVolume(const am_sinkID_t sinkID, am_mainVolume_t &mainVolume) const;
+    uint32_t getJournalVersion() const;
+    am_Error_e getJournalChanges(const uint32_t sinceVersion, std::vector<am_JournalEntry_s> &listChanges) const;
+    am_Error_e getJournalSnapshot(am_JournalSnapshot_s &snapshot) const;
     am_Error_e getListMainConnections(std::vector<am_MainConnectionType_s> &listConnections) const;
     am_Error_e getListMainSinks(std::vector<am_SinkType_s> &listMainSinks) const;
     am_Error_e getListMainSources(std::vector<am_SourceType_s> &listMainSources) const;
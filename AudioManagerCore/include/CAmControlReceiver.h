@@ -64,6 +64,8 @@ public:
     am_Error_e enterGatewayDB(const am_Gateway_s &gatewayData, am_gatewayID_t &gatewayID);
     am_Error_e enterConverterDB(const am_Converter_s &converterData, am_converterID_t &converterID);
     am_Error_e enterSourceDB(const am_Source_s &sourceData, am_sourceID_t &sourceID);
+    am_Error_e enterSinksDB(const std::vector<am_Sink_s> &listSinkData, std::vector<am_sinkID_t> &listSinkIDs);
+    am_Error_e enterSourcesDB(const std::vector<am_Source_s> &listSourceData, std::vector<am_sourceID_t> &listSourceIDs);
     am_Error_e enterSinkClassDB(const am_SinkClass_s &sinkClass, am_sinkClass_t &sinkClassID);
     am_Error_e enterSourceClassDB(am_sourceClass_t &sourceClassID, const am_SourceClass_s &sourceClass);
     am_Error_e changeSinkClassInfoDB(const am_SinkClass_s &sinkClass);
@@ -90,6 +92,16 @@ public:
     am_Error_e removeMainConnectionDB(const am_mainConnectionID_t mainConnectionID);
     am_Error_e removeSinkDB(const am_sinkID_t sinkID);
     am_Error_e removeSourceDB(const am_sourceID_t sourceID);
+    am_Error_e removeSinksDB(const std::vector<am_sinkID_t> &listSinkIDs);
+    am_Error_e removeSourcesDB(const std::vector<am_sourceID_t> &listSourceIDs);
+    void setConnectionFormatChoiceCaching(const bool enable);
+    void invalidateConnectionFormatChoices();
+    am_Error_e getRoutesToAllSinks(const bool onlyfree, const am_sourceID_t sourceID, const std::vector<am_sinkID_t> &listSinkIDs, std::vector<am_Route_s> &returnList);
+    am_Error_e getRoutesFromAllSources(const bool onlyfree, const am_sinkID_t sinkID, const std::vector<am_sourceID_t> &listSourceIDs, std::vector<am_Route_s> &returnList);
+    am_Error_e getRoutes(const bool onlyfree, const std::vector<std::pair<am_sourceID_t, am_sinkID_t> > &listPairs, std::vector<std::vector<am_Route_s> > &listRoutes);
+    uint32_t getJournalVersion() const;
+    am_Error_e getJournalChanges(const uint32_t sinceVersion, std::vector<am_JournalEntry_s> &listChanges) const;
+    am_Error_e getJournalSnapshot(am_JournalSnapshot_s &snapshot) const;
     am_Error_e removeGatewayDB(const am_gatewayID_t gatewayID);
     am_Error_e removeConverterDB(const am_converterID_t converterID);
     am_Error_e removeCrossfaderDB(const am_crossfaderID_t crossfaderID);
@@ -65,6 +65,10 @@ public:
     am_Error_e hookSystemDeregisterSink(const am_sinkID_t sinkID);
     am_Error_e hookSystemRegisterSource(const am_Source_s &sourceData, am_sourceID_t &sourceID);
     am_Error_e hookSystemDeregisterSource(const am_sourceID_t sourceID);
+    am_Error_e hookSystemRegisterSinks(const std::vector<am_Sink_s> &listSinkData, std::vector<am_sinkID_t> &listSinkIDs);
+    am_Error_e hookSystemDeregisterSinks(const std::vector<am_sinkID_t> &listSinkIDs);
+    am_Error_e hookSystemRegisterSources(const std::vector<am_Source_s> &listSourceData, std::vector<am_sourceID_t> &listSourceIDs);
+    am_Error_e hookSystemDeregisterSources(const std::vector<am_sourceID_t> &listSourceIDs);
     am_Error_e hookSystemRegisterGateway(const am_Gateway_s &gatewayData, am_gatewayID_t &gatewayID);
     am_Error_e hookSystemRegisterConverter(const am_Converter_s &converterData, am_converterID_t &converterID);
     am_Error_e hookSystemDeregisterGateway(const am_gatewayID_t gatewayID);
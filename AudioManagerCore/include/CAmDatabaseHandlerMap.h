@@ -32,6 +32,7 @@
 #include <algorithm>
 #include <assert.h>
 #include <vector>
+#include <stdexcept>
 #include "IAmDatabaseHandler.h"
 
 namespace am
@@ -48,6 +49,10 @@ namespace am
 # define AM_MAX_MAIN_CONNECTIONS SHRT_MAX
 #endif
 
+#ifndef AM_JOURNAL_CAPACITY
+# define AM_JOURNAL_CAPACITY 256
+#endif
+
 // todo: check the enum values before entering & changing in the database.
 // todo: change asserts for dynamic boundary checks into failure answers.#
 // todo: check autoincrement boundary and set to 16bit limits
@@ -91,6 +96,10 @@ public:
         std::function<void(const am_mainConnectionID_t)> dboRemovedMainConnection;
         std::function<void(const am_sinkID_t, const bool)> dboRemovedSink;
         std::function<void(const am_sourceID_t, const bool)> dboRemovedSource;
+        std::function<void(const std::vector<am_Sink_s> &)> dboNewSinks;                               //!< optional, dboNewSink is called per sink if not set
+        std::function<void(const std::vector<am_Source_s> &)> dboNewSources;                           //!< optional, dboNewSource is called per source if not set
+        std::function<void(const std::vector<am_sinkID_t> &, const std::vector<bool> &)> dboRemovedSinks;     //!< optional, dboRemovedSink is called per sink if not set
+        std::function<void(const std::vector<am_sourceID_t> &, const std::vector<bool> &)> dboRemovedSources; //!< optional, dboRemovedSource is called per source if not set
         std::function<void(const am_domainID_t)> dboRemoveDomain;
         std::function<void(const am_gatewayID_t)> dboRemoveGateway;
         std::function<void(const am_converterID_t)> dboRemoveConverter;
@@ -129,6 +138,8 @@ public:
     am_Error_e enterGatewayDB(const am_Gateway_s &gatewayData, am_gatewayID_t &gatewayID);
     am_Error_e enterConverterDB(const am_Converter_s &converterData, am_converterID_t &converterID);
     am_Error_e enterSourceDB(const am_Source_s &sourceData, am_sourceID_t &sourceID);
+    am_Error_e enterSinksDB(const std::vector<am_Sink_s> &listSinkData, std::vector<am_sinkID_t> &listSinkIDs);
+    am_Error_e enterSourcesDB(const std::vector<am_Source_s> &listSourceData, std::vector<am_sourceID_t> &listSourceIDs);
     am_Error_e enterConnectionDB(const am_Connection_s &connection, am_connectionID_t &connectionID, bool allowReserved = false) override;
     am_Error_e enterSinkClassDB(const am_SinkClass_s &sinkClass, am_sinkClass_t &sinkClassID);
     am_Error_e enterSourceClassDB(am_sourceClass_t &sourceClassID, const am_SourceClass_s &sourceClass);
@@ -161,6 +172,8 @@ public:
     am_Error_e removeMainConnectionDB(const am_mainConnectionID_t mainConnectionID);
     am_Error_e removeSinkDB(const am_sinkID_t sinkID);
     am_Error_e removeSourceDB(const am_sourceID_t sourceID);
+    am_Error_e removeSinksDB(const std::vector<am_sinkID_t> &listSinkIDs);
+    am_Error_e removeSourcesDB(const std::vector<am_sourceID_t> &listSourceIDs);
     am_Error_e removeGatewayDB(const am_gatewayID_t gatewayID);
     am_Error_e removeConverterDB(const am_converterID_t converterID);
     am_Error_e removeCrossfaderDB(const am_crossfaderID_t crossfaderID);
@@ -257,6 +270,9 @@ public:
     am_Error_e enumerateSinks(std::function<void(const am_Sink_s &element)> cb) const;
     am_Error_e enumerateGateways(std::function<void(const am_Gateway_s &element)> cb) const;
     am_Error_e enumerateConverters(std::function<void(const am_Converter_s &element)> cb) const;
+    uint32_t getJournalVersion() const;
+    am_Error_e getJournalChanges(const uint32_t sinceVersion, std::vector<am_JournalEntry_s> &listChanges) const;
+    am_Error_e getJournalSnapshot(am_JournalSnapshot_s &snapshot) const;
 
     bool registerObserver(IAmDatabaseObserver *iObserver);
     bool unregisterObserver(IAmDatabaseObserver *iObserver);
@@ -290,25 +306,386 @@ public:
         void getDescription(std::string &outString) const; \
     } TYPE                                                 \
 
-#define AM_SUBLCASS_ADD_MAP_TYPE(TYPE, NAME) std::unordered_map<TYPE, int16_t> NAME;
-#define AM_SUBLCASS_ADD_ASSIGNMENT(NAME)     NAME = anObject.NAME;
+#define AM_SUBLCASS_ADD_INDEX_TYPE(TYPE, NAME) AmPropertyIndex<TYPE> NAME;
+#define AM_SUBLCASS_ADD_ASSIGNMENT(NAME)       NAME = anObject.NAME;
 
 private:
+    /**
+     * Flat index over a sound property list, sorted by property type.
+     * Only the position of each property in the list is kept here, so the values exist once
+     * and the list getters can still hand out the list in the order it was registered.
+     * Lookups are a binary search over a small contiguous array.
+     */
+    template <typename TPropertyType>
+    class AmPropertyIndex
+    {
+        typedef std::pair<TPropertyType, uint16_t> AmIndexEntry;
+        std::vector<AmIndexEntry> mIndex;
+
+        static bool lessType(const AmIndexEntry &entry, const TPropertyType type)
+        {
+            return entry.first < type;
+        }
+
+    public:
+        /**
+         * Rebuilds the index, has to be called whenever the types in the list change.
+         */
+        template <class TProperty>
+        void rebuild(const std::vector<TProperty> &list)
+        {
+            mIndex.clear();
+            mIndex.reserve(list.size());
+            for (uint16_t position = 0; position < list.size(); ++position)
+            {
+                mIndex.push_back(AmIndexEntry(list[position].type, position));
+            }
+
+            std::stable_sort(mIndex.begin(), mIndex.end(), [](const AmIndexEntry &a, const AmIndexEntry &b) {
+                    return a.first < b.first;
+                });
+        }
+
+        /**
+         * Returns the property of the given type or NULL if the list does not contain it.
+         */
+        template <class TProperty>
+        TProperty *find(std::vector<TProperty> &list, const TPropertyType type) const
+        {
+            typename std::vector<AmIndexEntry>::const_iterator iter = std::lower_bound(mIndex.begin(), mIndex.end(), type, lessType);
+            if (iter == mIndex.end() || iter->first != type || iter->second >= list.size())
+            {
+                return NULL;
+            }
+
+            return &list[iter->second];
+        }
+
+        template <class TProperty>
+        const TProperty *find(const std::vector<TProperty> &list, const TPropertyType type) const
+        {
+            return find(const_cast<std::vector<TProperty> &>(list), type);
+        }
+    };
+
+    /**
+     * Maps the names of the elements of one table to their keys. The index only keeps the hash of every name,
+     * the names themselves stay in the elements, so a lookup compares against the name of the element.
+     * Names are not unique in every table, so a name can refer to several keys.
+     */
+    template <typename TMapKey, class TMap>
+    class AmNameIndex
+    {
+        typedef std::unordered_multimap<size_t, TMapKey> AmKeysByHash;
+        const TMap &mMap;
+        AmKeysByHash mKeys;
+        std::unordered_map<TMapKey, size_t> mHashes;
+        std::hash<std::string> mHash;
+
+    public:
+        explicit AmNameIndex(const TMap &map)
+            : mMap(map), mKeys(), mHashes(), mHash() {}
+
+        /**
+         * Sets the name of the element with the given key, replaces a previous one.
+         * The element in the map has to carry the name already.
+         */
+        void set(const TMapKey key, const std::string &name)
+        {
+            const size_t hash = mHash(name);
+            typename std::unordered_map<TMapKey, size_t>::const_iterator iter = mHashes.find(key);
+            if (iter != mHashes.end())
+            {
+                if (iter->second == hash)
+                {
+                    return;
+                }
+
+                remove(key);
+            }
+
+            mHashes[key] = hash;
+            mKeys.insert(std::make_pair(hash, key));
+        }
+
+        void remove(const TMapKey key)
+        {
+            typename std::unordered_map<TMapKey, size_t>::iterator iter = mHashes.find(key);
+            if (iter == mHashes.end())
+            {
+                return;
+            }
+
+            std::pair<typename AmKeysByHash::iterator, typename AmKeysByHash::iterator> range = mKeys.equal_range(iter->second);
+            for (typename AmKeysByHash::iterator keyIter = range.first; keyIter != range.second; ++keyIter)
+            {
+                if (keyIter->second == key)
+                {
+                    mKeys.erase(keyIter);
+                    break;
+                }
+            }
+
+            mHashes.erase(iter);
+        }
+
+        /**
+         * Returns the first key carrying the name and accepted by the predicate.
+         */
+        template <class TPredicate>
+        bool find(const std::string &name, TMapKey &key, TPredicate predicate) const
+        {
+            std::pair<typename AmKeysByHash::const_iterator, typename AmKeysByHash::const_iterator> range = mKeys.equal_range(mHash(name));
+            for (typename AmKeysByHash::const_iterator iter = range.first; iter != range.second; ++iter)
+            {
+                if (mMap.at(iter->second).name == name && predicate(iter->second))
+                {
+                    key = iter->second;
+                    return (true);
+                }
+            }
+
+            return (false);
+        }
+
+        bool find(const std::string &name, TMapKey &key) const
+        {
+            return find(name, key, [](const TMapKey){ return true; });
+        }
+    };
+
+    /**
+     * Slot map holding the elements of one table.
+     * The elements are kept in one contiguous vector of slots, a second vector indexed directly
+     * by the (16 bit) key holds the slot of each key. Removed elements leave a tombstone, which is
+     * reused by the next insert, so the slot of an element never changes while it exists.
+     * Lookups are a single array access, iterations walk over the slots from the most recently
+     * filled one downwards and skip the tombstones.
+     * References to elements are invalidated by inserts of new keys, like for std::vector.
+     */
+    template <typename TMapKey, class TMapObject>
+    class AmDenseMap
+    {
+    public:
+        typedef TMapKey                              key_type;
+        typedef TMapObject                           mapped_type;
+        typedef std::pair<TMapKey, TMapObject>       value_type;
+        typedef size_t                               size_type;
+
+    private:
+        enum { NO_SLOT = UINT32_MAX };
+
+        struct AmSlot
+        {
+            bool used;
+            value_type entry;
+
+            AmSlot(const TMapKey key)
+                : used(true), entry(key, TMapObject()) {}
+        };
+
+        std::vector<uint32_t> mIndex;     //!< slot of every key or NO_SLOT
+        std::vector<AmSlot> mSlots;       //!< the elements and tombstones
+        std::vector<uint32_t> mFreeSlots; //!< tombstones to be reused
+        size_t mSize;
+
+        template <class TSlot, class TValue>
+        class AmIterator
+        {
+            friend class AmDenseMap;
+            TSlot *mSlots;
+            size_t mPosition; //!< slot + 1, 0 is the end
+
+            AmIterator(TSlot *slots, const size_t position)
+                : mSlots(slots), mPosition(position)
+            {
+                skipTombstones();
+            }
+
+            void skipTombstones()
+            {
+                while (mPosition != 0 && !mSlots[mPosition - 1].used)
+                {
+                    --mPosition;
+                }
+            }
+
+        public:
+            typedef std::forward_iterator_tag iterator_category;
+            typedef TValue                    value_type;
+            typedef ptrdiff_t                 difference_type;
+            typedef TValue                   *pointer;
+            typedef TValue                   &reference;
+
+            AmIterator()
+                : mSlots(NULL), mPosition(0) {}
+
+            template <class TOtherSlot, class TOtherValue>
+            AmIterator(const AmIterator<TOtherSlot, TOtherValue> &other)
+                : mSlots(other.mSlots), mPosition(other.mPosition) {}
+
+            reference operator*() const { return (mSlots[mPosition - 1].entry); }
+            pointer operator->() const { return (&mSlots[mPosition - 1].entry); }
+
+            AmIterator &operator++()
+            {
+                --mPosition;
+                skipTombstones();
+                return (*this);
+            }
+
+            AmIterator operator++(int)
+            {
+                AmIterator previous(*this);
+                ++(*this);
+                return (previous);
+            }
+
+            template <class TOtherSlot, class TOtherValue>
+            bool operator==(const AmIterator<TOtherSlot, TOtherValue> &other) const { return (mPosition == other.mPosition); }
+            template <class TOtherSlot, class TOtherValue>
+            bool operator!=(const AmIterator<TOtherSlot, TOtherValue> &other) const { return (mPosition != other.mPosition); }
+
+            template <class, class>
+            friend class AmIterator;
+        };
+
+        uint32_t slotOf(const TMapKey key) const
+        {
+            return (static_cast<size_t>(key) < mIndex.size() ? mIndex[key] : NO_SLOT);
+        }
+
+    public:
+        typedef AmIterator<AmSlot, value_type>                   iterator;
+        typedef AmIterator<const AmSlot, const value_type>       const_iterator;
+
+        explicit AmDenseMap(const size_t capacity = 0)
+            : mIndex(), mSlots(), mFreeSlots(), mSize(0)
+        {
+            mSlots.reserve(capacity);
+        }
+
+        iterator begin() { return (iterator(mSlots.data(), mSlots.size())); }
+        iterator end() { return (iterator(mSlots.data(), 0)); }
+        const_iterator begin() const { return (const_iterator(mSlots.data(), mSlots.size())); }
+        const_iterator end() const { return (const_iterator(mSlots.data(), 0)); }
+
+        size_t size() const { return (mSize); }
+        bool empty() const { return (mSize == 0); }
+        size_t count(const TMapKey key) const { return (slotOf(key) != NO_SLOT ? 1 : 0); }
+
+        iterator find(const TMapKey key)
+        {
+            const uint32_t slot = slotOf(key);
+            if (slot == NO_SLOT)
+            {
+                return (end());
+            }
+
+            return (iterator(mSlots.data(), slot + 1));
+        }
+
+        const_iterator find(const TMapKey key) const
+        {
+            const uint32_t slot = slotOf(key);
+            if (slot == NO_SLOT)
+            {
+                return (end());
+            }
+
+            return (const_iterator(mSlots.data(), slot + 1));
+        }
+
+        TMapObject &at(const TMapKey key)
+        {
+            const uint32_t slot = slotOf(key);
+            if (slot == NO_SLOT)
+            {
+                throw std::out_of_range("AmDenseMap::at");
+            }
+
+            return (mSlots[slot].entry.second);
+        }
+
+        const TMapObject &at(const TMapKey key) const
+        {
+            return (const_cast<AmDenseMap *>(this)->at(key));
+        }
+
+        TMapObject &operator[](const TMapKey key)
+        {
+            uint32_t slot = slotOf(key);
+            if (slot != NO_SLOT)
+            {
+                return (mSlots[slot].entry.second);
+            }
+
+            if (mIndex.size() <= static_cast<size_t>(key))
+            {
+                mIndex.resize(static_cast<size_t>(key) + 1, static_cast<uint32_t>(NO_SLOT));
+            }
+
+            if (mFreeSlots.empty())
+            {
+                slot = mSlots.size();
+                mSlots.push_back(AmSlot(key));
+            }
+            else
+            {
+                slot = mFreeSlots.back();
+                mFreeSlots.pop_back();
+                mSlots[slot].used        = true;
+                mSlots[slot].entry.first = key;
+            }
+
+            mIndex[key] = slot;
+            ++mSize;
+            return (mSlots[slot].entry.second);
+        }
+
+        size_t erase(const TMapKey key)
+        {
+            const uint32_t slot = slotOf(key);
+            if (slot == NO_SLOT)
+            {
+                return (0);
+            }
+
+            // the tombstone must not keep the lists of the removed element alive
+            mSlots[slot].used         = false;
+            mSlots[slot].entry.second = TMapObject();
+            mFreeSlots.push_back(slot);
+            mIndex[key] = NO_SLOT;
+            --mSize;
+            return (1);
+        }
+
+        void clear()
+        {
+            mIndex.clear();
+            mSlots.clear();
+            mFreeSlots.clear();
+            mSize = 0;
+        }
+    };
+
     AM_SUBCLASS(AmDomain, am_Domain_Database_s, am_Domain_s, , );
 
     AM_SUBCLASS(AmSink, am_Sink_Database_s, am_Sink_s,                                        \
         void getSinkType(am_SinkType_s & sinkType) const;                                     \
-        AM_SUBLCASS_ADD_MAP_TYPE(am_CustomSoundPropertyType_t, cacheSoundProperties)          \
-        AM_SUBLCASS_ADD_MAP_TYPE(am_CustomMainSoundPropertyType_t, cacheMainSoundProperties), \
-        AM_SUBLCASS_ADD_ASSIGNMENT(cacheSoundProperties)                                      \
-        AM_SUBLCASS_ADD_ASSIGNMENT(cacheMainSoundProperties));
+        void rebuildPropertyIndex();                                                          \
+        AM_SUBLCASS_ADD_INDEX_TYPE(am_CustomSoundPropertyType_t, indexSoundProperties)        \
+        AM_SUBLCASS_ADD_INDEX_TYPE(am_CustomMainSoundPropertyType_t, indexMainSoundProperties), \
+        AM_SUBLCASS_ADD_ASSIGNMENT(indexSoundProperties)                                      \
+        AM_SUBLCASS_ADD_ASSIGNMENT(indexMainSoundProperties));
 
     AM_SUBCLASS(AmSource, am_Source_Database_s, am_Source_s,
         void getSourceType(am_SourceType_s & sourceType) const;                               \
-        AM_SUBLCASS_ADD_MAP_TYPE(am_CustomSoundPropertyType_t, cacheSoundProperties)          \
-        AM_SUBLCASS_ADD_MAP_TYPE(am_CustomMainSoundPropertyType_t, cacheMainSoundProperties), \
-        AM_SUBLCASS_ADD_ASSIGNMENT(cacheSoundProperties)                                      \
-        AM_SUBLCASS_ADD_ASSIGNMENT(cacheMainSoundProperties));
+        void rebuildPropertyIndex();                                                          \
+        AM_SUBLCASS_ADD_INDEX_TYPE(am_CustomSoundPropertyType_t, indexSoundProperties)        \
+        AM_SUBLCASS_ADD_INDEX_TYPE(am_CustomMainSoundPropertyType_t, indexMainSoundProperties), \
+        AM_SUBLCASS_ADD_ASSIGNMENT(indexSoundProperties)                                      \
+        AM_SUBLCASS_ADD_ASSIGNMENT(indexMainSoundProperties));
 
     AM_SUBCLASS(AmConnection, am_Connection_Database_s, am_Connection_s, , );
 
@@ -326,16 +703,16 @@ private:
 
     AM_SUBCLASS(AmCrossfader, am_Crossfader_Database_s, am_Crossfader_s, , );
 
-    typedef std::unordered_map<am_domainID_t, AmDomain>                 AmMapDomain;
-    typedef std::unordered_map<am_sourceClass_t, AmSourceClass>         AmMapSourceClass;
-    typedef std::unordered_map<am_sinkClass_t, AmSinkClass>             AmMapSinkClass;
-    typedef std::unordered_map<am_sinkID_t, AmSink>                     AmMapSink;
-    typedef std::unordered_map<am_sourceID_t, AmSource>                 AmMapSource;
-    typedef std::unordered_map<am_gatewayID_t, AmGateway>               AmMapGateway;
-    typedef std::unordered_map<am_converterID_t, AmConverter>           AmMapConverter;
-    typedef std::unordered_map<am_crossfaderID_t, AmCrossfader>         AmMapCrossfader;
-    typedef std::unordered_map<am_connectionID_t, AmConnection>         AmMapConnection;
-    typedef std::unordered_map<am_mainConnectionID_t, AmMainConnection> AmMapMainConnection;
+    typedef AmDenseMap<am_domainID_t, AmDomain>                         AmMapDomain;
+    typedef AmDenseMap<am_sourceClass_t, AmSourceClass>                 AmMapSourceClass;
+    typedef AmDenseMap<am_sinkClass_t, AmSinkClass>                     AmMapSinkClass;
+    typedef AmDenseMap<am_sinkID_t, AmSink>                             AmMapSink;
+    typedef AmDenseMap<am_sourceID_t, AmSource>                         AmMapSource;
+    typedef AmDenseMap<am_gatewayID_t, AmGateway>                       AmMapGateway;
+    typedef AmDenseMap<am_converterID_t, AmConverter>                   AmMapConverter;
+    typedef AmDenseMap<am_crossfaderID_t, AmCrossfader>                 AmMapCrossfader;
+    typedef AmDenseMap<am_connectionID_t, AmConnection>                 AmMapConnection;
+    typedef AmDenseMap<am_mainConnectionID_t, AmMainConnection>         AmMapMainConnection;
     typedef std::vector<am_SystemProperty_s>                            AmVectorSystemProperties;
     /**
      * The following structure groups the map objects needed for the implementation.
@@ -389,6 +766,12 @@ private:
         AmMapConnection mConnectionMap;             //!< map for connection structures
         AmMapMainConnection mMainConnectionMap;     //!< map for main connection structures
 
+        AmNameIndex<am_domainID_t, AmMapDomain> mDomainNames;                 //!< domain names
+        AmNameIndex<am_sourceClass_t, AmMapSourceClass> mSourceClassNames;    //!< source class names
+        AmNameIndex<am_sinkClass_t, AmMapSinkClass> mSinkClassNames;          //!< sink class names
+        AmNameIndex<am_sinkID_t, AmMapSink> mSinkNames;                       //!< sink names
+        AmNameIndex<am_sourceID_t, AmMapSource> mSourceNames;                 //!< source names
+
         AmMappedData() : // For Domain, MainConnections, Connections we don't have static IDs.
             mCurrentDomainID(DYNAMIC_ID_BOUNDARY, SHRT_MAX)
             , mCurrentSourceClassesID(DYNAMIC_ID_BOUNDARY, SHRT_MAX)
@@ -411,6 +794,11 @@ private:
             , mCrossfaderMap()
             , mConnectionMap()
             , mMainConnectionMap()
+            , mDomainNames(mDomainMap)
+            , mSourceClassNames(mSourceClassesMap)
+            , mSinkClassNames(mSinkClassesMap)
+            , mSinkNames(mSinkMap)
+            , mSourceNames(mSourceMap)
         {}
         /**
          * \brief Increases a given map ID.
@@ -450,9 +838,9 @@ private:
         }
 
         template <typename TPrintMapKey, class TPrintMapObject>
-        static void printMap(const std::unordered_map<TPrintMapKey, TPrintMapObject> &t, std::ostream &output)
+        static void printMap(const AmDenseMap<TPrintMapKey, TPrintMapObject> &t, std::ostream &output)
         {
-            typename std::unordered_map<TPrintMapKey, TPrintMapObject>::const_iterator iter = t.begin();
+            typename AmDenseMap<TPrintMapKey, TPrintMapObject>::const_iterator iter = t.begin();
             for (; iter != t.end(); iter++)
             {
                 AmMappedData::print(iter->second, output);
@@ -462,7 +850,7 @@ private:
     private:
         template <typename TMapKey, class TMapObject>
         bool getNextConnectionID(int16_t &resultID, AmIdentifier &connID,
-            const std::unordered_map<TMapKey, TMapObject> &map);
+            const AmDenseMap<TMapKey, TMapObject> &map);
 
     };
 
@@ -478,6 +866,10 @@ private:
     bool insertSourceDB(const am_Source_s &sourceData, am_sourceID_t &sourceID);
     bool insertSinkClassDB(const am_SinkClass_s &sinkClass, am_sinkClass_t &sinkClassID);
     bool insertSourceClassDB(am_sourceClass_t &sourceClassID, const am_SourceClass_s &sourceClass);
+    am_Error_e enterSinkEntry(const am_Sink_s &sinkData, am_sinkID_t &sinkID);       //!< enterSinkDB without observer notification
+    am_Error_e enterSourceEntry(const am_Source_s &sourceData, am_sourceID_t &sourceID); //!< enterSourceDB without observer notification
+    am_Error_e removeSinkEntry(const am_sinkID_t sinkID, bool &visible);             //!< removeSinkDB without observer notification
+    am_Error_e removeSourceEntry(const am_sourceID_t sourceID, bool &visible);       //!< removeSourceDB without observer notification
     const am_Sink_Database_s *sinkWithNameOrID(const am_sinkID_t sinkID, const std::string &name) const;
     const am_Source_Database_s *sourceWithNameOrID(const am_sourceID_t sourceID, const std::string &name) const;
 
@@ -511,9 +903,13 @@ private:
             });
     }
 
+    void journalChange(const am_JournalElement_e element, const am_JournalOperation_e operation, const uint16_t elementID);
+
     ListConnectionFormat mListConnectionFormat; //!< list of connection formats
     AmMappedData         mMappedData;           //!< Internal structure encapsulating all the maps used in this class
     std::vector<AmDatabaseObserverCallbacks *> mDatabaseObservers;
+    std::vector<am_JournalEntry_s> mJournal;    //!< ring with the last AM_JOURNAL_CAPACITY changes
+    uint32_t             mJournalVersion;       //!< version of the last change
 
 #ifdef UNIT_TEST
 public:
@@ -33,6 +33,7 @@
 #include <queue>
 #include <algorithm>
 #include <limits.h>
+#include <limits>
 #include <iomanip>
 #include <cstring>
 #include <set>
@@ -129,6 +130,65 @@ public:
 template <class T, class V>
 class CAmGraph
 {
+public:
+    typedef uint16_t vertex_t;
+    typedef uint32_t weight_t;     //!< sum of vertex weights along a path, wider than the weight of a single vertex
+
+    /**
+     * Traversal state of the searches on a graph. A context can be reused for any number of searches and keeps its buffers, so
+     * repeated searches on a graph of the same size don't allocate. Searches with different contexts can run concurrently as long
+     * as the graph is not modified, the nodes themselves are not touched by the searches.
+     */
+    class CAmSearchContext
+    {
+        friend class CAmGraph;
+        typedef typename std::vector<std::pair<CAmNode<T> *, uint16_t> > CAmListIncoming;
+
+        std::vector<uint32_t>                           mVisited;       //!< epoch in which a node was visited, indexed by the node index
+        uint32_t                                        mEpoch;         //!< epoch of the current search, nodes of older epochs are not visited
+        std::vector<CAmNode<T> *>                       mPath;          //!< current path of a path enumeration
+        std::vector<CAmNode<T> *>                       mReversedPath;  //!< current path of a backward path enumeration in forward order
+        std::vector<CAmListIncoming>                    mIncoming;      //!< incoming vertices of the nodes for backward path enumerations
+        std::vector<weight_t>                           mMinDistance;   //!< distances found by the shortest path search
+        std::vector<CAmNode<T> *>                       mPrevious;      //!< previous nodes found by the shortest path search
+        std::vector<std::pair<weight_t, CAmNode<T> *> > mQueue;         //!< binary heap of the shortest path search
+
+        /**
+         * Starts a new search, all nodes count as not visited afterwards.
+         */
+        void begin(const size_t numberOfNodes)
+        {
+            if (mVisited.size() < numberOfNodes)
+            {
+                mVisited.resize(numberOfNodes, 0);
+            }
+
+            // the marks of all previous searches become invalid at once, only a wrap around needs a reset
+            if (++mEpoch == 0)
+            {
+                std::fill(mVisited.begin(), mVisited.end(), 0);
+                mEpoch = 1;
+            }
+
+            mPath.clear();
+        }
+
+        bool isVisited(const CAmNode<T> *node) const { return mVisited[node->getIndex()] == mEpoch; }
+        void setVisited(const CAmNode<T> *node, const bool visited) { mVisited[node->getIndex()] = visited ? mEpoch : 0; }
+
+    public:
+        CAmSearchContext()
+            : mVisited()
+            , mEpoch(0)
+            , mPath()
+            , mReversedPath()
+            , mIncoming()
+            , mMinDistance()
+            , mPrevious()
+            , mQueue() { }
+    };
+
+private:
     typedef typename std::vector<CAmNode<T> *>                   CAmListNodePtrs;
     typedef typename std::list<CAmVertex<T, V> >                 CAmListVertices;
     typedef typename std::list<CAmVertex<T, V> >::iterator       CAmListVerticesItr;
@@ -148,17 +208,35 @@ class CAmGraph
     CAmVertexReferenceList mPointersAdjList;        //!< CAmVertexReferenceList vector with pointers to vertices for direct access
     bool                   mIsCyclic;               //!< bool the graph has cycles or not
 
+    CAmSearchContext       mSearchContext;          //!< context of the searches that are not given one by the caller
+
+    /**
+     * The callbacks of a path enumeration. They are template parameters, so they are called directly and not through std::function.
+     * If traverseEndNodes is set the end nodes are searched further like any other node, this is needed if more than one end node is searched for.
+     * Otherwise every end node is reported once per path and not searched further.
+     */
+    template <bool traverseEndNodes, class TIsEndNode, class TShouldVisitNode, class TWillVisitNode, class TDidVisitNode, class TDidFindPath>
     struct IterateThroughAllNodesDelegate
     {
-        CAmNode<T> *source;
-        CAmNode<T> *destination;
-        CAmNodeReferenceList visited;
-        std::function<bool(const CAmNode<T> *)> shouldVisitNode;
-        std::function<void(const CAmNode<T> *)> willVisitNode;
-        std::function<void(const CAmNode<T> *)> didVisitNode;
-        std::function<void(const CAmNodeReferenceList &path)> didFindPath;
+        static const bool traverseEnds = traverseEndNodes;
+        TIsEndNode       &isEndNode;
+        TShouldVisitNode &shouldVisitNode;
+        TWillVisitNode   &willVisitNode;
+        TDidVisitNode    &didVisitNode;
+        TDidFindPath     &didFindPath;
+        weight_t          weight;     //!< sum of the vertex weights along the current path
     };
 
+    template <bool traverseEndNodes, class TIsEndNode, class TShouldVisitNode, class TWillVisitNode, class TDidVisitNode, class TDidFindPath>
+    static IterateThroughAllNodesDelegate<traverseEndNodes, TIsEndNode, TShouldVisitNode, TWillVisitNode, TDidVisitNode, TDidFindPath>
+    makeDelegate(TIsEndNode &isEndNode, TShouldVisitNode &shouldVisitNode, TWillVisitNode &willVisitNode, TDidVisitNode &didVisitNode,
+        TDidFindPath &didFindPath)
+    {
+        IterateThroughAllNodesDelegate<traverseEndNodes, TIsEndNode, TShouldVisitNode, TWillVisitNode, TDidVisitNode, TDidFindPath> delegate =
+            { isEndNode, shouldVisitNode, willVisitNode, didVisitNode, didFindPath, 0 };
+        return delegate;
+    }
+
     struct VisitNodeDelegate
     {
         CAmNode<T> *source;
@@ -184,40 +262,45 @@ class CAmGraph
 
     /**
      * Finds the shortest path and the minimal weights from given node.
+     * The results are stored in context.mMinDistance and context.mPrevious.
      *
      * @param node start node.
-     * @param minDistance vector with all result distances.
-     * @param previous vector with previous nodes.
+     * @param context search context, its buffers are reused.
      */
-
-    typedef uint16_t vertex_t;
-    typedef uint16_t weight_t;
-
-    void findShortestPathsFromNode(const CAmNode<T> &node, std::vector<weight_t> &minDistance, std::vector<CAmNode<T> *> &previous)
+    void findShortestPathsFromNode(const CAmNode<T> &node, CAmSearchContext &context) const
     {
         typename CAmListVertices::const_iterator nIter;
-        CAmListVertices                         *neighbors;
-        weight_t                                 dist, weight, v, distanceThroughU;
+        const CAmListVertices                   *neighbors;
+        weight_t                                 dist, v, distanceThroughU;
         CAmNode<T>                              *pU;
-        CAmVertex<T, V>                         *pVertex;
         CAmNode<T>                              *pDstNode;
 
-        size_t                                       n = mPointersAdjList.size();
-        std::set<std::pair<weight_t, CAmNode<T> *> > vertexQueue;
+        size_t                                           n           = mPointersAdjList.size();
+        std::vector<weight_t>                           &minDistance = context.mMinDistance;
+        std::vector<CAmNode<T> *>                       &previous    = context.mPrevious;
+        std::vector<std::pair<weight_t, CAmNode<T> *> > &vertexQueue = context.mQueue;
+        // the heap has the smallest distance on top, entries that became outdated are skipped instead of removed
+        auto greater = [](const std::pair<weight_t, CAmNode<T> *> &a, const std::pair<weight_t, CAmNode<T> *> &b){
+                return a.first > b.first;
+            };
 
-        minDistance.clear();
-        minDistance.resize(n, std::numeric_limits<weight_t>::max());
+        minDistance.assign(n, std::numeric_limits<weight_t>::max());
         minDistance[node.getIndex()] = 0;
-        previous.clear();
-        previous.resize(n, NULL);
-
-        vertexQueue.insert(std::make_pair(minDistance[node.getIndex()], (CAmNode<T> *) & node));
+        previous.assign(n, NULL);
+        vertexQueue.clear();
+        vertexQueue.push_back(std::make_pair(minDistance[node.getIndex()], (CAmNode<T> *) & node));
 
         while (!vertexQueue.empty())
         {
-            dist = vertexQueue.begin()->first;
-            pU   = vertexQueue.begin()->second;
-            vertexQueue.erase(vertexQueue.begin());
+            std::pop_heap(vertexQueue.begin(), vertexQueue.end(), greater);
+            dist = vertexQueue.back().first;
+            pU   = vertexQueue.back().second;
+            vertexQueue.pop_back();
+            if (dist > minDistance[pU->getIndex()])
+            {
+                continue;
+            }
+
             // todo: terminate the search at this position if you want the path to a target node ( if(pU==target)break; )
 
             // Visit each edge exiting u
@@ -225,18 +308,15 @@ class CAmGraph
             nIter     = neighbors->begin();
             for (; nIter != neighbors->end(); nIter++)
             {
-                pVertex  = (CAmVertex<T, V> *) & (*nIter);
-                pDstNode = pVertex->getNode();
-
+                pDstNode         = nIter->getNode();
                 v                = pDstNode->getIndex();
-                weight           = pVertex->getWeight();
-                distanceThroughU = dist + weight;
-                if (distanceThroughU < minDistance[pDstNode->getIndex()])
+                distanceThroughU = dist + nIter->getWeight();
+                if (distanceThroughU < minDistance[v])
                 {
-                    vertexQueue.erase(std::make_pair(minDistance[v], pDstNode));
                     minDistance[v] = distanceThroughU;
                     previous[v]    = pU;
-                    vertexQueue.insert(std::make_pair(minDistance[v], pDstNode));
+                    vertexQueue.push_back(std::make_pair(distanceThroughU, pDstNode));
+                    std::push_heap(vertexQueue.begin(), vertexQueue.end(), greater);
                 }
             }
         }
@@ -293,56 +373,50 @@ class CAmGraph
     }
 
     /**
-     * Iterate through the nodes and generate all paths to given node.
+     * Iterate through the nodes and generate all paths to the end nodes of the delegate.
+     * Each path is reported in the order of its traversal, the current path is kept in context.mPath.
      *
-     * @param dst end node.
-     * @param visited vector with current path.
      * @param delegate enumeration delegate.
+     * @param adjacency the outgoing vertices of the nodes, or the incoming ones for a backward search.
+     * @param context search context with the visited state of the nodes.
      */
-    void findAllPaths(IterateThroughAllNodesDelegate &delegate)
+    template <class TDelegate, class TAdjacency>
+    void findAllPaths(TDelegate &delegate, const TAdjacency &adjacency, CAmSearchContext &context) const
     {
-        CAmListVertices        *nodes = mPointersAdjList[delegate.visited.back()->getIndex()];
-        CAmListVerticesItrConst vItr(nodes->begin());
-
-        CAmVertex<T, V> *pNextVertex;
-        CAmNode<T>      *pNextNode;
-        for (; vItr != nodes->end(); ++vItr)
+        const size_t index = context.mPath.back()->getIndex();
+        CAmNode<T>  *pNextNode;
+        for (auto vItr = adjacency.begin(index); vItr != adjacency.end(index); ++vItr)
         {
-            pNextVertex = (CAmVertex<T, V> *) & (*vItr);
-            pNextNode   = pNextVertex->getNode();
+            pNextNode = adjacency.node(vItr);
             if (
-                pNextNode->getStatus() != GES_NOT_VISITED ||
+                context.isVisited(pNextNode) ||
+                !delegate.isEndNode(pNextNode) ||
                 !delegate.shouldVisitNode(pNextNode)
                 )
             {
                 continue;
             }
 
-            if (pNextNode == delegate.destination)
+            delegate.willVisitNode(pNextNode);
+            context.setVisited(pNextNode, true);
+            context.mPath.push_back(pNextNode);
+            // notify observer
+            delegate.didFindPath(context.mPath, delegate.weight + adjacency.weight(vItr));
+            context.mPath.pop_back();
+            context.setVisited(pNextNode, false);
+            delegate.didVisitNode(pNextNode);
+            if (!TDelegate::traverseEnds)
             {
-                delegate.willVisitNode(pNextNode);
-                pNextNode->setStatus(GES_IN_PROGRESS);
-                delegate.visited.push_back(pNextNode);
-                // notify observer
-                delegate.didFindPath(delegate.visited);
-                // remove last node from the list
-                auto last = delegate.visited.end() - 1;
-                delegate.visited.erase(last);
-                pNextNode->setStatus(GES_NOT_VISITED);
-                delegate.didVisitNode(pNextNode);
                 break;
             }
         }
 
-        vItr = nodes->begin();
-        // bfs like loop
-        for (; vItr != nodes->end(); ++vItr)
+        // dfs loop
+        for (auto vItr = adjacency.begin(index); vItr != adjacency.end(index); ++vItr)
         {
-            pNextVertex = (CAmVertex<T, V> *) & (*vItr);
-            pNextNode   = pNextVertex->getNode();
-
-            if (pNextNode->getStatus() != GES_NOT_VISITED ||
-                pNextNode == delegate.destination ||
+            pNextNode = adjacency.node(vItr);
+            if (context.isVisited(pNextNode) ||
+                (!TDelegate::traverseEnds && delegate.isEndNode(pNextNode)) ||
                 !delegate.shouldVisitNode(pNextNode)
                 )
             {
@@ -350,17 +424,56 @@ class CAmGraph
             }
 
             delegate.willVisitNode(pNextNode);
-            pNextNode->setStatus(GES_IN_PROGRESS);
-            delegate.visited.push_back(pNextNode);
-            findAllPaths(delegate);
-            // remove last node from the list
-            auto last = delegate.visited.end() - 1;
-            delegate.visited.erase(last);
-            pNextNode->setStatus(GES_NOT_VISITED);
+            context.setVisited(pNextNode, true);
+            context.mPath.push_back(pNextNode);
+            delegate.weight += adjacency.weight(vItr);
+            findAllPaths(delegate, adjacency, context);
+            delegate.weight -= adjacency.weight(vItr);
+            context.mPath.pop_back();
+            context.setVisited(pNextNode, false);
             delegate.didVisitNode(pNextNode);
         }
     }
 
+    /**
+     * Starts findAllPaths from given node.
+     */
+    template <class TDelegate, class TAdjacency>
+    void findAllPathsFrom(const CAmNode<T> &node, TDelegate &delegate, const TAdjacency &adjacency, CAmSearchContext &context) const
+    {
+        context.begin(mPointersNodes.size());
+        context.mPath.push_back((CAmNode<T> *) & node);
+        context.setVisited(&node, true);
+        findAllPaths(delegate, adjacency, context);
+        context.setVisited(&node, false);
+        context.mPath.clear();
+    }
+
+    /**
+     * Access to the outgoing vertices of the nodes for findAllPaths.
+     */
+    struct OutgoingAdjacency
+    {
+        const CAmVertexReferenceList &lists;
+        CAmListVerticesItrConst begin(const size_t index) const { return lists[index]->begin(); }
+        CAmListVerticesItrConst end(const size_t index) const { return lists[index]->end(); }
+        CAmNode<T> *node(const CAmListVerticesItrConst &it) const { return it->getNode(); }
+        uint16_t weight(const CAmListVerticesItrConst &it) const { return it->getWeight(); }
+    };
+
+    /**
+     * Access to the incoming vertices of the nodes for findAllPaths, they are built from the adjacency list in the search context.
+     */
+    struct IncomingAdjacency
+    {
+        typedef typename CAmSearchContext::CAmListIncoming::const_iterator CAmListIncomingItrConst;
+        const std::vector<typename CAmSearchContext::CAmListIncoming>     &lists;
+        CAmListIncomingItrConst begin(const size_t index) const { return lists[index].begin(); }
+        CAmListIncomingItrConst end(const size_t index) const { return lists[index].end(); }
+        CAmNode<T> *node(const CAmListIncomingItrConst &it) const { return it->first; }
+        uint16_t weight(const CAmListIncomingItrConst &it) const { return it->second; }
+    };
+
 public:
 
     explicit CAmGraph(const std::vector<T> &v)
@@ -368,6 +481,7 @@ public:
         , mStoreAdjList()
         , mPointersNodes()
         , mPointersAdjList()
+        , mSearchContext()
     {
         typedef typename std::vector<T>::const_iterator inItr;
         inItr itr(v.begin());
@@ -385,7 +499,8 @@ public:
         , mStoreAdjList()
         , mPointersNodes()
         , mPointersAdjList()
-        , mIsCyclic(false){}
+        , mIsCyclic(false)
+        , mSearchContext(){}
     ~CAmGraph(){}
 
     const CAmListNodes &getNodes() const
@@ -525,7 +640,7 @@ public:
     /**
      * Connect first with last node and set user data and weight to the vertex.
      */
-    void connectNodes(const CAmNode<T> &first, const CAmNode<T> &last, const V &vertexData, const int16_t weight = 1)
+    void connectNodes(const CAmNode<T> &first, const CAmNode<T> &last, const V &vertexData, const uint16_t weight = 1)
     {
         CAmListVertices *list = mPointersAdjList[first.getIndex()];
         CAmNode<T>      *node = mPointersNodes[last.getIndex()];
@@ -610,9 +725,8 @@ public:
             return;
         }
 
-        std::vector<weight_t>     min_distance;
-        std::vector<CAmNode<T> *> previous;
-        findShortestPathsFromNode(source, min_distance, previous);
+        findShortestPathsFromNode(source, mSearchContext);
+        const std::vector<CAmNode<T> *> &previous = mSearchContext.mPrevious;
 
         for (auto it = listTargets.begin(); it != listTargets.end(); it++)
         {
@@ -643,9 +757,8 @@ public:
             return;
         }
 
-        std::vector<weight_t>     min_distance;
-        std::vector<CAmNode<T> *> previous;
-        findShortestPathsFromNode(source, min_distance, previous);
+        findShortestPathsFromNode(source, mSearchContext);
+        const std::vector<CAmNode<T> *> &previous = mSearchContext.mPrevious;
         constructShortestPathTo(destination, previous, resultPath);
     }
 
@@ -667,9 +780,8 @@ public:
             return;
         }
 
-        std::vector<weight_t>     min_distance;
-        std::vector<CAmNode<T> *> previous;
-        findShortestPathsFromNode(source, min_distance, previous);
+        findShortestPathsFromNode(source, mSearchContext);
+        const std::vector<CAmNode<T> *> &previous = mSearchContext.mPrevious;
 
         for (auto it = listTargets.begin(); it != listTargets.end(); it++)
         {
@@ -696,12 +808,57 @@ public:
             return;
         }
 
-        std::vector<weight_t>     min_distance;
-        std::vector<CAmNode<T> *> previous;
-        findShortestPathsFromNode(source, min_distance, previous);
+        findShortestPathsFromNode(source, mSearchContext);
+        const std::vector<CAmNode<T> *> &previous = mSearchContext.mPrevious;
         constructShortestPathTo(destination, previous, cb);
     }
 
+    /**
+     * Finds all possible paths between two given nodes with the given search context.
+     * Delegates the construction of the path to the caller, the callbacks can be any callable objects.
+     *
+     * @param src start node.
+     * @param dst destination node.
+     * @param context search context, different contexts allow concurrent searches.
+     * @param cbShouldVisitNode bool(const CAmNode<T> *), ask the delegate if we should proceed with the current node.
+     * @param cbWillVisitNode void(const CAmNode<T> *), tell the delegate the current node will be visited.
+     * @param cbDidVisitNode void(const CAmNode<T> *), tell the delegate the current node was visited.
+     * @param cbDidFindPath void(const CAmNodeReferenceList &path, const weight_t weight), return the path and the sum of its vertex weights to the delegate.
+     */
+    template <class TShouldVisitNode, class TWillVisitNode, class TDidVisitNode, class TDidFindPath>
+    void getAllPaths(const CAmNode<T> &src, const CAmNode<T> &dst, CAmSearchContext &context, TShouldVisitNode &&cbShouldVisitNode,
+        TWillVisitNode &&cbWillVisitNode, TDidVisitNode &&cbDidVisitNode, TDidFindPath &&cbDidFindPath) const
+    {
+        const CAmNode<T> *pDst        = &dst;
+        auto              cbIsEndNode = [pDst](const CAmNode<T> *node){
+                return node == pDst;
+            };
+        auto delegate = makeDelegate<false>(cbIsEndNode, cbShouldVisitNode, cbWillVisitNode, cbDidVisitNode, cbDidFindPath);
+        OutgoingAdjacency adjacency = { mPointersAdjList };
+        findAllPathsFrom(src, delegate, adjacency, context);
+    }
+
+    /**
+     * Finds all possible paths between two given nodes.
+     * Delegates the construction of the path to the caller.
+     *
+     * @param src start node.
+     * @param dst destination node.
+     * @param cbShouldVisitNode ask the delegate if we should proceed with the current node.
+     * @param cbWillVisitNode tell the delegate the current node will be visited.
+     * @param cbDidVisitNode tell the delegate the current node was visited.
+     * @param cbDidFindPath return the path and the sum of its vertex weights to the delegate.
+     */
+    void getAllPaths(CAmNode<T> &src,
+        CAmNode<T> &dst,
+        std::function<bool(const CAmNode<T> *)> cbShouldVisitNode,
+        std::function<void(const CAmNode<T> *)> cbWillVisitNode,
+        std::function<void(const CAmNode<T> *)> cbDidVisitNode,
+        std::function<void(const CAmNodeReferenceList &path, const weight_t weight)> cbDidFindPath)
+    {
+        getAllPaths(src, dst, mSearchContext, cbShouldVisitNode, cbWillVisitNode, cbDidVisitNode, cbDidFindPath);
+    }
+
     /**
      * Finds all possible paths between two given nodes.
      * Delegates the construction of the path to the caller.
@@ -720,17 +877,67 @@ public:
         std::function<void(const CAmNode<T> *)> cbDidVisitNode,
         std::function<void(const CAmNodeReferenceList &path)> cbDidFindPath)
     {
-        IterateThroughAllNodesDelegate delegate;
-        delegate.source          = &src;
-        delegate.destination     = &dst;
-        delegate.shouldVisitNode = cbShouldVisitNode;
-        delegate.willVisitNode   = cbWillVisitNode;
-        delegate.didVisitNode    = cbDidVisitNode;
-        delegate.didFindPath     = cbDidFindPath;
-        delegate.visited.push_back((CAmNode<T> *) & src);
-        ((CAmNode<T> *) & src)->setStatus(GES_VISITED);
-        findAllPaths(delegate);
-        ((CAmNode<T> *) & src)->setStatus(GES_NOT_VISITED);
+        getAllPaths(src, dst, mSearchContext, cbShouldVisitNode, cbWillVisitNode, cbDidVisitNode, [&cbDidFindPath](const CAmNodeReferenceList &path, const weight_t){
+                cbDidFindPath(path);
+            });
+    }
+
+    /**
+     * Finds all possible paths from the given node to every node accepted by cbIsDestination in a single traversal.
+     * For each destination the paths are reported in the same order as getAllPaths would report them.
+     * The callbacks are the same as for getAllPaths.
+     *
+     * @param src start node.
+     * @param context search context, different contexts allow concurrent searches.
+     * @param cbIsDestination bool(const CAmNode<T> *), ask the delegate if the node is one of the destinations.
+     * @param cbDidFindPath return the path and the sum of its vertex weights to the delegate, the destination is the last node.
+     */
+    template <class TIsDestination, class TShouldVisitNode, class TWillVisitNode, class TDidVisitNode, class TDidFindPath>
+    void getAllPathsFromNode(const CAmNode<T> &src, CAmSearchContext &context, TIsDestination &&cbIsDestination,
+        TShouldVisitNode &&cbShouldVisitNode, TWillVisitNode &&cbWillVisitNode, TDidVisitNode &&cbDidVisitNode, TDidFindPath &&cbDidFindPath) const
+    {
+        auto delegate = makeDelegate<true>(cbIsDestination, cbShouldVisitNode, cbWillVisitNode, cbDidVisitNode, cbDidFindPath);
+        OutgoingAdjacency adjacency = { mPointersAdjList };
+        findAllPathsFrom(src, delegate, adjacency, context);
+    }
+
+    /**
+     * Finds all possible paths from every node accepted by cbIsSource to the given node in a single traversal.
+     * The graph is searched backwards along the incoming vertices, the visit callbacks are called in this order.
+     * The callbacks are the same as for getAllPaths.
+     *
+     * @param dst end node.
+     * @param context search context, different contexts allow concurrent searches.
+     * @param cbIsSource bool(const CAmNode<T> *), ask the delegate if the node is one of the start nodes.
+     * @param cbDidFindPath return the path from the start node to dst and the sum of its vertex weights to the delegate.
+     */
+    template <class TIsSource, class TShouldVisitNode, class TWillVisitNode, class TDidVisitNode, class TDidFindPath>
+    void getAllPathsToNode(const CAmNode<T> &dst, CAmSearchContext &context, TIsSource &&cbIsSource,
+        TShouldVisitNode &&cbShouldVisitNode, TWillVisitNode &&cbWillVisitNode, TDidVisitNode &&cbDidVisitNode, TDidFindPath &&cbDidFindPath) const
+    {
+        // the inner lists keep their capacity, so only a grown graph allocates
+        context.mIncoming.resize(mPointersNodes.size());
+        for (auto it = context.mIncoming.begin(); it != context.mIncoming.end(); ++it)
+        {
+            it->clear();
+        }
+
+        for (size_t index = 0; index < mPointersAdjList.size(); index++)
+        {
+            for (auto it = mPointersAdjList[index]->begin(); it != mPointersAdjList[index]->end(); ++it)
+            {
+                context.mIncoming[it->getNode()->getIndex()].push_back(std::make_pair(mPointersNodes[index], it->getWeight()));
+            }
+        }
+
+        std::vector<CAmNode<T> *> &path         = context.mReversedPath;
+        auto                       cbDidFindReversedPath = [&path, &cbDidFindPath](const CAmNodeReferenceList &visited, const weight_t weight){
+                path.assign(visited.rbegin(), visited.rend());
+                cbDidFindPath(path, weight);
+            };
+        auto delegate = makeDelegate<true>(cbIsSource, cbShouldVisitNode, cbWillVisitNode, cbDidVisitNode, cbDidFindReversedPath);
+        IncomingAdjacency adjacency = { context.mIncoming };
+        findAllPathsFrom(dst, delegate, adjacency, context);
     }
 
 };
@@ -29,6 +29,12 @@
 #include <vector>
 #include <iomanip>
 #include <functional>
+#include <map>
+#include <tuple>
+#include <chrono>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 #include "audiomanagertypes.h"
 #include "CAmGraph.h"
 #include "CAmDatabaseHandlerMap.h"
@@ -176,6 +182,166 @@ typedef std::vector<CAmRoutingListVertices *>     CAmRoutingVertexReferenceList;
 
 class CAmControlSender;
 
+/**
+ * Cost models for the edges of the routing graph. The cost of a path is the sum of the costs of its edges,
+ * getShortestPath and getFirstNShortestPaths return the paths with the lowest cost first.
+ */
+typedef enum
+{
+    RCM_HOPS,           //!< every edge costs 1, the cheapest path is the one with the fewest elements (default)
+    RCM_DELAY,          //!< edges between a source and a sink cost 1 plus the delay of an existing connection between them in ms,
+                        //!< edges without a known delay are charged the unknown delay, see CAmRouter::setUnknownDelay
+    RCM_CUSTOM          //!< the costs are returned by a callback, see CAmRoutingEdgeCost
+} am_RoutingCostModel_e;
+
+/**
+ * Callback of the custom cost model. It returns the cost of the edge from one node to the next one. delay is the delay of an
+ * existing connection between a source and a sink in ms or -1 if it is not known or the edge does not connect a source to a sink.
+ * This allows for example the controller to rate the conversion in gateways and converters.
+ */
+typedef std::function<uint16_t(const am_RoutingNodeData_s &from, const am_RoutingNodeData_s &to, const am_timeSync_t delay)> CAmRoutingEdgeCost;
+
+/**
+ * Filters of the one-to-many route searches, routes are only searched to the sinks or from the sources the filter returns true for.
+ * An empty filter accepts all of them.
+ */
+typedef std::function<bool(const am_Sink_s &sink)>     CAmRoutingSinkFilter;
+typedef std::function<bool(const am_Source_s &source)> CAmRoutingSourceFilter;
+
+/**
+ * Reasons why a traced route search didn't follow an edge or dropped a path, see am_RouteTrace_s.
+ */
+typedef enum
+{
+    RPR_DOMAIN_CYCLE,       //!< the edge leads into a domain that was entered too often on the path already
+    RPR_UNREACHABLE_DOMAIN, //!< the domain of the sink can't be reached from the node the edge leads to
+    RPR_BUSY,               //!< the edge leads to a gateway or converter that is connected already and only free elements are searched
+    RPR_FORMAT_MISMATCH,    //!< the path was found but no connection format permutation is possible for it
+    RPR_MAX
+} am_RoutePruneReason_e;
+
+/**
+ * A path found by a traced route search.
+ */
+struct am_RouteTracePath_s
+{
+    am_Route_s route;           //!< the routing elements of the path, the connection formats are CF_UNKNOWN
+    uint32_t   cost;            //!< cost of the path according to the cost model
+    unsigned   permutations;    //!< number of connection format permutations returned for the path
+    bool       evaluated;       //!< false if the connection formats were not determined because enough routes were found before
+};
+
+/**
+ * Report of a traced route search, see CAmRouter::getRoute. The numbers are summed up over the search without domain cycles and
+ * the second search with cycles which is done if the first one didn't find a route.
+ */
+struct am_RouteTrace_s
+{
+    am_Error_e                       error;                             //!< result of the route search
+    bool                             unreachable;                       //!< the sink domain can't be reached from the source domain, nothing was searched
+    unsigned                         searches;                          //!< number of graph searches
+    unsigned                         nodesExplored;                     //!< nodes the searches appended to a path
+    unsigned                         edgesExplored;                     //!< edges the searches considered, edges back into the current path are not counted
+    unsigned                         pruned[RPR_MAX];                   //!< edges not followed and paths dropped, indexed by am_RoutePruneReason_e
+    unsigned                         connectionFormatChoices;           //!< connection format choices asked from the controller
+    unsigned                         cachedConnectionFormatChoices;     //!< connection format choices taken from the cache
+    std::vector<am_RouteTracePath_s> listPaths;                         //!< all paths the searches found, the cheapest first
+    std::chrono::nanoseconds         loadTime;                          //!< time spent to rebuild the graph, 0 if it was up to date
+    std::chrono::nanoseconds         searchTime;                        //!< time spent in the graph searches
+    std::chrono::nanoseconds         permutationTime;                   //!< time spent to determine the connection formats, including the controller calls
+
+    am_RouteTrace_s()
+        : error(E_UNKNOWN)
+        , unreachable(false)
+        , searches(0)
+        , nodesExplored(0)
+        , edgesExplored(0)
+        , pruned()
+        , connectionFormatChoices(0)
+        , cachedConnectionFormatChoices(0)
+        , listPaths()
+        , loadTime(0)
+        , searchTime(0)
+        , permutationTime(0) { }
+};
+
+/**
+ * Trace policy of the route searches that are not traced, all calls are empty.
+ */
+class CAmRouteNoTrace
+{
+public:
+    void exploreEdge() { }
+    void exploreNode() { }
+    void prune(const am_RoutePruneReason_e) { }
+};
+
+/**
+ * Trace policy of the traced route searches, counts the explored and pruned edges and the explored nodes in the report.
+ */
+class CAmRouteTraceCounter
+{
+public:
+    explicit CAmRouteTraceCounter(am_RouteTrace_s &trace)
+        : mTrace(trace) { }
+
+    void exploreEdge()
+    {
+        mTrace.edgesExplored++;
+    }
+
+    void exploreNode()
+    {
+        mTrace.nodesExplored++;
+    }
+
+    void prune(const am_RoutePruneReason_e reason)
+    {
+        mTrace.pruned[reason]++;
+    }
+
+private:
+    am_RouteTrace_s &mTrace; //!< the report the counts are added to
+};
+
+/**
+ * Keeps track of the domains along the current path of a routing search, so the domain cycle check is answered without a scan of the path.
+ * The path is kept as a stack of runs of nodes in the same domain, and every domain counts how often it was entered along the path.
+ * It answers the same as CAmRouter::shouldGoInDomain for the list of the domains of the nodes on the path.
+ */
+class CAmRoutingDomainTracker
+{
+public:
+    CAmRoutingDomainTracker();
+
+    /**
+     * Starts a new path with a node in the given domain.
+     */
+    void reset(const am_domainID_t domainID);
+
+    /**
+     * A node in the given domain is appended to the path.
+     */
+    void enter(const am_domainID_t domainID);
+
+    /**
+     * The last node of the path is removed.
+     */
+    void leave();
+
+    /**
+     * Checks if a node in the given domain may be appended to the path, the domain may be left and entered again maxCyclesNumber times.
+     */
+    bool shouldGoInDomain(const am_domainID_t domainID, const unsigned maxCyclesNumber) const
+    {
+        return (mRuns.back().first == domainID) || (domainID >= mEntries.size()) || (mEntries[domainID] <= maxCyclesNumber);
+    }
+
+private:
+    std::vector<std::pair<am_domainID_t, unsigned> > mRuns;    //!< domain and number of nodes of the runs along the path, the first one is a sentinel of domain 0
+    std::vector<unsigned>                            mEntries; //!< number of runs along the path, indexed by domainID
+};
+
 /**
  * Implements autorouting algorithm for connecting sinks and sources via different audio domains.
  */
@@ -191,6 +357,42 @@ class CAmRouter : public CAmDatabaseHandlerMap::AmDatabaseObserverCallbacks
     std::map<am_domainID_t, std::vector<CAmRoutingNode *> > mNodeListSinks;         //!< map with pointers to nodes with sinks, used for quick access
     std::map<am_domainID_t, std::vector<CAmRoutingNode *> > mNodeListGateways;      //!< map with pointers to nodes with gateways, used for quick access
     std::map<am_domainID_t, std::vector<CAmRoutingNode *> > mNodeListConverters;    //!< map with pointers to nodes with converters, used for quick access
+    std::vector<CAmRoutingNode *> mSourceNodeIndex;                                 //!< source nodes indexed by sourceID
+    std::vector<CAmRoutingNode *> mSinkNodeIndex;                                   //!< sink nodes indexed by sinkID
+    std::vector<CAmRoutingNode *> mGatewayNodeIndex;                                //!< gateway nodes indexed by the sinkID of their hidden sink
+    std::vector<CAmRoutingNode *> mConverterNodeIndex;                              //!< converter nodes indexed by the sinkID of their hidden sink
+    am_RoutingCostModel_e         mCostModel;                                       //!< cost model used for the edges, default is RCM_HOPS
+    CAmRoutingEdgeCost            mCustomEdgeCost;                                  //!< callback of the RCM_CUSTOM cost model
+    am_timeSync_t                 mUnknownDelay;                                    //!< delay in ms RCM_DELAY assumes for edges without a known delay, default is 0
+    std::map<std::pair<am_sourceID_t, am_sinkID_t>, am_timeSync_t> mConnectionDelays; //!< delays of the existing connections, filled by load()
+    unsigned                      mRoutingThreads;                                  //!< number of threads of getRoutes, default is 0
+    CAmRoutingGraph::CAmSearchContext mSearchContext;                               //!< traversal state of the searches on the calling thread
+    std::vector<std::thread>      mWorkers;                                         //!< worker threads of getRoutes, mRoutingThreads - 1 besides the calling thread
+    std::mutex                    mWorkMutex;                                       //!< guards the members below
+    std::condition_variable       mWorkCondition;                                   //!< wakes up the workers for a new job or to stop
+    std::condition_variable       mWorkDoneCondition;                               //!< signals the calling thread that all workers finished the job
+    const std::function<void(CAmRoutingGraph::CAmSearchContext &)> *mpWork;        //!< the current job of the workers
+    uint64_t                      mWorkGeneration;                                  //!< counts the jobs, a worker runs every job once
+    size_t                        mWorkersBusy;                                     //!< number of workers still running the current job
+    bool                          mWorkersStop;                                     //!< asks the workers to quit
+    std::vector<uint16_t>         mDomainIndex;                                     //!< row of every domain in the reachability matrix, indexed by domainID
+    std::vector<uint64_t>         mDomainReachability;                              //!< bit matrix, row i has a bit set for every domain reachable from domain i
+    size_t                        mDomainReachabilityWords;                         //!< number of 64 bit words per row of the reachability matrix
+
+    typedef std::tuple<am_sourceID_t, am_sinkID_t, std::vector<am_CustomConnectionFormat_t> > CAmConnectionFormatChoiceKey;
+    typedef std::pair<am_Error_e, std::vector<am_CustomConnectionFormat_t> >                  CAmConnectionFormatChoice;
+    bool                                                          mCacheConnectionFormatChoices;  //!< answers of the controller are cached, default is false
+    std::map<CAmConnectionFormatChoiceKey, CAmConnectionFormatChoice> mConnectionFormatChoices;   //!< cached answers of the controller
+    unsigned                                                      mConnectionFormatChoiceHits;    //!< number of answers taken from the cache
+    unsigned                                                      mConnectionFormatChoiceMisses;  //!< number of calls to the controller while the cache is enabled
+    am_RouteTrace_s                                              *mpTrace;                        //!< report of the traced route search in progress, NULL otherwise
+    bool                                                          mTraceRoutes;                   //!< every getRoute is traced and its report logged, default is false
+
+    /**
+     * Asks the controller for the connection formats sorted by priority, or takes the answer from the cache if it is enabled.
+     */
+    am_Error_e getConnectionFormatChoice(const am_sourceID_t sourceID, const am_sinkID_t sinkID, const am_Route_s &route,
+        const std::vector<am_CustomConnectionFormat_t> &listPossibleConnectionFormats, std::vector<am_CustomConnectionFormat_t> &listPriorityConnectionFormats);
 
     /**
      * Check whether given converter or gateway has been connected.
@@ -221,6 +423,110 @@ class CAmRouter : public CAmDatabaseHandlerMap::AmDatabaseObserverCallbacks
      */
     void constructSourceSinkConnections();
 
+    /**
+     * Returns the cost of the edge between two nodes according to the current cost model.
+     */
+    uint16_t edgeCost(const CAmRoutingNode &from, const CAmRoutingNode &to) const;
+
+    /**
+     * Computes which domains can be reached from which domain via the gateways that are connected in the graph.
+     */
+    void constructDomainReachability();
+
+    /**
+     * Checks whether a path from the given node may lead into the given domain. For gateways the domain of their source is used.
+     */
+    bool mayReachDomain(const am_RoutingNodeData_s &nodeData, const am_domainID_t domainID) const;
+
+    /**
+     * Checks whether the given node may be reached from the given domain, the counterpart of mayReachDomain for backward searches.
+     */
+    bool mayBeReachedFromDomain(const am_RoutingNodeData_s &nodeData, const am_domainID_t domainID) const;
+
+    /**
+     * Checks whether a route may lead through the given node, gateways and converters in use are excluded if onlyFree is set.
+     */
+    bool isNodeFree(const am_RoutingNodeData_s &nodeData, const bool onlyFree);
+
+    /**
+     * Paths between a source and a sink sorted by their cost, together with the routes built from them without connection formats.
+     */
+    struct am_RoutingPaths_s
+    {
+        std::vector<CAmRoutingGraph::weight_t>      weights;
+        std::vector<std::vector<CAmRoutingNode *> > nodes;
+        std::vector<am_Route_s>                     routes;
+    };
+
+    /**
+     * Inserts a path behind all paths with the same or a lower cost.
+     */
+    static void insertPath(const std::vector<CAmRoutingNode *> &path, const CAmRoutingGraph::weight_t weight, am_RoutingPaths_s &paths);
+
+    /**
+     * Appends the connection format permutations of the paths to resultPath, the cheapest paths first, until maxPathCount routes have been added.
+     *
+     * @return E_OK if at least one route was added, E_NOT_POSSIBLE otherwise.
+     */
+    am_Error_e cfPermutationsForPaths(am_RoutingPaths_s &paths, const unsigned maxPathCount, std::vector<am_Route_s> &resultPath);
+
+    /**
+     * Finds the first maxPathCount paths between the given node and each of the end nodes in a single search. This method doesn't call load().
+     * If the node is a source the end nodes are sinks, if it is a sink the end nodes are sources and the graph is searched backwards.
+     *
+     * @param onlyFree only disconnected elements should be included or not.
+     * @param cycles allowed domain cycles.
+     * @param maxPathCount max count of returned paths per end node.
+     * @param node start point of the search.
+     * @param listEndNodes the sinks or sources to search for.
+     * @param resultPaths the routes are appended to the list with the same position as their end node.
+     * @return E_OK if at least one route was found, E_NOT_POSSIBLE otherwise.
+     */
+    am_Error_e getFirstNShortestPathsForEach(const bool onlyFree, const unsigned cycles, const unsigned maxPathCount, CAmRoutingNode &node,
+        const std::vector<CAmRoutingNode *> &listEndNodes, std::vector<std::vector<am_Route_s> > &resultPaths);
+
+    /**
+     * Finds all paths between given source and sink sorted by their cost, the routes have no connection formats yet. This method doesn't call load().
+     * The traversal state is kept in context, searches with different contexts can run concurrently.
+     *
+     * @param tracePolicy is told about every explored edge and node and every pruned edge, CAmRouteNoTrace compiles the calls away
+     *        and CAmRouteTraceCounter counts them in a report.
+     */
+    template <class TTracePolicy>
+    void findPaths(const bool onlyFree, const unsigned cycles, const CAmRoutingNode &aSource, const CAmRoutingNode &aSink,
+        CAmRoutingGraph::CAmSearchContext &context, TTracePolicy &tracePolicy, am_RoutingPaths_s &paths);
+
+    /**
+     * Logs the report of a traced route search.
+     */
+    void logRouteTrace(const am_sourceID_t sourceID, const am_sinkID_t sinkID, const am_RouteTrace_s &trace) const;
+
+    /**
+     * Runs findPaths for the pairs at the given positions of listSourceNodes and listSinkNodes on up to mRoutingThreads threads and
+     * returns when all of them are done. The paths are stored at the same position in listPaths.
+     */
+    void findPathsConcurrently(const bool onlyFree, const unsigned cycles, const std::vector<size_t> &listIndexes,
+        const std::vector<CAmRoutingNode *> &listSourceNodes, const std::vector<CAmRoutingNode *> &listSinkNodes,
+        std::vector<am_RoutingPaths_s> &listPaths);
+
+    /**
+     * Runs the job on the calling thread and on all workers, each with its own search context, and returns when all of them are done.
+     */
+    void runOnWorkers(const std::function<void(CAmRoutingGraph::CAmSearchContext &)> &job);
+
+    /**
+     * Main function of a worker thread, it waits for the jobs after generation until the workers are stopped.
+     */
+    void workerMain(uint64_t generation);
+
+    void stopWorkers();
+
+    /**
+     * Common part of getRoutesToAllSinks and getRoutesFromAllSources, searches again with cycles for the end nodes without routes like getRoute.
+     */
+    am_Error_e getRoutesForEach(const bool onlyfree, CAmRoutingNode &node, const std::vector<CAmRoutingNode *> &listEndNodes,
+        std::vector<am_Route_s> &returnList);
+
     /**
      * Construct list with all vertices
      */
@@ -248,14 +554,27 @@ class CAmRouter : public CAmDatabaseHandlerMap::AmDatabaseObserverCallbacks
 
     /**
      * Connection format permutations.
+     * The permutations are generated depth first in the order of the priorities the controller returns for every routing element,
+     * the generation stops as soon as maxCount routes have been found.
      *
      * @return E_OK on success(1 or more paths),  E_NOT_POSSIBLE if the CF couldn't be matached or E_UNKNOWN in any other error case.
      */
-    am_Error_e determineConnectionFormatsForPath(am_Route_s &routeObjects, std::vector<CAmRoutingNode *> &nodes, std::vector<am_Route_s> &result);
-    am_Error_e doConnectionFormatsForPath(am_Route_s &routeObjects, std::vector<CAmRoutingNode *> &route,
-        std::vector<am_RoutingElement_s>::iterator routingElementIterator, std::vector<CAmRoutingNode *>::iterator routeIterator,
+    am_Error_e determineConnectionFormatsForPath(am_Route_s &routeObjects, const std::vector<CAmRoutingNode *> &nodes, const size_t maxCount,
         std::vector<am_Route_s> &result);
-    am_Error_e cfPermutationsForPath(am_Route_s shortestRoute, std::vector<CAmRoutingNode *> resultNodesPath, std::vector<am_Route_s> &resultPath);
+    am_Error_e cfPermutationsForPath(am_Route_s shortestRoute, const std::vector<CAmRoutingNode *> &resultNodesPath, const size_t maxCount,
+        std::vector<am_Route_s> &resultPath);
+
+    /**
+     * Asks the controller for the connection formats of one routing element, the formats of the previous elements must have been set.
+     *
+     * @param routeObjects route with the connection formats chosen so far.
+     * @param nodes the nodes of the path.
+     * @param index index of the routing element.
+     * @param listPriorityConnectionFormats the possible formats sorted by priority.
+     * @return E_OK on success, E_NOT_POSSIBLE if the CF couldn't be matached or E_UNKNOWN in any other error case.
+     */
+    am_Error_e prioritizedConnectionFormats(const am_Route_s &routeObjects, const std::vector<CAmRoutingNode *> &nodes, const size_t index,
+        std::vector<am_CustomConnectionFormat_t> &listPriorityConnectionFormats);
 
     /**
      * Helper method.
@@ -286,11 +605,104 @@ public:
         mMaxPathCount = count;
     }
 
+    unsigned getRoutingThreads() const
+    {
+        return mRoutingThreads;
+    }
+
+    /**
+     * Sets the number of threads on which getRoutes searches the routing graph, 0 or 1 searches on the calling thread only.
+     * The calling thread takes part in the search, the other count - 1 threads are started here and kept until the number
+     * changes or the router is destroyed.
+     */
+    void setRoutingThreads(const unsigned count);
+
     bool getUpdateGraphNodesAction()
     {
         return mUpdateGraphNodesAction;
     }
 
+    am_RoutingCostModel_e getCostModel() const
+    {
+        return mCostModel;
+    }
+
+    /**
+     * Sets the cost model for the edges of the routing graph. The graph is rebuilt with the next call of getRoute().
+     *
+     * @param model the cost model.
+     * @param customEdgeCost callback which returns the edge costs, needed for RCM_CUSTOM.
+     * @return E_OK on success, E_NOT_POSSIBLE if RCM_CUSTOM is set without a callback.
+     */
+    am_Error_e setCostModel(const am_RoutingCostModel_e model, CAmRoutingEdgeCost customEdgeCost = CAmRoutingEdgeCost());
+
+    am_timeSync_t getUnknownDelay() const
+    {
+        return mUnknownDelay;
+    }
+
+    /**
+     * Sets the delay that RCM_DELAY assumes for source to sink edges without a connection or with a connection of unknown delay.
+     * The default of 0 rates such an edge like a connection without any delay, so the search prefers it to every measured
+     * connection. Setting it to the typical delay of a connection in the system rates measured and unmeasured edges alike.
+     *
+     * @param delay the delay in ms.
+     * @return E_OK on success, E_OUT_OF_RANGE if the delay is negative.
+     */
+    am_Error_e setUnknownDelay(const am_timeSync_t delay);
+
+    bool getTraceRoutes() const
+    {
+        return mTraceRoutes;
+    }
+
+    /**
+     * Traces every search of getRoute and logs the report, see the traced getRoute. Meant to find out in the field why a route
+     * was not found or why the search is slow, the searches of getRoutes and getRoutesToAllSinks/getRoutesFromAllSources
+     * are not traced.
+     */
+    void setTraceRoutes(const bool trace)
+    {
+        mTraceRoutes = trace;
+    }
+
+    /**
+     * Checks whether the sink domain can be reached from the source domain via gateways. The answer is computed by load() as
+     * transitive closure over the gateways whose formats allow a connection. Within a domain no formats are checked, so a
+     * positive answer does not guarantee a route but a negative one guarantees that there is none.
+     *
+     * @param sourceDomainID domain of the source.
+     * @param sinkDomainID domain of the sink.
+     * @return false if there is no path, true if there may be one or the domains are not known.
+     */
+    bool isDomainReachable(const am_domainID_t sourceDomainID, const am_domainID_t sinkDomainID) const;
+
+    /**
+     * Enables or disables the cache for the connection format choices of the controller. The answers are cached per sourceID,
+     * sinkID and list of possible connection formats. The cache is cleared when the graph is rebuilt or the cache is disabled.
+     */
+    void setConnectionFormatChoiceCaching(const bool enable);
+
+    bool getConnectionFormatChoiceCaching() const
+    {
+        return mCacheConnectionFormatChoices;
+    }
+
+    /**
+     * Clears the cache for the connection format choices, the controller triggers this if its choices change.
+     */
+    void invalidateConnectionFormatChoices();
+
+    /**
+     * Returns how many connection format choices were taken from the cache and how many were asked from the controller since
+     * the cache was enabled.
+     */
+    void getConnectionFormatChoiceStatistics(unsigned &hits, unsigned &misses) const
+    {
+        hits   = mConnectionFormatChoiceHits;
+        misses = mConnectionFormatChoiceMisses;
+    }
+
     /**
      * Find first mMaxPathCount paths between given source and sink. This method will call the method load() if the parameter mUpdateGraphNodesAction is set which will rebuild the graph.
      *
@@ -303,6 +715,15 @@ public:
     am_Error_e getRoute(const bool onlyfree, const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_Route_s> &returnList);
     am_Error_e getRoute(const bool onlyfree, const am_Source_s &source, const am_Sink_s &sink, std::vector<am_Route_s> &listRoutes);
 
+    /**
+     * Same as getRoute, but the search is traced: trace reports what the search explored and why paths were dropped, how often the
+     * controller was asked for connection formats and how much time was spent in which step. Tracing has no effect on the routes.
+     *
+     * @param trace the report of this search, its previous content is replaced.
+     */
+    am_Error_e getRoute(const bool onlyfree, const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_Route_s> &returnList,
+        am_RouteTrace_s &trace);
+
     /**
      * Find first mMaxPathCount paths between given source and sink after the nodes have been loaded. This method doesn't call load().
      *
@@ -315,8 +736,48 @@ public:
     am_Error_e getRouteFromLoadedNodes(const bool onlyfree, const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_Route_s> &returnList);
     am_Error_e getRouteFromLoadedNodes(const bool onlyfree, const am_Source_s &aSource, const am_Sink_s &aSink, std::vector<am_Route_s> &listRoutes);
 
+    /**
+     * Finds the routes for several pairs of sources and sinks, for every pair the same routes are returned as getRoute would return.
+     * The routing graph is searched for all pairs concurrently on up to getRoutingThreads() threads, while the calling thread waits. The
+     * connection formats are then chosen on the calling thread, so the controller is never called from another thread.
+     * This method will call the method load() if the parameter mUpdateGraphNodesAction is set.
+     *
+     * @param onlyfree only disconnected elements should be included or not.
+     * @param listPairs the sourceIDs and sinkIDs to find routes for.
+     * @param listRoutes the routes of every pair at the same position as the pair, empty if there is none.
+     * @return E_OK if routes were found for all pairs, E_NON_EXISTENT if a source or sink doesn't exist, E_NOT_POSSIBLE otherwise.
+     */
+    am_Error_e getRoutes(const bool onlyfree, const std::vector<std::pair<am_sourceID_t, am_sinkID_t> > &listPairs,
+        std::vector<std::vector<am_Route_s> > &listRoutes);
+
+    /**
+     * Finds the routes from given source to all sinks in one search, for every sink the same routes are returned as getRoute would return.
+     * This method will call the method load() if the parameter mUpdateGraphNodesAction is set.
+     *
+     * @param onlyfree only disconnected elements should be included or not.
+     * @param sourceID start point.
+     * @param filter only sinks accepted by the filter are routed to, all sinks if the filter is empty.
+     * @param returnList the routes grouped by sink in the order of the sinkIDs.
+     * @return E_OK if at least one route was found, E_NON_EXISTENT if the source is unknown, E_NOT_POSSIBLE otherwise.
+     */
+    am_Error_e getRoutesToAllSinks(const bool onlyfree, const am_sourceID_t sourceID, CAmRoutingSinkFilter filter, std::vector<am_Route_s> &returnList);
+
+    /**
+     * Finds the routes from all sources to given sink in one search, for every source the same routes are returned as getRoute would
+     * return, routes with the same cost may come in a different order though.
+     * This method will call the method load() if the parameter mUpdateGraphNodesAction is set.
+     *
+     * @param onlyfree only disconnected elements should be included or not.
+     * @param sinkID end point.
+     * @param filter only sources accepted by the filter are routed from, all sources if the filter is empty.
+     * @param returnList the routes grouped by source in the order of the sourceIDs.
+     * @return E_OK if at least one route was found, E_NON_EXISTENT if the sink is unknown, E_NOT_POSSIBLE otherwise.
+     */
+    am_Error_e getRoutesFromAllSources(const bool onlyfree, const am_sinkID_t sinkID, CAmRoutingSourceFilter filter, std::vector<am_Route_s> &returnList);
+
     /**
      * Find first mMaxPathCount paths between given source and sink. This method doesn't call load().
+     * The paths are sorted by their cost according to the cost model, the cheapest comes first.
      *
      * @param onlyfree only disconnected elements should be included or not.
      * @param cycles allowed domain cycles.
@@ -331,7 +792,7 @@ public:
 
     /**
      * Find the shortest path between given source and sink. This method doesn't call load().
-     * It goes through all possible paths and returns the shortest of them.
+     * It goes through all possible paths and returns the shortest of them, the one with the lowest cost according to the cost model.
      *
      * @param source start point.
      * @param sink end point.
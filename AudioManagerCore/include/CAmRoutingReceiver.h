@@ -72,6 +72,10 @@ public:
     am_Error_e peekSource(const std::string &name, am_sourceID_t &sourceID);
     am_Error_e registerSource(const am_Source_s &sourceData, am_sourceID_t &sourceID);
     am_Error_e deregisterSource(const am_sourceID_t sourceID);
+    am_Error_e registerSinks(const std::vector<am_Sink_s> &listSinkData, std::vector<am_sinkID_t> &listSinkIDs);
+    am_Error_e deregisterSinks(const std::vector<am_sinkID_t> &listSinkIDs);
+    am_Error_e registerSources(const std::vector<am_Source_s> &listSourceData, std::vector<am_sourceID_t> &listSourceIDs);
+    am_Error_e deregisterSources(const std::vector<am_sourceID_t> &listSourceIDs);
     am_Error_e registerCrossfader(const am_Crossfader_s &crossfaderData, am_crossfaderID_t &crossfaderID);
     am_Error_e deregisterCrossfader(const am_crossfaderID_t crossfaderID);
     am_Error_e peekSourceClassID(const std::string &name, am_sourceClass_t &sourceClassID);
@@ -68,6 +68,8 @@ public:
     virtual am_Error_e enterGatewayDB(const am_Gateway_s &gatewayData, am_gatewayID_t &gatewayID) = 0;
     virtual am_Error_e enterConverterDB(const am_Converter_s &converteData, am_converterID_t &converterID) = 0;
     virtual am_Error_e enterSourceDB(const am_Source_s &sourceData, am_sourceID_t &sourceID) = 0;
+    virtual am_Error_e enterSinksDB(const std::vector<am_Sink_s> &listSinkData, std::vector<am_sinkID_t> &listSinkIDs) = 0;
+    virtual am_Error_e enterSourcesDB(const std::vector<am_Source_s> &listSourceData, std::vector<am_sourceID_t> &listSourceIDs) = 0;
     virtual am_Error_e enterConnectionDB(const am_Connection_s &connection, am_connectionID_t &connectionID, bool allowReserved) = 0;
     virtual am_Error_e enterSinkClassDB(const am_SinkClass_s &sinkClass, am_sinkClass_t &sinkClassID) = 0;
     virtual am_Error_e enterSourceClassDB(am_sourceClass_t &sourceClassID, const am_SourceClass_s &sourceClass) = 0;
@@ -100,6 +102,8 @@ public:
     virtual am_Error_e removeMainConnectionDB(const am_mainConnectionID_t mainConnectionID) = 0;
     virtual am_Error_e removeSinkDB(const am_sinkID_t sinkID) = 0;
     virtual am_Error_e removeSourceDB(const am_sourceID_t sourceID) = 0;
+    virtual am_Error_e removeSinksDB(const std::vector<am_sinkID_t> &listSinkIDs) = 0;
+    virtual am_Error_e removeSourcesDB(const std::vector<am_sourceID_t> &listSourceIDs) = 0;
     virtual am_Error_e removeGatewayDB(const am_gatewayID_t gatewayID) = 0;
     virtual am_Error_e removeConverterDB(const am_converterID_t converterID) = 0;
     virtual am_Error_e removeCrossfaderDB(const am_crossfaderID_t crossfaderID) = 0;
@@ -195,6 +199,19 @@ public:
     virtual am_Error_e enumerateGateways(std::function<void(const am_Gateway_s &element)> cb) const        = 0;
     virtual am_Error_e enumerateConverters(std::function<void(const am_Converter_s &element)> cb) const    = 0;
 
+    /**
+     * Change journal. Every change of sinks, sources, main connections and system properties
+     * increases the version of the database. The last changes are kept in a bounded ring.
+     */
+    virtual uint32_t getJournalVersion() const = 0;
+    /**
+     * Returns all changes made after the given version, oldest first.
+     * @return E_OK on success, E_NOT_POSSIBLE if the changes are not in the journal anymore.
+     *         In that case the consumer has to resync with getJournalSnapshot.
+     */
+    virtual am_Error_e getJournalChanges(const uint32_t sinceVersion, std::vector<am_JournalEntry_s> &listChanges) const = 0;
+    virtual am_Error_e getJournalSnapshot(am_JournalSnapshot_s &snapshot) const = 0;
+
     /**
      * Database observer protocol
      */
@@ -145,6 +145,21 @@ am_Error_e CAmCommandReceiver::getVolume(const am_sinkID_t sinkID, am_mainVolume
     return (mDatabaseHandler->getSinkMainVolume(sinkID, mainVolume));
 }
 
+uint32_t CAmCommandReceiver::getJournalVersion() const
+{
+    return (mDatabaseHandler->getJournalVersion());
+}
+
+am_Error_e CAmCommandReceiver::getJournalChanges(const uint32_t sinceVersion, std::vector<am_JournalEntry_s> &listChanges) const
+{
+    return (mDatabaseHandler->getJournalChanges(sinceVersion, listChanges));
+}
+
+am_Error_e CAmCommandReceiver::getJournalSnapshot(am_JournalSnapshot_s &snapshot) const
+{
+    return (mDatabaseHandler->getJournalSnapshot(snapshot));
+}
+
 am_Error_e CAmCommandReceiver::getListMainConnections(std::vector<am_MainConnectionType_s> &listConnections) const
 {
     return (mDatabaseHandler->getListVisibleMainConnections(listConnections));
@@ -25,6 +25,7 @@
 #include <cassert>
 #include <stdlib.h>
 #include <stdexcept>
+#include <algorithm>
 #include "audiomanagerconfig.h"
 #include "IAmDatabaseHandler.h"
 #include "CAmRoutingSender.h"
@@ -156,6 +157,16 @@ am_Error_e CAmControlReceiver::enterSourceDB(const am_Source_s &sourceData, am_s
     return (mDatabaseHandler->enterSourceDB(sourceData, sourceID));
 }
 
+am_Error_e CAmControlReceiver::enterSinksDB(const std::vector<am_Sink_s> &listSinkData, std::vector<am_sinkID_t> &listSinkIDs)
+{
+    return (mDatabaseHandler->enterSinksDB(listSinkData, listSinkIDs));
+}
+
+am_Error_e CAmControlReceiver::enterSourcesDB(const std::vector<am_Source_s> &listSourceData, std::vector<am_sourceID_t> &listSourceIDs)
+{
+    return (mDatabaseHandler->enterSourcesDB(listSourceData, listSourceIDs));
+}
+
 am_Error_e CAmControlReceiver::enterSinkClassDB(const am_SinkClass_s &sinkClass, am_sinkClass_t &sinkClassID)
 {
     return (mDatabaseHandler->enterSinkClassDB(sinkClass, sinkClassID));
@@ -251,6 +262,75 @@ am_Error_e CAmControlReceiver::removeSourceDB(const am_sourceID_t sourceID)
     return (mDatabaseHandler->removeSourceDB(sourceID));
 }
 
+am_Error_e CAmControlReceiver::removeSinksDB(const std::vector<am_sinkID_t> &listSinkIDs)
+{
+    return (mDatabaseHandler->removeSinksDB(listSinkIDs));
+}
+
+am_Error_e CAmControlReceiver::removeSourcesDB(const std::vector<am_sourceID_t> &listSourceIDs)
+{
+    return (mDatabaseHandler->removeSourcesDB(listSourceIDs));
+}
+
+void CAmControlReceiver::setConnectionFormatChoiceCaching(const bool enable)
+{
+    mRouter->setConnectionFormatChoiceCaching(enable);
+}
+
+void CAmControlReceiver::invalidateConnectionFormatChoices()
+{
+    mRouter->invalidateConnectionFormatChoices();
+}
+
+am_Error_e CAmControlReceiver::getRoutesToAllSinks(const bool onlyfree, const am_sourceID_t sourceID, const std::vector<am_sinkID_t> &listSinkIDs,
+    std::vector<am_Route_s> &returnList)
+{
+    CAmRoutingSinkFilter filter;
+    if (!listSinkIDs.empty())
+    {
+        filter = [&listSinkIDs](const am_Sink_s &sink){
+                return std::find(listSinkIDs.begin(), listSinkIDs.end(), sink.sinkID) != listSinkIDs.end();
+            };
+    }
+
+    return (mRouter->getRoutesToAllSinks(onlyfree, sourceID, filter, returnList));
+}
+
+am_Error_e CAmControlReceiver::getRoutesFromAllSources(const bool onlyfree, const am_sinkID_t sinkID, const std::vector<am_sourceID_t> &listSourceIDs,
+    std::vector<am_Route_s> &returnList)
+{
+    CAmRoutingSourceFilter filter;
+    if (!listSourceIDs.empty())
+    {
+        filter = [&listSourceIDs](const am_Source_s &source){
+                return std::find(listSourceIDs.begin(), listSourceIDs.end(), source.sourceID) != listSourceIDs.end();
+            };
+    }
+
+    return (mRouter->getRoutesFromAllSources(onlyfree, sinkID, filter, returnList));
+}
+
+am_Error_e CAmControlReceiver::getRoutes(const bool onlyfree, const std::vector<std::pair<am_sourceID_t, am_sinkID_t> > &listPairs,
+    std::vector<std::vector<am_Route_s> > &listRoutes)
+{
+    return (mRouter->getRoutes(onlyfree, listPairs, listRoutes));
+}
+
+uint32_t CAmControlReceiver::getJournalVersion() const
+{
+    return (mDatabaseHandler->getJournalVersion());
+}
+
+am_Error_e CAmControlReceiver::getJournalChanges(const uint32_t sinceVersion, std::vector<am_JournalEntry_s> &listChanges) const
+{
+    return (mDatabaseHandler->getJournalChanges(sinceVersion, listChanges));
+}
+
+am_Error_e CAmControlReceiver::getJournalSnapshot(am_JournalSnapshot_s &snapshot) const
+{
+    return (mDatabaseHandler->getJournalSnapshot(snapshot));
+}
+
 am_Error_e CAmControlReceiver::removeGatewayDB(const am_gatewayID_t gatewayID)
 {
     return (mDatabaseHandler->removeGatewayDB(gatewayID));
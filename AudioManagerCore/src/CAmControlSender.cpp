@@ -283,6 +283,30 @@ am_Error_e CAmControlSender::hookSystemDeregisterSource(const am_sourceID_t sour
     return (mController->hookSystemDeregisterSource(sourceID));
 }
 
+am_Error_e CAmControlSender::hookSystemRegisterSinks(const std::vector<am_Sink_s> &listSinkData, std::vector<am_sinkID_t> &listSinkIDs)
+{
+    assert(mController);
+    return (mController->hookSystemRegisterSinks(listSinkData, listSinkIDs));
+}
+
+am_Error_e CAmControlSender::hookSystemDeregisterSinks(const std::vector<am_sinkID_t> &listSinkIDs)
+{
+    assert(mController);
+    return (mController->hookSystemDeregisterSinks(listSinkIDs));
+}
+
+am_Error_e CAmControlSender::hookSystemRegisterSources(const std::vector<am_Source_s> &listSourceData, std::vector<am_sourceID_t> &listSourceIDs)
+{
+    assert(mController);
+    return (mController->hookSystemRegisterSources(listSourceData, listSourceIDs));
+}
+
+am_Error_e CAmControlSender::hookSystemDeregisterSources(const std::vector<am_sourceID_t> &listSourceIDs)
+{
+    assert(mController);
+    return (mController->hookSystemDeregisterSources(listSourceIDs));
+}
+
 am_Error_e CAmControlSender::hookSystemRegisterGateway(const am_Gateway_s &gatewayData, am_gatewayID_t &gatewayID)
 {
     assert(mController);
@@ -85,6 +85,30 @@ static std::string __am_className__("CAmDatabaseHandlerMap::");
             nextObserver->CALL(ARG1, ARG2, ARG3, ARG4);}                  \
     }
 
+/*
+ * Batch notifications fall back to the single element call for observers
+ * without a batch callback.
+ */
+#define NOTIFY_OBSERVERS_BATCH1(BATCHCALL, CALL, LIST1)                   \
+    for (AmDatabaseObserverCallbacks *nextObserver: mDatabaseObservers) { \
+        if (nextObserver->BATCHCALL) {                                    \
+            nextObserver->BATCHCALL(LIST1);}                              \
+        else if (nextObserver->CALL) {                                    \
+            for (size_t i = 0; i < LIST1.size(); i++) {                   \
+                nextObserver->CALL(LIST1[i]);}                            \
+        }                                                                 \
+    }
+
+#define NOTIFY_OBSERVERS_BATCH2(BATCHCALL, CALL, LIST1, LIST2)            \
+    for (AmDatabaseObserverCallbacks *nextObserver: mDatabaseObservers) { \
+        if (nextObserver->BATCHCALL) {                                    \
+            nextObserver->BATCHCALL(LIST1, LIST2);}                       \
+        else if (nextObserver->CALL) {                                    \
+            for (size_t i = 0; i < LIST1.size(); i++) {                   \
+                nextObserver->CALL(LIST1[i], LIST2[i]);}                  \
+        }                                                                 \
+    }
+
 namespace am
 {
 
@@ -106,10 +130,10 @@ bool isDataEqual(const L &left, const L &right)
 /*
  * Returns an object for given key
  */
-template <typename TMapKeyType, class TMapObjectType>
-TMapObjectType const *objectForKeyIfExistsInMap(const TMapKeyType &key, const std::unordered_map<TMapKeyType, TMapObjectType> &map)
+template <class TMap>
+typename TMap::mapped_type const *objectForKeyIfExistsInMap(const typename TMap::key_type &key, const TMap &map)
 {
-    typename std::unordered_map<TMapKeyType, TMapObjectType>::const_iterator iter = map.find(key);
+    typename TMap::const_iterator iter = map.find(key);
     if ( iter != map.end())
     {
         return &iter->second;
@@ -121,8 +145,8 @@ TMapObjectType const *objectForKeyIfExistsInMap(const TMapKeyType &key, const st
 /*
  * Checks whether any object with key exists in a given map
  */
-template <typename TMapKeyType, class TMapObjectType>
-bool existsObjectWithKeyInMap(const TMapKeyType &key, const std::unordered_map<TMapKeyType, TMapObjectType> &map)
+template <class TMap>
+bool existsObjectWithKeyInMap(const typename TMap::key_type &key, const TMap &map)
 {
     return objectForKeyIfExistsInMap(key, map) != NULL;
 }
@@ -136,11 +160,11 @@ bool existsObjectWithKeyInMap(const TMapKeyType &key, const std::unordered_map<T
  * @param comparator Search predicate.
  * @return NULL or pointer to the found object.
  */
-template <class TReturn, typename TIdentifier>
-const TReturn *objectMatchingPredicate(const std::unordered_map<TIdentifier, TReturn> &map,
-    std::function<bool(const TReturn &refObject)> comparator)
+template <class TMap>
+const typename TMap::mapped_type *objectMatchingPredicate(const TMap &map,
+    std::function<bool(const typename TMap::mapped_type &refObject)> comparator)
 {
-    typename std::unordered_map<TIdentifier, TReturn>::const_iterator elementIterator = map.begin();
+    typename TMap::const_iterator elementIterator = map.begin();
     for (; elementIterator != map.end(); ++elementIterator)
     {
         if ( comparator(elementIterator->second))
@@ -178,6 +202,12 @@ void CAmDatabaseHandlerMap::AmSource::getSourceType(am_SourceType_s &sourceType)
     sourceType.sourceID      = sourceID;
 }
 
+void CAmDatabaseHandlerMap::AmSource::rebuildPropertyIndex()
+{
+    indexSoundProperties.rebuild(listSoundProperties);
+    indexMainSoundProperties.rebuild(listMainSoundProperties);
+}
+
 void CAmDatabaseHandlerMap::AmSource::getDescription(std::string &outString) const
 {
     std::ostringstream fmt;
@@ -262,6 +292,12 @@ void CAmDatabaseHandlerMap::AmSink::getSinkType(am_SinkType_s &sinkType) const
     sinkType.sinkClassID  = sinkClassID;
 }
 
+void CAmDatabaseHandlerMap::AmSink::rebuildPropertyIndex()
+{
+    indexSoundProperties.rebuild(listSoundProperties);
+    indexMainSoundProperties.rebuild(listMainSoundProperties);
+}
+
 /* Connection */
 
 void CAmDatabaseHandlerMap::AmConnection::getDescription(std::string &outString) const
@@ -419,7 +455,7 @@ bool CAmDatabaseHandlerMap::AmMappedData::increaseID(int16_t &resultID, AmIdenti
 
 template <typename TMapKey, class TMapObject>
 bool CAmDatabaseHandlerMap::AmMappedData::getNextConnectionID(int16_t &resultID, AmIdentifier &connID,
-    const std::unordered_map<TMapKey, TMapObject> &map)
+    const AmDenseMap<TMapKey, TMapObject> &map)
 {
     TMapKey       nextID;
     int16_t const lastID = connID.mCurrentValue;
@@ -485,6 +521,8 @@ CAmDatabaseHandlerMap::CAmDatabaseHandlerMap()
     , mListConnectionFormat()
     , mMappedData()
     , mDatabaseObservers()
+    , mJournal(AM_JOURNAL_CAPACITY)
+    , mJournalVersion(0)
 {
     logVerbose(__METHOD_NAME__, "Init ");
 }
@@ -519,15 +557,12 @@ am_Error_e CAmDatabaseHandlerMap::enterDomainDB(const am_Domain_s &domainData, a
     }
 
     // first check for a reserved domain
-    am_Domain_s const *reservedDomain = objectMatchingPredicate<AmDomain, am_domainID_t>(mMappedData.mDomainMap, [&](const AmDomain &obj){
-                return domainData.name.compare(obj.name) == 0;
-            });
+    am_domainID_t reservedDomainID = 0;
+    int16_t       nextID           = 0;
 
-    int16_t nextID = 0;
-
-    if ( NULL != reservedDomain )
+    if (mMappedData.mDomainNames.find(domainData.name, reservedDomainID))
     {
-        nextID                                  = reservedDomain->domainID;
+        nextID                                  = reservedDomainID;
         domainID                                = nextID;
         mMappedData.mDomainMap[nextID]          = domainData;
         mMappedData.mDomainMap[nextID].domainID = nextID;
@@ -545,6 +580,7 @@ am_Error_e CAmDatabaseHandlerMap::enterDomainDB(const am_Domain_s &domainData, a
             domainID                                = nextID;
             mMappedData.mDomainMap[nextID]          = domainData;
             mMappedData.mDomainMap[nextID].domainID = nextID;
+            mMappedData.mDomainNames.set(nextID, domainData.name);
             logVerbose("DatabaseHandler::enterDomainDB entered new domain with name=", domainData.name, "busname=", domainData.busname, "nodename=", domainData.nodename, "assigned ID:", domainID);
 
             NOTIFY_OBSERVERS1(dboNewDomain, mMappedData.mDomainMap[nextID])
@@ -566,8 +602,8 @@ int16_t CAmDatabaseHandlerMap::calculateDelayForRoute(const std::vector<am_conne
     std::vector<am_connectionID_t>::const_iterator elementIterator = listConnectionID.begin();
     for (; elementIterator < listConnectionID.end(); ++elementIterator)
     {
-        am_connectionID_t                                                               key = *elementIterator;
-        std::unordered_map<am_connectionID_t, am_Connection_Database_s>::const_iterator it  = mMappedData.mConnectionMap.find(key);
+        am_connectionID_t                  key = *elementIterator;
+        AmMapConnection::const_iterator    it  = mMappedData.mConnectionMap.find(key);
         if (it != mMappedData.mConnectionMap.end())
         {
             int16_t temp_delay = it->second.delay;
@@ -651,6 +687,7 @@ am_Error_e CAmDatabaseHandlerMap::enterMainConnectionDB(const am_MainConnection_
         am_MainConnectionType_s mainConnection;
         mMappedData.mMainConnectionMap[nextID].getMainConnectionType(mainConnection);
 
+        journalChange(JE_MAIN_CONNECTION, JO_ADDED, connectionID);
         NOTIFY_OBSERVERS1(dboNewMainConnection, mainConnection)
         NOTIFY_OBSERVERS2(dboMainConnectionStateChanged, connectionID, mMappedData.mMainConnectionMap[nextID].connectionState)
     }
@@ -678,6 +715,8 @@ bool CAmDatabaseHandlerMap::insertSinkDB(const am_Sink_s &sinkData, am_sinkID_t
         sinkID                              = nextID;
         mMappedData.mSinkMap[nextID]        = sinkData;
         mMappedData.mSinkMap[nextID].sinkID = nextID;
+        mMappedData.mSinkMap[nextID].rebuildPropertyIndex();
+        mMappedData.mSinkNames.set(nextID, sinkData.name);
         filterDuplicateNotificationConfigurationTypes(mMappedData.mSinkMap[nextID].listNotificationConfigurations);
         filterDuplicateNotificationConfigurationTypes(mMappedData.mSinkMap[nextID].listMainNotificationConfigurations);
         return (true);
@@ -691,6 +730,50 @@ bool CAmDatabaseHandlerMap::insertSinkDB(const am_Sink_s &sinkData, am_sinkID_t
 }
 
 am_Error_e CAmDatabaseHandlerMap::enterSinkDB(const am_Sink_s &sinkData, am_sinkID_t &sinkID)
+{
+    am_Error_e error = enterSinkEntry(sinkData, sinkID);
+    if (E_OK == error)
+    {
+        journalChange(JE_SINK, JO_ADDED, sinkID);
+        NOTIFY_OBSERVERS1(dboNewSink, mMappedData.mSinkMap[sinkID])
+    }
+
+    return (error);
+}
+
+am_Error_e CAmDatabaseHandlerMap::enterSinksDB(const std::vector<am_Sink_s> &listSinkData, std::vector<am_sinkID_t> &listSinkIDs)
+{
+    am_Error_e             error = E_OK;
+    std::vector<am_Sink_s> listNewSinks;
+    listNewSinks.reserve(listSinkData.size());
+    listSinkIDs.assign(listSinkData.size(), 0);
+    for (size_t i = 0; i < listSinkData.size(); i++)
+    {
+        am_Error_e result = enterSinkEntry(listSinkData[i], listSinkIDs[i]);
+        if (E_OK == result)
+        {
+            listNewSinks.push_back(mMappedData.mSinkMap[listSinkIDs[i]]);
+        }
+        else if (E_OK == error)
+        {
+            error = result;
+        }
+    }
+
+    if (!listNewSinks.empty())
+    {
+        for (size_t i = 0; i < listNewSinks.size(); i++)
+        {
+            journalChange(JE_SINK, JO_ADDED, listNewSinks[i].sinkID);
+        }
+
+        NOTIFY_OBSERVERS_BATCH1(dboNewSinks, dboNewSink, listNewSinks)
+    }
+
+    return (error);
+}
+
+am_Error_e CAmDatabaseHandlerMap::enterSinkEntry(const am_Sink_s &sinkData, am_sinkID_t &sinkID)
 {
     if (sinkData.sinkID >= DYNAMIC_ID_BOUNDARY)
     {
@@ -725,14 +808,14 @@ am_Error_e CAmDatabaseHandlerMap::enterSinkDB(const am_Sink_s &sinkData, am_sink
     am_sinkID_t temp_SinkID    = 0;
     am_sinkID_t temp_SinkIndex = 0;
     // if sinkID is zero and the first Static Sink was already entered, the ID is created
-    am_Sink_s const *reservedDomain = objectMatchingPredicate<AmSink, am_sinkID_t>(mMappedData.mSinkMap, [&](const AmSink &obj){
-                return true == obj.reserved && obj.name.compare(sinkData.name) == 0;
-            });
-    if ( NULL != reservedDomain )
+    am_sinkID_t oldSinkID      = 0;
+    if (mMappedData.mSinkNames.find(sinkData.name, oldSinkID, [&](const am_sinkID_t key){
+                return true == mMappedData.mSinkMap.at(key).reserved;
+            }))
     {
-        am_sinkID_t oldSinkID = reservedDomain->sinkID;
         mMappedData.mSinkMap[oldSinkID]          = sinkData;
         mMappedData.mSinkMap[oldSinkID].reserved = 0;
+        mMappedData.mSinkMap[oldSinkID].rebuildPropertyIndex();
         temp_SinkID                              = oldSinkID;
         temp_SinkIndex                           = oldSinkID;
     }
@@ -771,8 +854,6 @@ am_Error_e CAmDatabaseHandlerMap::enterSinkDB(const am_Sink_s &sinkData, am_sink
     logVerbose("DatabaseHandler::enterSinkDB entered new sink with name", sink.name, "domainID:", sink.domainID, "classID:", sink.sinkClassID, "volume:", sink.volume, "assigned ID:", sink.sinkID);
 
     sink.sinkID = sinkID;
-    NOTIFY_OBSERVERS1(dboNewSink, sink)
-
     return (E_OK);
 }
 
@@ -1069,6 +1150,8 @@ bool CAmDatabaseHandlerMap::insertSourceDB(const am_Source_s &sourceData, am_sou
         sourceID                                = nextID;
         mMappedData.mSourceMap[nextID]          = sourceData;
         mMappedData.mSourceMap[nextID].sourceID = nextID;
+        mMappedData.mSourceMap[nextID].rebuildPropertyIndex();
+        mMappedData.mSourceNames.set(nextID, sourceData.name);
         filterDuplicateNotificationConfigurationTypes(mMappedData.mSourceMap[nextID].listNotificationConfigurations);
         filterDuplicateNotificationConfigurationTypes(mMappedData.mSourceMap[nextID].listMainNotificationConfigurations);
         return (true);
@@ -1082,6 +1165,50 @@ bool CAmDatabaseHandlerMap::insertSourceDB(const am_Source_s &sourceData, am_sou
 }
 
 am_Error_e CAmDatabaseHandlerMap::enterSourceDB(const am_Source_s &sourceData, am_sourceID_t &sourceID)
+{
+    am_Error_e error = enterSourceEntry(sourceData, sourceID);
+    if (E_OK == error)
+    {
+        journalChange(JE_SOURCE, JO_ADDED, sourceID);
+        NOTIFY_OBSERVERS1(dboNewSource, mMappedData.mSourceMap[sourceID])
+    }
+
+    return (error);
+}
+
+am_Error_e CAmDatabaseHandlerMap::enterSourcesDB(const std::vector<am_Source_s> &listSourceData, std::vector<am_sourceID_t> &listSourceIDs)
+{
+    am_Error_e               error = E_OK;
+    std::vector<am_Source_s> listNewSources;
+    listNewSources.reserve(listSourceData.size());
+    listSourceIDs.assign(listSourceData.size(), 0);
+    for (size_t i = 0; i < listSourceData.size(); i++)
+    {
+        am_Error_e result = enterSourceEntry(listSourceData[i], listSourceIDs[i]);
+        if (E_OK == result)
+        {
+            listNewSources.push_back(mMappedData.mSourceMap[listSourceIDs[i]]);
+        }
+        else if (E_OK == error)
+        {
+            error = result;
+        }
+    }
+
+    if (!listNewSources.empty())
+    {
+        for (size_t i = 0; i < listNewSources.size(); i++)
+        {
+            journalChange(JE_SOURCE, JO_ADDED, listNewSources[i].sourceID);
+        }
+
+        NOTIFY_OBSERVERS_BATCH1(dboNewSources, dboNewSource, listNewSources)
+    }
+
+    return (error);
+}
+
+am_Error_e CAmDatabaseHandlerMap::enterSourceEntry(const am_Source_s &sourceData, am_sourceID_t &sourceID)
 {
     if (sourceData.sourceID >= DYNAMIC_ID_BOUNDARY)
     {
@@ -1116,14 +1243,14 @@ am_Error_e CAmDatabaseHandlerMap::enterSourceDB(const am_Source_s &sourceData, a
     bool            isFirstStatic = sourceData.sourceID == 0 && mFirstStaticSource;
     am_sourceID_t   temp_SourceID = 0;
     am_sourceID_t   temp_SourceIndex = 0;
-    AmSource const *reservedSource = objectMatchingPredicate<AmSource, am_sourceID_t>(mMappedData.mSourceMap, [&](const AmSource &obj){
-                return true == obj.reserved && obj.name.compare(sourceData.name) == 0;
-            });
-    if ( NULL != reservedSource )
+    am_sourceID_t   oldSourceID      = 0;
+    if (mMappedData.mSourceNames.find(sourceData.name, oldSourceID, [&](const am_sourceID_t key){
+                return true == mMappedData.mSourceMap.at(key).reserved;
+            }))
     {
-        am_sourceID_t oldSourceID = reservedSource->sourceID;
         mMappedData.mSourceMap[oldSourceID]          = sourceData;
         mMappedData.mSourceMap[oldSourceID].reserved = 0;
+        mMappedData.mSourceMap[oldSourceID].rebuildPropertyIndex();
         temp_SourceID                                = oldSourceID;
         temp_SourceIndex                             = oldSourceID;
     }
@@ -1160,8 +1287,6 @@ am_Error_e CAmDatabaseHandlerMap::enterSourceDB(const am_Source_s &sourceData, a
 
     logVerbose("DatabaseHandler::enterSourceDB entered new source with name", sourceData.name, "domainID:", sourceData.domainID, "classID:", sourceData.sourceClassID, "visible:", sourceData.visible, "assigned ID:", sourceID);
 
-    NOTIFY_OBSERVERS1(dboNewSource, mMappedData.mSourceMap[temp_SourceIndex])
-
     return (E_OK);
 }
 
@@ -1229,6 +1354,7 @@ bool CAmDatabaseHandlerMap::insertSinkClassDB(const am_SinkClass_s &sinkClass, a
         sinkClassID                                     = nextID;
         mMappedData.mSinkClassesMap[nextID]             = sinkClass;
         mMappedData.mSinkClassesMap[nextID].sinkClassID = nextID;
+        mMappedData.mSinkClassNames.set(nextID, sinkClass.name);
         return (true);
     }
     else
@@ -1297,6 +1423,7 @@ bool CAmDatabaseHandlerMap::insertSourceClassDB(am_sourceClass_t &sourceClassID,
         sourceClassID                                       = nextID;
         mMappedData.mSourceClassesMap[nextID]               = sourceClass;
         mMappedData.mSourceClassesMap[nextID].sourceClassID = nextID;
+        mMappedData.mSourceClassNames.set(nextID, sourceClass.name);
         return (true);
     }
     else
@@ -1425,6 +1552,7 @@ am_Error_e CAmDatabaseHandlerMap::changeMainConnectionStateDB(const am_mainConne
     DB_COND_UPDATE_RIE(mMappedData.mMainConnectionMap[mainconnectionID].connectionState, connectionState);
 
     logVerbose("DatabaseHandler::changeMainConnectionStateDB changed mainConnectionState of MainConnection:", mainconnectionID, "to:", connectionState);
+    journalChange(JE_MAIN_CONNECTION, JO_CHANGED, mainconnectionID);
     NOTIFY_OBSERVERS2(dboMainConnectionStateChanged, mainconnectionID, connectionState)
     return (E_OK);
 }
@@ -1441,6 +1569,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSinkMainVolumeDB(const am_mainVolume_t m
 
     logVerbose("DatabaseHandler::changeSinkMainVolumeDB changed mainVolume of sink:", sinkID, "to:", mainVolume);
 
+    journalChange(JE_SINK, JO_CHANGED, sinkID);
     NOTIFY_OBSERVERS2(dboVolumeChanged, sinkID, mainVolume)
 
     return (E_OK);
@@ -1466,6 +1595,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSinkAvailabilityDB(const am_Availability
 
     if (sinkVisible(sinkID))
     {
+        journalChange(JE_SINK, JO_CHANGED, sinkID);
         NOTIFY_OBSERVERS2(dboSinkAvailabilityChanged, sinkID, availability)
     }
 
@@ -1512,6 +1642,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSinkMuteStateDB(const am_MuteState_e mut
 
     logVerbose("DatabaseHandler::changeSinkMuteStateDB changed sinkMuteState of sink:", sinkID, "to:", muteState);
 
+    journalChange(JE_SINK, JO_CHANGED, sinkID);
     NOTIFY_OBSERVERS2(dboSinkMuteStateChanged, sinkID, muteState)
 
     return (E_OK);
@@ -1526,28 +1657,17 @@ am_Error_e CAmDatabaseHandlerMap::changeMainSinkSoundPropertyDB(const am_MainSou
         return (E_NON_EXISTENT);
     }
     DB_COND_UPDATE_INIT;
-    am_Sink_Database_s                           &sink            = mMappedData.mSinkMap[sinkID];
-    std::vector<am_MainSoundProperty_s>::iterator elementIterator = sink.listMainSoundProperties.begin();
-    for (; elementIterator != sink.listMainSoundProperties.end(); ++elementIterator)
+    am_Sink_Database_s     &sink     = mMappedData.mSinkMap[sinkID];
+    am_MainSoundProperty_s *property = sink.indexMainSoundProperties.find(sink.listMainSoundProperties, soundProperty.type);
+    if (NULL != property)
     {
-        if (elementIterator->type == soundProperty.type)
-        {
-            DB_COND_UPDATE(elementIterator->value, soundProperty.value);
-            if (DB_COND_ISMODIFIED)
-            {
-                if (sink.cacheMainSoundProperties.size())
-                {
-                    sink.cacheMainSoundProperties[soundProperty.type] = soundProperty.value;
-                }
-            }
-
-            break;
-        }
+        DB_COND_UPDATE(property->value, soundProperty.value);
     }
 
     if (DB_COND_ISMODIFIED)
     {
         logVerbose("DatabaseHandler::changeMainSinkSoundPropertyDB changed MainSinkSoundProperty of sink:", sinkID, "type:", soundProperty.type, "to:", soundProperty.value);
+        journalChange(JE_SINK, JO_CHANGED, sinkID);
         NOTIFY_OBSERVERS2(dboMainSinkSoundPropertyChanged, sinkID, soundProperty)
         return (E_OK);
     }
@@ -1567,29 +1687,20 @@ am_Error_e CAmDatabaseHandlerMap::changeMainSinkSoundPropertiesDB(const std::vec
         return (E_NON_EXISTENT);
     }
 
-    am_Sink_Database_s                           &sink = mMappedData.mSinkMap[sinkID];
-    std::vector<am_MainSoundProperty_s>::iterator elementIterator;
+    am_Sink_Database_s &sink = mMappedData.mSinkMap[sinkID];
 
     for (auto &itlistSoundProperties : listSoundProperties )
     {
-        for (elementIterator = sink.listMainSoundProperties.begin(); elementIterator != sink.listMainSoundProperties.end();
-             ++elementIterator )
+        am_MainSoundProperty_s *property = sink.indexMainSoundProperties.find(sink.listMainSoundProperties, itlistSoundProperties.type);
+        if (NULL != property)
         {
-            if (elementIterator->type == itlistSoundProperties.type)
-            {
-                DB_COND_UPDATE_RIE(elementIterator->value, itlistSoundProperties.value);
-                if (sink.cacheMainSoundProperties.size())
-                {
-                    sink.cacheMainSoundProperties[itlistSoundProperties.type] = itlistSoundProperties.value;
-                }
-
-                break;
-            }
+            DB_COND_UPDATE_RIE(property->value, itlistSoundProperties.value);
         }
     }
 
     logVerbose("DatabaseHandler::changeMainSinkSoundPropertiesDB changed MainSinkSoundProperties of sink:", sinkID);
 
+    journalChange(JE_SINK, JO_CHANGED, sinkID);
     NOTIFY_OBSERVERS2(dboMainSinkSoundPropertiesChanged, sinkID, listSoundProperties)
     return (E_OK);
 }
@@ -1604,27 +1715,17 @@ am_Error_e CAmDatabaseHandlerMap::changeMainSourceSoundPropertyDB(const am_MainS
     }
 
     DB_COND_UPDATE_INIT;
-    am_Source_Database_s                         &source          = mMappedData.mSourceMap.at(sourceID);
-    std::vector<am_MainSoundProperty_s>::iterator elementIterator = source.listMainSoundProperties.begin();
-    for (; elementIterator != source.listMainSoundProperties.end(); ++elementIterator)
+    am_Source_Database_s   &source   = mMappedData.mSourceMap.at(sourceID);
+    am_MainSoundProperty_s *property = source.indexMainSoundProperties.find(source.listMainSoundProperties, soundProperty.type);
+    if (NULL != property)
     {
-        if (elementIterator->type == soundProperty.type)
-        {
-            DB_COND_UPDATE(elementIterator->value, soundProperty.value);
-            if (DB_COND_ISMODIFIED)
-            {
-                if (source.cacheMainSoundProperties.size())
-                {
-                    source.cacheMainSoundProperties[soundProperty.type] = soundProperty.value;
-                }
-            }
-            break;
-        }
+        DB_COND_UPDATE(property->value, soundProperty.value);
     }
 
     if (DB_COND_ISMODIFIED)
     {
         logVerbose("DatabaseHandler::changeMainSourceSoundPropertyDB changed MainSinkSoundProperty of source:", sourceID, "type:", soundProperty.type, "to:", soundProperty.value);
+        journalChange(JE_SOURCE, JO_CHANGED, sourceID);
         NOTIFY_OBSERVERS2(dboMainSourceSoundPropertyChanged, sourceID, soundProperty)
         return (E_OK);
     }
@@ -1643,29 +1744,20 @@ am_Error_e CAmDatabaseHandlerMap::changeMainSourceSoundPropertiesDB(const std::v
         return (E_NON_EXISTENT);
     }
 
-    am_Source_Database_s                         &source = mMappedData.mSourceMap.at(sourceID);
-    std::vector<am_MainSoundProperty_s>::iterator elementIterator;
+    am_Source_Database_s &source = mMappedData.mSourceMap.at(sourceID);
 
     for (auto &itlistSoundProperties : listSoundProperties )
     {
-        for (elementIterator = source.listMainSoundProperties.begin(); elementIterator != source.listMainSoundProperties.end();
-             ++elementIterator )
+        am_MainSoundProperty_s *property = source.indexMainSoundProperties.find(source.listMainSoundProperties, itlistSoundProperties.type);
+        if (NULL != property)
         {
-            if (elementIterator->type == itlistSoundProperties.type)
-            {
-                DB_COND_UPDATE_RIE(elementIterator->value, itlistSoundProperties.value);
-                if (source.cacheMainSoundProperties.size())
-                {
-                    source.cacheMainSoundProperties[itlistSoundProperties.type] = itlistSoundProperties.value;
-                }
-
-                break;
-            }
+            DB_COND_UPDATE_RIE(property->value, itlistSoundProperties.value);
         }
     }
 
     logVerbose("DatabaseHandler::changeMainSourceSoundPropertiesDB changed MainSinkSoundProperties of source:", sourceID);
 
+    journalChange(JE_SOURCE, JO_CHANGED, sourceID);
     NOTIFY_OBSERVERS2(dboMainSourceSoundPropertiesChanged, sourceID, listSoundProperties)
     return (E_OK);
 }
@@ -1690,6 +1782,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSourceAvailabilityDB(const am_Availabili
 
     if (sourceVisible(sourceID))
     {
+        journalChange(JE_SOURCE, JO_CHANGED, sourceID);
         NOTIFY_OBSERVERS2(dboSourceAvailabilityChanged, sourceID, availability)
     }
 
@@ -1711,6 +1804,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSystemPropertyDB(const am_SystemProperty
     if (DB_COND_ISMODIFIED)
     {
         logVerbose("DatabaseHandler::changeSystemPropertyDB changed system property ", property.type, " to ", property.value);
+        journalChange(JE_SYSTEM_PROPERTY, JO_CHANGED, property.type);
         NOTIFY_OBSERVERS1(dboSystemPropertyChanged, property)
         return (E_OK);
     }
@@ -1742,6 +1836,11 @@ am_Error_e CAmDatabaseHandlerMap::changeSystemPropertiesDB(const std::vector<am_
 
     logVerbose("DatabaseHandler::changeSystemPropertiesDB changed system property");
 
+    for (size_t i = 0; i < listSystemProperties.size(); i++)
+    {
+        journalChange(JE_SYSTEM_PROPERTY, JO_CHANGED, listSystemProperties[i].type);
+    }
+
     NOTIFY_OBSERVERS1(dboSystemPropertiesChanged, listSystemProperties)
 
     return (E_OK);
@@ -1766,12 +1865,61 @@ am_Error_e CAmDatabaseHandlerMap::removeMainConnectionDB(const am_mainConnection
     mMappedData.mMainConnectionMap.erase(mainConnectionID);
 
     logVerbose("DatabaseHandler::removeMainConnectionDB removed:", mainConnectionID);
+    journalChange(JE_MAIN_CONNECTION, JO_REMOVED, mainConnectionID);
     NOTIFY_OBSERVERS1(dboRemovedMainConnection, mainConnectionID)
 
     return (E_OK);
 }
 
 am_Error_e CAmDatabaseHandlerMap::removeSinkDB(const am_sinkID_t sinkID)
+{
+    bool       visible = false;
+    am_Error_e error   = removeSinkEntry(sinkID, visible);
+    if (E_OK == error)
+    {
+        journalChange(JE_SINK, JO_REMOVED, sinkID);
+        NOTIFY_OBSERVERS2(dboRemovedSink, sinkID, visible)
+    }
+
+    return (error);
+}
+
+am_Error_e CAmDatabaseHandlerMap::removeSinksDB(const std::vector<am_sinkID_t> &listSinkIDs)
+{
+    am_Error_e               error = E_OK;
+    std::vector<am_sinkID_t> listRemovedSinks;
+    std::vector<bool>        listVisible;
+    listRemovedSinks.reserve(listSinkIDs.size());
+    listVisible.reserve(listSinkIDs.size());
+    for (am_sinkID_t sinkID : listSinkIDs)
+    {
+        bool       visible = false;
+        am_Error_e result  = removeSinkEntry(sinkID, visible);
+        if (E_OK == result)
+        {
+            listRemovedSinks.push_back(sinkID);
+            listVisible.push_back(visible);
+        }
+        else if (E_OK == error)
+        {
+            error = result;
+        }
+    }
+
+    if (!listRemovedSinks.empty())
+    {
+        for (size_t i = 0; i < listRemovedSinks.size(); i++)
+        {
+            journalChange(JE_SINK, JO_REMOVED, listRemovedSinks[i]);
+        }
+
+        NOTIFY_OBSERVERS_BATCH2(dboRemovedSinks, dboRemovedSink, listRemovedSinks, listVisible)
+    }
+
+    return (error);
+}
+
+am_Error_e CAmDatabaseHandlerMap::removeSinkEntry(const am_sinkID_t sinkID, bool &visible)
 {
 
     if (!existSink(sinkID))
@@ -1780,19 +1928,65 @@ am_Error_e CAmDatabaseHandlerMap::removeSinkDB(const am_sinkID_t sinkID)
         return (E_NON_EXISTENT);
     }
 
-    bool visible = sinkVisible(sinkID);
+    visible = sinkVisible(sinkID);
 
     mMappedData.mSinkMap.erase(sinkID);
+    mMappedData.mSinkNames.remove(sinkID);
     // todo: Check the tables SinkMainSoundProperty and SinkMainNotificationConfiguration with 'visible' set to true
     // if visible is true then delete SinkMainSoundProperty and SinkMainNotificationConfiguration ????
     logVerbose("DatabaseHandler::removeSinkDB removed:", sinkID);
-
-    NOTIFY_OBSERVERS2(dboRemovedSink, sinkID, visible)
-
     return (E_OK);
 }
 
 am_Error_e CAmDatabaseHandlerMap::removeSourceDB(const am_sourceID_t sourceID)
+{
+    bool       visible = false;
+    am_Error_e error   = removeSourceEntry(sourceID, visible);
+    if (E_OK == error)
+    {
+        journalChange(JE_SOURCE, JO_REMOVED, sourceID);
+        NOTIFY_OBSERVERS2(dboRemovedSource, sourceID, visible)
+    }
+
+    return (error);
+}
+
+am_Error_e CAmDatabaseHandlerMap::removeSourcesDB(const std::vector<am_sourceID_t> &listSourceIDs)
+{
+    am_Error_e                 error = E_OK;
+    std::vector<am_sourceID_t> listRemovedSources;
+    std::vector<bool>          listVisible;
+    listRemovedSources.reserve(listSourceIDs.size());
+    listVisible.reserve(listSourceIDs.size());
+    for (am_sourceID_t sourceID : listSourceIDs)
+    {
+        bool       visible = false;
+        am_Error_e result  = removeSourceEntry(sourceID, visible);
+        if (E_OK == result)
+        {
+            listRemovedSources.push_back(sourceID);
+            listVisible.push_back(visible);
+        }
+        else if (E_OK == error)
+        {
+            error = result;
+        }
+    }
+
+    if (!listRemovedSources.empty())
+    {
+        for (size_t i = 0; i < listRemovedSources.size(); i++)
+        {
+            journalChange(JE_SOURCE, JO_REMOVED, listRemovedSources[i]);
+        }
+
+        NOTIFY_OBSERVERS_BATCH2(dboRemovedSources, dboRemovedSource, listRemovedSources, listVisible)
+    }
+
+    return (error);
+}
+
+am_Error_e CAmDatabaseHandlerMap::removeSourceEntry(const am_sourceID_t sourceID, bool &visible)
 {
 
     if (!existSource(sourceID))
@@ -1801,15 +1995,15 @@ am_Error_e CAmDatabaseHandlerMap::removeSourceDB(const am_sourceID_t sourceID)
         return (E_NON_EXISTENT);
     }
 
-    bool visible = sourceVisible(sourceID);
+    visible = sourceVisible(sourceID);
 
     mMappedData.mSourceMap.erase(sourceID);
+    mMappedData.mSourceNames.remove(sourceID);
 
     // todo: Check the tables SourceMainSoundProperty and SourceMainNotificationConfiguration with 'visible' set to true
     // if visible is true then delete SourceMainSoundProperty and SourceMainNotificationConfiguration ????
 
     logVerbose("DatabaseHandler::removeSourceDB removed:", sourceID);
-    NOTIFY_OBSERVERS2(dboRemovedSource, sourceID, visible)
     return (E_OK);
 }
 
@@ -1872,6 +2066,7 @@ am_Error_e CAmDatabaseHandlerMap::removeDomainDB(const am_domainID_t domainID)
     }
 
     mMappedData.mDomainMap.erase(domainID);
+    mMappedData.mDomainNames.remove(domainID);
 
     logVerbose("DatabaseHandler::removeDomainDB removed:", domainID);
     NOTIFY_OBSERVERS1(dboRemoveDomain, domainID)
@@ -1889,6 +2084,7 @@ am_Error_e CAmDatabaseHandlerMap::removeSinkClassDB(const am_sinkClass_t sinkCla
     }
 
     mMappedData.mSinkClassesMap.erase(sinkClassID);
+    mMappedData.mSinkClassNames.remove(sinkClassID);
 
     logVerbose("DatabaseHandler::removeSinkClassDB removed:", sinkClassID);
     NOTIFY_OBSERVERS(dboNumberOfSinkClassesChanged)
@@ -1905,6 +2101,7 @@ am_Error_e CAmDatabaseHandlerMap::removeSourceClassDB(const am_sourceClass_t sou
     }
 
     mMappedData.mSourceClassesMap.erase(sourceClassID);
+    mMappedData.mSourceClassNames.remove(sourceClassID);
     logVerbose("DatabaseHandler::removeSourceClassDB removed:", sourceClassID);
     NOTIFY_OBSERVERS(dboNumberOfSourceClassesChanged)
     return (E_OK);
@@ -2129,7 +2326,7 @@ am_Error_e CAmDatabaseHandlerMap::getListSinksOfDomain(const am_domainID_t domai
         return (E_NON_EXISTENT);
     }
 
-    std::unordered_map<am_sinkID_t, am_Sink_Database_s>::const_iterator elementIterator = mMappedData.mSinkMap.begin();
+    AmMapSink::const_iterator elementIterator = mMappedData.mSinkMap.begin();
     for (; elementIterator != mMappedData.mSinkMap.end(); ++elementIterator)
     {
         if (0 == elementIterator->second.reserved && domainID == elementIterator->second.domainID)
@@ -2298,7 +2495,7 @@ am_Error_e CAmDatabaseHandlerMap::getListSinks(std::vector<am_Sink_s> &listSinks
 {
     listSinks.clear();
 
-    std::for_each(mMappedData.mSinkMap.begin(), mMappedData.mSinkMap.end(), [&](const std::pair<am_sinkID_t, am_Sink_Database_s> &ref) {
+    std::for_each(mMappedData.mSinkMap.begin(), mMappedData.mSinkMap.end(), [&](const AmMapSink::value_type &ref) {
             if ( 0 == ref.second.reserved )
             {
                 listSinks.push_back(ref.second);
@@ -2312,7 +2509,7 @@ am_Error_e CAmDatabaseHandlerMap::getListSources(std::vector<am_Source_s> &listS
 {
     listSources.clear();
 
-    std::for_each(mMappedData.mSourceMap.begin(), mMappedData.mSourceMap.end(), [&](const std::pair<am_sourceID_t, am_Source_Database_s> &ref) {
+    std::for_each(mMappedData.mSourceMap.begin(), mMappedData.mSourceMap.end(), [&](const AmMapSource::value_type &ref) {
             if ( 0 == ref.second.reserved )
             {
                 listSources.push_back(ref.second);
@@ -2325,7 +2522,7 @@ am_Error_e CAmDatabaseHandlerMap::getListSourceClasses(std::vector<am_SourceClas
 {
     listSourceClasses.clear();
 
-    std::for_each(mMappedData.mSourceClassesMap.begin(), mMappedData.mSourceClassesMap.end(), [&](const std::pair<am_sourceClass_t, am_SourceClass_s> &ref) {
+    std::for_each(mMappedData.mSourceClassesMap.begin(), mMappedData.mSourceClassesMap.end(), [&](const AmMapSourceClass::value_type &ref) {
             listSourceClasses.push_back(ref.second);
         });
 
@@ -2336,7 +2533,7 @@ am_Error_e CAmDatabaseHandlerMap::getListCrossfaders(std::vector<am_Crossfader_s
 {
     listCrossfaders.clear();
 
-    std::for_each(mMappedData.mCrossfaderMap.begin(), mMappedData.mCrossfaderMap.end(), [&](const std::pair<am_crossfaderID_t, am_Crossfader_s> &ref) {
+    std::for_each(mMappedData.mCrossfaderMap.begin(), mMappedData.mCrossfaderMap.end(), [&](const AmMapCrossfader::value_type &ref) {
             listCrossfaders.push_back(ref.second);
         });
 
@@ -2347,7 +2544,7 @@ am_Error_e CAmDatabaseHandlerMap::getListGateways(std::vector<am_Gateway_s> &lis
 {
     listGateways.clear();
 
-    std::for_each(mMappedData.mGatewayMap.begin(), mMappedData.mGatewayMap.end(), [&](const std::pair<am_gatewayID_t, am_Gateway_s> &ref) {
+    std::for_each(mMappedData.mGatewayMap.begin(), mMappedData.mGatewayMap.end(), [&](const AmMapGateway::value_type &ref) {
             listGateways.push_back(ref.second);
         });
 
@@ -2358,7 +2555,7 @@ am_Error_e CAmDatabaseHandlerMap::getListConverters(std::vector<am_Converter_s>
 {
     listConverters.clear();
 
-    std::for_each(mMappedData.mConverterMap.begin(), mMappedData.mConverterMap.end(), [&](const std::pair<am_converterID_t, am_Converter_s> &ref) {
+    std::for_each(mMappedData.mConverterMap.begin(), mMappedData.mConverterMap.end(), [&](const AmMapConverter::value_type &ref) {
             listConverters.push_back(ref.second);
         });
 
@@ -2369,7 +2566,7 @@ am_Error_e CAmDatabaseHandlerMap::getListSinkClasses(std::vector<am_SinkClass_s>
 {
     listSinkClasses.clear();
 
-    std::for_each(mMappedData.mSinkClassesMap.begin(), mMappedData.mSinkClassesMap.end(), [&](const std::pair<am_gatewayID_t, am_SinkClass_s> &ref) {
+    std::for_each(mMappedData.mSinkClassesMap.begin(), mMappedData.mSinkClassesMap.end(), [&](const AmMapSinkClass::value_type &ref) {
             listSinkClasses.push_back(ref.second);
         });
 
@@ -2379,7 +2576,7 @@ am_Error_e CAmDatabaseHandlerMap::getListSinkClasses(std::vector<am_SinkClass_s>
 am_Error_e CAmDatabaseHandlerMap::getListVisibleMainConnections(std::vector<am_MainConnectionType_s> &listConnections) const
 {
     listConnections.clear();
-    std::for_each(mMappedData.mMainConnectionMap.begin(), mMappedData.mMainConnectionMap.end(), [&](const std::pair<am_mainConnectionID_t, am_MainConnection_Database_s> &ref) {
+    std::for_each(mMappedData.mMainConnectionMap.begin(), mMappedData.mMainConnectionMap.end(), [&](const AmMapMainConnection::value_type &ref) {
             listConnections.emplace_back();
             ref.second.getMainConnectionType(listConnections.back());
         });
@@ -2390,7 +2587,7 @@ am_Error_e CAmDatabaseHandlerMap::getListVisibleMainConnections(std::vector<am_M
 am_Error_e CAmDatabaseHandlerMap::getListMainSinks(std::vector<am_SinkType_s> &listMainSinks) const
 {
     listMainSinks.clear();
-    std::for_each(mMappedData.mSinkMap.begin(), mMappedData.mSinkMap.end(), [&](const std::pair<am_sinkID_t, am_Sink_Database_s> &ref) {
+    std::for_each(mMappedData.mSinkMap.begin(), mMappedData.mSinkMap.end(), [&](const AmMapSink::value_type &ref) {
             if ( 0 == ref.second.reserved && 1 == ref.second.visible )
             {
                 listMainSinks.emplace_back();
@@ -2404,7 +2601,7 @@ am_Error_e CAmDatabaseHandlerMap::getListMainSinks(std::vector<am_SinkType_s> &l
 am_Error_e CAmDatabaseHandlerMap::getListMainSources(std::vector<am_SourceType_s> &listMainSources) const
 {
     listMainSources.clear();
-    std::for_each(mMappedData.mSourceMap.begin(), mMappedData.mSourceMap.end(), [&](const std::pair<am_sourceID_t, am_Source_Database_s> &ref) {
+    std::for_each(mMappedData.mSourceMap.begin(), mMappedData.mSourceMap.end(), [&](const AmMapSource::value_type &ref) {
             if ( 0 == ref.second.reserved && 1 == ref.second.visible )
             {
                 listMainSources.emplace_back();
@@ -2557,6 +2754,7 @@ am_Error_e CAmDatabaseHandlerMap::changeDelayMainConnection(const am_timeSync_t
     }
 
     DB_COND_UPDATE_RIE(mMappedData.mMainConnectionMap[connectionID].delay, delay);
+    journalChange(JE_MAIN_CONNECTION, JO_CHANGED, connectionID);
     NOTIFY_OBSERVERS2(dboTimingInformationChanged, connectionID, delay)
     return (E_OK);
 }
@@ -2615,19 +2813,13 @@ bool CAmDatabaseHandlerMap::existSourceName(const std::string &name) const
  */
 bool CAmDatabaseHandlerMap::existSink(const am_sinkID_t sinkID) const
 {
-    bool                      returnVal       = false;
-    AmMapSink::const_iterator elementIterator = mMappedData.mSinkMap.begin();
-    for (; elementIterator != mMappedData.mSinkMap.end(); ++elementIterator)
+    am_Sink_Database_s const *sink = objectForKeyIfExistsInMap(sinkID, mMappedData.mSinkMap);
+    if ( NULL != sink )
     {
-        if ( 0 == elementIterator->second.reserved &&
-             sinkID == elementIterator->second.sinkID)
-        {
-            returnVal = true;
-            break;
-        }
+        return (0 == sink->reserved);
     }
 
-    return (returnVal);
+    return false;
 }
 
 /**
@@ -2638,11 +2830,21 @@ bool CAmDatabaseHandlerMap::existSink(const am_sinkID_t sinkID) const
  */
 const CAmDatabaseHandlerMap::am_Source_Database_s *CAmDatabaseHandlerMap::sourceWithNameOrID(const am_sourceID_t sourceID, const std::string &name) const
 {
-    std::function<bool(const CAmDatabaseHandlerMap::am_Source_Database_s &refObject)> comparator = [&](const CAmDatabaseHandlerMap::am_Source_Database_s &source) -> bool {
-            return (0 == source.reserved &&
-                    (sourceID == source.sourceID || name.compare(source.name) == 0));
-        };
-    return objectMatchingPredicate(mMappedData.mSourceMap, comparator);
+    am_Source_Database_s const *source = objectForKeyIfExistsInMap(sourceID, mMappedData.mSourceMap);
+    if ( NULL != source && 0 == source->reserved )
+    {
+        return source;
+    }
+
+    am_sourceID_t namedSourceID = 0;
+    if (mMappedData.mSourceNames.find(name, namedSourceID, [&](const am_sourceID_t key){
+                return 0 == mMappedData.mSourceMap.at(key).reserved;
+            }))
+    {
+        return &mMappedData.mSourceMap.at(namedSourceID);
+    }
+
+    return NULL;
 }
 
 /**
@@ -2653,11 +2855,21 @@ const CAmDatabaseHandlerMap::am_Source_Database_s *CAmDatabaseHandlerMap::source
  */
 const CAmDatabaseHandlerMap::am_Sink_Database_s *CAmDatabaseHandlerMap::sinkWithNameOrID(const am_sinkID_t sinkID, const std::string &name) const
 {
-    std::function<bool(const CAmDatabaseHandlerMap::am_Sink_Database_s &refObject)> comparator = [&](const CAmDatabaseHandlerMap::am_Sink_Database_s &sink) -> bool {
-            return (0 == sink.reserved &&
-                    (sinkID == sink.sinkID || name.compare(sink.name) == 0));
-        };
-    return objectMatchingPredicate(mMappedData.mSinkMap, comparator);
+    am_Sink_Database_s const *sink = objectForKeyIfExistsInMap(sinkID, mMappedData.mSinkMap);
+    if ( NULL != sink && 0 == sink->reserved )
+    {
+        return sink;
+    }
+
+    am_sinkID_t namedSinkID = 0;
+    if (mMappedData.mSinkNames.find(name, namedSinkID, [&](const am_sinkID_t key){
+                return 0 == mMappedData.mSinkMap.at(key).reserved;
+            }))
+    {
+        return &mMappedData.mSinkMap.at(namedSinkID);
+    }
+
+    return NULL;
 }
 
 /**
@@ -2886,7 +3098,7 @@ bool CAmDatabaseHandlerMap::sinkVisible(const am_sinkID_t sinkID) const
  */
 bool CAmDatabaseHandlerMap::existConnection(const am_Connection_s &connection) const
 {
-    am_Connection_Database_s const *connectionObject = objectMatchingPredicate<am_Connection_Database_s, am_connectionID_t>(mMappedData.mConnectionMap, [&](const am_Connection_Database_s &obj){
+    am_Connection_Database_s const *connectionObject = objectMatchingPredicate(mMappedData.mConnectionMap, [&](const am_Connection_Database_s &obj){
                 return false == obj.reserved &&
                 connection.sinkID == obj.sinkID &&
                 connection.sourceID == obj.sourceID &&
@@ -3014,22 +3226,13 @@ am_Error_e CAmDatabaseHandlerMap::getSourceVolume(const am_sourceID_t sourceID,
 am_Error_e CAmDatabaseHandlerMap::getSinkSoundPropertyValue(const am_sinkID_t sinkID, const am_CustomSoundPropertyType_t propertyType, int16_t &value) const
 {
 
-    am_Sink_Database_s *pObject = (am_Sink_Database_s *)objectForKeyIfExistsInMap(sinkID, mMappedData.mSinkMap);
+    am_Sink_Database_s const *pObject = objectForKeyIfExistsInMap(sinkID, mMappedData.mSinkMap);
     if ( NULL != pObject )
     {
-        if (pObject->listSoundProperties.size() > 0 && 0 == pObject->cacheSoundProperties.size())
-        {
-            std::vector<am_SoundProperty_s>::const_iterator iter = pObject->listSoundProperties.begin();
-            for (; iter < pObject->listSoundProperties.end(); ++iter)
-            {
-                pObject->cacheSoundProperties[iter->type] = iter->value;
-            }
-        }
-
-        auto it = pObject->cacheSoundProperties.find(propertyType);
-        if (it != pObject->cacheSoundProperties.end())
+        am_SoundProperty_s const *property = pObject->indexSoundProperties.find(pObject->listSoundProperties, propertyType);
+        if (NULL != property)
         {
-            value = it->second;
+            value = property->value;
             return (E_OK);
         }
     }
@@ -3041,22 +3244,13 @@ am_Error_e CAmDatabaseHandlerMap::getSinkSoundPropertyValue(const am_sinkID_t si
 
 am_Error_e CAmDatabaseHandlerMap::getSourceSoundPropertyValue(const am_sourceID_t sourceID, const am_CustomSoundPropertyType_t propertyType, int16_t &value) const
 {
-    am_Source_Database_s *pObject = (am_Source_Database_s *)objectForKeyIfExistsInMap(sourceID, mMappedData.mSourceMap);
+    am_Source_Database_s const *pObject = objectForKeyIfExistsInMap(sourceID, mMappedData.mSourceMap);
     if ( NULL != pObject )
     {
-        if (pObject->listSoundProperties.size() > 0 && 0 == pObject->cacheSoundProperties.size())
-        {
-            std::vector<am_SoundProperty_s>::const_iterator iter = pObject->listSoundProperties.begin();
-            for (; iter < pObject->listSoundProperties.end(); ++iter)
-            {
-                pObject->cacheSoundProperties[iter->type] = iter->value;
-            }
-        }
-
-        auto it = pObject->cacheSoundProperties.find(propertyType);
-        if (it != pObject->cacheSoundProperties.end())
+        am_SoundProperty_s const *property = pObject->indexSoundProperties.find(pObject->listSoundProperties, propertyType);
+        if (NULL != property)
         {
-            value = it->second;
+            value = property->value;
             return (E_OK);
         }
     }
@@ -3068,22 +3262,13 @@ am_Error_e CAmDatabaseHandlerMap::getSourceSoundPropertyValue(const am_sourceID_
 
 am_Error_e CAmDatabaseHandlerMap::getMainSinkSoundPropertyValue(const am_sinkID_t sinkID, const am_CustomMainSoundPropertyType_t propertyType, int16_t &value) const
 {
-    am_Sink_Database_s *pObject = (am_Sink_Database_s *)objectForKeyIfExistsInMap(sinkID, mMappedData.mSinkMap);
+    am_Sink_Database_s const *pObject = objectForKeyIfExistsInMap(sinkID, mMappedData.mSinkMap);
     if ( NULL != pObject )
     {
-        if (pObject->listMainSoundProperties.size() > 0 && 0 == pObject->cacheMainSoundProperties.size())
+        am_MainSoundProperty_s const *property = pObject->indexMainSoundProperties.find(pObject->listMainSoundProperties, propertyType);
+        if (NULL != property)
         {
-            std::vector<am_MainSoundProperty_s>::const_iterator iter = pObject->listMainSoundProperties.begin();
-            for (; iter < pObject->listMainSoundProperties.end(); ++iter)
-            {
-                pObject->cacheMainSoundProperties[iter->type] = iter->value;
-            }
-        }
-
-        auto it = pObject->cacheMainSoundProperties.find(propertyType);
-        if (it != pObject->cacheMainSoundProperties.end())
-        {
-            value = it->second;
+            value = property->value;
             return (E_OK);
         }
     }
@@ -3096,22 +3281,13 @@ am_Error_e CAmDatabaseHandlerMap::getMainSinkSoundPropertyValue(const am_sinkID_
 am_Error_e CAmDatabaseHandlerMap::getMainSourceSoundPropertyValue(const am_sourceID_t sourceID, const am_CustomMainSoundPropertyType_t propertyType, int16_t &value) const
 {
 
-    am_Source_Database_s *pObject = (am_Source_Database_s *)objectForKeyIfExistsInMap(sourceID, mMappedData.mSourceMap);
+    am_Source_Database_s const *pObject = objectForKeyIfExistsInMap(sourceID, mMappedData.mSourceMap);
     if ( NULL != pObject )
     {
-        if (pObject->listMainSoundProperties.size() > 0 && 0 == pObject->cacheMainSoundProperties.size())
+        am_MainSoundProperty_s const *property = pObject->indexMainSoundProperties.find(pObject->listMainSoundProperties, propertyType);
+        if (NULL != property)
         {
-            std::vector<am_MainSoundProperty_s>::const_iterator iter = pObject->listMainSoundProperties.begin();
-            for (; iter < pObject->listMainSoundProperties.end(); ++iter)
-            {
-                pObject->cacheMainSoundProperties[iter->type] = iter->value;
-            }
-        }
-
-        auto it = pObject->cacheMainSoundProperties.find(propertyType);
-        if (it != pObject->cacheMainSoundProperties.end())
-        {
-            value = it->second;
+            value = property->value;
             return (E_OK);
         }
     }
@@ -3140,13 +3316,8 @@ am_Error_e CAmDatabaseHandlerMap::peekDomain(const std::string &name, am_domainI
 {
     domainID = 0;
 
-    am_Domain_Database_s const *reservedDomain = objectMatchingPredicate<am_Domain_Database_s, am_domainID_t>(mMappedData.mDomainMap, [&](const am_Domain_Database_s &obj){
-                return name.compare(obj.name) == 0;
-            });
-
-    if ( NULL != reservedDomain )
+    if (mMappedData.mDomainNames.find(name, domainID))
     {
-        domainID = reservedDomain->domainID;
         return E_OK;
     }
     else
@@ -3160,6 +3331,7 @@ am_Error_e CAmDatabaseHandlerMap::peekDomain(const std::string &name, am_domainI
             domain.name                    = name;
             domain.reserved                = 1;
             mMappedData.mDomainMap[nextID] = domain;
+            mMappedData.mDomainNames.set(nextID, name);
             return E_OK;
         }
 
@@ -3171,12 +3343,8 @@ am_Error_e CAmDatabaseHandlerMap::peekDomain(const std::string &name, am_domainI
 
 am_Error_e CAmDatabaseHandlerMap::peekSink(const std::string &name, am_sinkID_t &sinkID)
 {
-    am_Sink_Database_s const *reservedSink = objectMatchingPredicate<am_Sink_Database_s, am_sinkID_t>(mMappedData.mSinkMap, [&](const am_Sink_Database_s &obj){
-                return name.compare(obj.name) == 0;
-            });
-    if ( NULL != reservedSink )
+    if (mMappedData.mSinkNames.find(name, sinkID))
     {
-        sinkID = reservedSink->sinkID;
         return E_OK;
     }
     else
@@ -3196,6 +3364,7 @@ am_Error_e CAmDatabaseHandlerMap::peekSink(const std::string &name, am_sinkID_t
             object.name                  = name;
             object.reserved              = 1;
             mMappedData.mSinkMap[nextID] = object;
+            mMappedData.mSinkNames.set(nextID, name);
             return E_OK;
         }
 
@@ -3205,12 +3374,8 @@ am_Error_e CAmDatabaseHandlerMap::peekSink(const std::string &name, am_sinkID_t
 
 am_Error_e CAmDatabaseHandlerMap::peekSource(const std::string &name, am_sourceID_t &sourceID)
 {
-    am_Source_Database_s const *reservedSrc = objectMatchingPredicate<am_Source_Database_s, am_sourceID_t>(mMappedData.mSourceMap, [&](const am_Source_Database_s &obj){
-                return name.compare(obj.name) == 0;
-            });
-    if ( NULL != reservedSrc )
+    if (mMappedData.mSourceNames.find(name, sourceID))
     {
-        sourceID = reservedSrc->sourceID;
         return E_OK;
     }
     else
@@ -3230,6 +3395,7 @@ am_Error_e CAmDatabaseHandlerMap::peekSource(const std::string &name, am_sourceI
             object.name                    = name;
             object.reserved                = 1;
             mMappedData.mSourceMap[nextID] = object;
+            mMappedData.mSourceNames.set(nextID, name);
             return E_OK;
         }
         else
@@ -3272,20 +3438,12 @@ am_Error_e CAmDatabaseHandlerMap::changeSourceSoundPropertyDB(const am_SoundProp
         return (E_NON_EXISTENT);
     }
 
-    am_Source_Database_s                     &source = mMappedData.mSourceMap[sourceID];
-    std::vector<am_SoundProperty_s>::iterator iter   = source.listSoundProperties.begin();
-    for (; iter < source.listSoundProperties.end(); ++iter)
+    am_Source_Database_s &source     = mMappedData.mSourceMap[sourceID];
+    am_SoundProperty_s *property = source.indexSoundProperties.find(source.listSoundProperties, soundProperty.type);
+    if (NULL != property)
     {
-        if ( soundProperty.type == iter->type )
-        {
-            iter->value = soundProperty.value;
-            if (source.cacheSoundProperties.size())
-            {
-                source.cacheSoundProperties[soundProperty.type] = soundProperty.value;
-            }
-
-            return (E_OK);
-        }
+        property->value = soundProperty.value;
+        return (E_OK);
     }
 
     logError(__METHOD_NAME__, "soundproperty type must be valid source:", sourceID, "type", soundProperty.type);
@@ -3301,20 +3459,12 @@ am_Error_e CAmDatabaseHandlerMap::changeSinkSoundPropertyDB(const am_SoundProper
         return (E_NON_EXISTENT);
     }
 
-    am_Sink_Database_s                       &sink = mMappedData.mSinkMap[sinkID];
-    std::vector<am_SoundProperty_s>::iterator iter = sink.listSoundProperties.begin();
-    for (; iter < sink.listSoundProperties.end(); ++iter)
+    am_Sink_Database_s &sink     = mMappedData.mSinkMap[sinkID];
+    am_SoundProperty_s *property = sink.indexSoundProperties.find(sink.listSoundProperties, soundProperty.type);
+    if (NULL != property)
     {
-        if ( soundProperty.type == iter->type )
-        {
-            iter->value = soundProperty.value;
-            if (sink.cacheSoundProperties.size())
-            {
-                sink.cacheSoundProperties[soundProperty.type] = soundProperty.value;
-            }
-
-            return (E_OK);
-        }
+        property->value = soundProperty.value;
+        return (E_OK);
     }
 
     logError(__METHOD_NAME__, "soundproperty type must be valid sinkID:", sinkID, "type", soundProperty.type);
@@ -3353,12 +3503,8 @@ am_Error_e am::CAmDatabaseHandlerMap::peekSinkClassID(const std::string &name, a
         return (E_NON_EXISTENT);
     }
 
-    am_SinkClass_Database_s const *reserved = objectMatchingPredicate<am_SinkClass_Database_s, am_sinkClass_t>(mMappedData.mSinkClassesMap, [&](const am_SinkClass_Database_s &obj){
-                return name.compare(obj.name) == 0;
-            });
-    if ( NULL != reserved )
+    if (mMappedData.mSinkClassNames.find(name, sinkClassID))
     {
-        sinkClassID = reserved->sinkClassID;
         return E_OK;
     }
 
@@ -3372,12 +3518,8 @@ am_Error_e am::CAmDatabaseHandlerMap::peekSourceClassID(const std::string &name,
         return (E_NON_EXISTENT);
     }
 
-    am_SourceClass_Database_s const *ptrSource = objectMatchingPredicate<am_SourceClass_Database_s, am_sourceClass_t>(mMappedData.mSourceClassesMap, [&](const am_SourceClass_Database_s &obj){
-                return name.compare(obj.name) == 0;
-            });
-    if ( NULL != ptrSource )
+    if (mMappedData.mSourceClassNames.find(name, sourceClassID))
     {
-        sourceClassID = ptrSource->sourceClassID;
         return E_OK;
     }
 
@@ -3398,21 +3540,16 @@ am_Error_e CAmDatabaseHandlerMap::changeSourceDB(const am_sourceID_t sourceID, c
     std::vector<am_MainSoundProperty_s> listMainSoundPropertiesOut(listMainSoundProperties);
     // check if sinkClass needs to be changed
 
-    std::unordered_map<am_sourceID_t, am_Source_Database_s>::iterator iter = mMappedData.mSourceMap.begin();
-    for (; iter != mMappedData.mSourceMap.end(); ++iter)
+    AmMapSource::iterator iter = mMappedData.mSourceMap.find(sourceID);
+    if (iter != mMappedData.mSourceMap.end())
     {
-        if ( iter->second.sourceID == sourceID )
+        if (sourceClassID != 0)
         {
-            if (sourceClassID != 0)
-            {
-                DB_COND_UPDATE(iter->second.sourceClassID, sourceClassID);
-            }
-            else if (0 == iter->second.reserved)
-            {
-                sourceClassOut = iter->second.sourceClassID;
-            }
-
-            break;
+            DB_COND_UPDATE(iter->second.sourceClassID, sourceClassID);
+        }
+        else if (0 == iter->second.reserved)
+        {
+            sourceClassOut = iter->second.sourceClassID;
         }
     }
 
@@ -3420,7 +3557,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSourceDB(const am_sourceID_t sourceID, c
     if (!listSoundProperties.empty())
     {
         mMappedData.mSourceMap.at(sourceID).listSoundProperties = listSoundProperties;
-        mMappedData.mSourceMap.at(sourceID).cacheSoundProperties.clear();
+        mMappedData.mSourceMap.at(sourceID).indexSoundProperties.rebuild(listSoundProperties);
     }
 
     // check if we have to update the list of connectionformats
@@ -3435,7 +3572,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSourceDB(const am_sourceID_t sourceID, c
         if (!listMainSoundProperties.empty())
         {
             DB_COND_UPDATE(mMappedData.mSourceMap.at(sourceID).listMainSoundProperties, listMainSoundProperties);
-            mMappedData.mSourceMap.at(sourceID).cacheMainSoundProperties.clear();
+            mMappedData.mSourceMap.at(sourceID).indexMainSoundProperties.rebuild(listMainSoundProperties);
         }
         else
         {
@@ -3447,6 +3584,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSourceDB(const am_sourceID_t sourceID, c
     {
         logVerbose("DatabaseHandler::changeSource changed changeSource of source:", sourceID);
 
+        journalChange(JE_SOURCE, JO_CHANGED, sourceID);
         NOTIFY_OBSERVERS4(dboSourceUpdated, sourceID, sourceClassOut, listMainSoundPropertiesOut, sourceVisible(sourceID))
 
     }
@@ -3468,21 +3606,16 @@ am_Error_e CAmDatabaseHandlerMap::changeSinkDB(const am_sinkID_t sinkID, const a
         return (E_NON_EXISTENT);
     }
 
-    std::unordered_map<am_sinkID_t, am_Sink_Database_s>::iterator iter = mMappedData.mSinkMap.begin();
-    for (; iter != mMappedData.mSinkMap.end(); ++iter)
+    AmMapSink::iterator iter = mMappedData.mSinkMap.find(sinkID);
+    if (iter != mMappedData.mSinkMap.end())
     {
-        if (iter->second.sinkID == sinkID)
+        if (sinkClassID != 0)
         {
-            if (sinkClassID != 0)
-            {
-                DB_COND_UPDATE(iter->second.sinkClassID, sinkClassID);
-            }
-            else if (0 == iter->second.reserved)
-            {
-                sinkClassOut = iter->second.sinkClassID;
-            }
-
-            break;
+            DB_COND_UPDATE(iter->second.sinkClassID, sinkClassID);
+        }
+        else if (0 == iter->second.reserved)
+        {
+            sinkClassOut = iter->second.sinkClassID;
         }
     }
 
@@ -3490,7 +3623,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSinkDB(const am_sinkID_t sinkID, const a
     if (!listSoundProperties.empty())
     {
         mMappedData.mSinkMap.at(sinkID).listSoundProperties = listSoundProperties;
-        mMappedData.mSinkMap.at(sinkID).cacheSoundProperties.clear();
+        mMappedData.mSinkMap.at(sinkID).indexSoundProperties.rebuild(listSoundProperties);
     }
 
     // check if we have to update the list of connectionformats
@@ -3505,7 +3638,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSinkDB(const am_sinkID_t sinkID, const a
         if (!listMainSoundProperties.empty())
         {
             DB_COND_UPDATE(mMappedData.mSinkMap.at(sinkID).listMainSoundProperties, listMainSoundProperties);
-            mMappedData.mSinkMap.at(sinkID).cacheMainSoundProperties.clear();
+            mMappedData.mSinkMap.at(sinkID).indexMainSoundProperties.rebuild(listMainSoundProperties);
         }
         else // read out the properties
         {
@@ -3517,6 +3650,7 @@ am_Error_e CAmDatabaseHandlerMap::changeSinkDB(const am_sinkID_t sinkID, const a
     {
         logVerbose("DatabaseHandler::changeSink changed changeSink of sink:", sinkID);
 
+        journalChange(JE_SINK, JO_CHANGED, sinkID);
         NOTIFY_OBSERVERS4(dboSinkUpdated, sinkID, sinkClassOut, listMainSoundPropertiesOut, sinkVisible(sinkID))
     }
 
@@ -3591,6 +3725,7 @@ am_Error_e CAmDatabaseHandlerMap::changeMainSinkNotificationConfigurationDB(cons
 
     logVerbose("DatabaseHandler::changeMainSinkNotificationConfigurationDB changed MainNotificationConfiguration of source:", sinkID, "type:", mainNotificationConfiguration.type, "to status=", mainNotificationConfiguration.status, "and parameter=", mainNotificationConfiguration.parameter);
 
+    journalChange(JE_SINK, JO_CHANGED, sinkID);
     NOTIFY_OBSERVERS2(dboSinkMainNotificationConfigurationChanged, sinkID, mainNotificationConfiguration)
 
     return (E_OK);
@@ -3612,6 +3747,7 @@ am_Error_e CAmDatabaseHandlerMap::changeMainSourceNotificationConfigurationDB(co
 
     logVerbose("DatabaseHandler::changeMainSourceNotificationConfigurationDB changed MainNotificationConfiguration of source:", sourceID, "type:", mainNotificationConfiguration.type, "to status=", mainNotificationConfiguration.status, "and parameter=", mainNotificationConfiguration.parameter);
 
+    journalChange(JE_SOURCE, JO_CHANGED, sourceID);
     NOTIFY_OBSERVERS2(dboSourceMainNotificationConfigurationChanged, sourceID, mainNotificationConfiguration)
 
     return (E_OK);
@@ -3786,6 +3922,50 @@ am_Error_e CAmDatabaseHandlerMap::enumerateConverters(std::function<void(const a
     return E_OK;
 }
 
+void CAmDatabaseHandlerMap::journalChange(const am_JournalElement_e element, const am_JournalOperation_e operation, const uint16_t elementID)
+{
+    am_JournalEntry_s entry;
+    entry.version   = ++mJournalVersion;
+    entry.element   = element;
+    entry.operation = operation;
+    entry.elementID = elementID;
+
+    // the entry of version v is stored at (v - 1) % capacity, so the oldest one gets overwritten
+    mJournal[(entry.version - 1) % AM_JOURNAL_CAPACITY] = entry;
+}
+
+uint32_t CAmDatabaseHandlerMap::getJournalVersion() const
+{
+    return (mJournalVersion);
+}
+
+am_Error_e CAmDatabaseHandlerMap::getJournalChanges(const uint32_t sinceVersion, std::vector<am_JournalEntry_s> &listChanges) const
+{
+    listChanges.clear();
+    if (sinceVersion > mJournalVersion || mJournalVersion - sinceVersion > AM_JOURNAL_CAPACITY)
+    {
+        logVerbose(__METHOD_NAME__, "version", sinceVersion, "not in journal, current version", mJournalVersion);
+        return (E_NOT_POSSIBLE);
+    }
+
+    listChanges.reserve(mJournalVersion - sinceVersion);
+    for (uint32_t version = sinceVersion + 1; version <= mJournalVersion; version++)
+    {
+        listChanges.push_back(mJournal[(version - 1) % AM_JOURNAL_CAPACITY]);
+    }
+
+    return (E_OK);
+}
+
+am_Error_e CAmDatabaseHandlerMap::getJournalSnapshot(am_JournalSnapshot_s &snapshot) const
+{
+    snapshot.version = mJournalVersion;
+    getListMainSinks(snapshot.listMainSinks);
+    getListMainSources(snapshot.listMainSources);
+    getListVisibleMainConnections(snapshot.listMainConnections);
+    return (getListSystemProperties(snapshot.listSystemProperties));
+}
+
 bool CAmDatabaseHandlerMap::registerObserver(IAmDatabaseObserver *iObserver)
 {
     assert(iObserver != NULL);
@@ -26,6 +26,9 @@
 #include <algorithm>
 #include <vector>
 #include <iterator>
+#include <limits>
+#include <atomic>
+#include <thread>
 #include "CAmRouter.h"
 #include "IAmDatabaseHandler.h"
 #include "CAmControlSender.h"
@@ -47,6 +50,30 @@ void getMergeConnectionFormats(const X *element, const am_CustomConnectionFormat
         listRestrictedConnectionFormats.end(), inserter);
 }
 
+/**
+ * Enters a node into a table indexed by the given ID. If the ID is already taken the first node is kept, which is the
+ * one a linear search through the node lists would have found.
+ */
+static void indexNode(std::vector<CAmRoutingNode *> &index, const uint16_t id, CAmRoutingNode *node)
+{
+    if (id >= index.size())
+    {
+        index.resize(id + 1, NULL);
+    }
+
+    if (index[id] == NULL)
+    {
+        index[id] = node;
+    }
+}
+
+static const uint16_t UNKNOWN_DOMAIN_INDEX = std::numeric_limits<uint16_t>::max();
+
+static CAmRoutingNode *nodeWithIndex(const std::vector<CAmRoutingNode *> &index, const uint16_t id)
+{
+    return (id < index.size()) ? index[id] : NULL;
+}
+
 CAmRouter::CAmRouter(IAmDatabaseHandler *iDatabaseHandler, CAmControlSender *iSender)
     : CAmDatabaseHandlerMap::AmDatabaseObserverCallbacks()
     , mpDatabaseHandler(iDatabaseHandler)
@@ -59,6 +86,33 @@ CAmRouter::CAmRouter(IAmDatabaseHandler *iDatabaseHandler, CAmControlSender *iSe
     , mNodeListSinks()
     , mNodeListGateways()
     , mNodeListConverters()
+    , mSourceNodeIndex()
+    , mSinkNodeIndex()
+    , mGatewayNodeIndex()
+    , mConverterNodeIndex()
+    , mCostModel(RCM_HOPS)
+    , mCustomEdgeCost()
+    , mUnknownDelay(0)
+    , mConnectionDelays()
+    , mRoutingThreads(0)
+    , mSearchContext()
+    , mWorkers()
+    , mWorkMutex()
+    , mWorkCondition()
+    , mWorkDoneCondition()
+    , mpWork(NULL)
+    , mWorkGeneration(0)
+    , mWorkersBusy(0)
+    , mWorkersStop(false)
+    , mDomainIndex()
+    , mDomainReachability()
+    , mDomainReachabilityWords(0)
+    , mCacheConnectionFormatChoices(false)
+    , mConnectionFormatChoices()
+    , mConnectionFormatChoiceHits(0)
+    , mConnectionFormatChoiceMisses(0)
+    , mpTrace(NULL)
+    , mTraceRoutes(false)
 {
     assert(mpDatabaseHandler);
     assert(mpControlSender);
@@ -87,10 +141,30 @@ CAmRouter::CAmRouter(IAmDatabaseHandler *iDatabaseHandler, CAmControlSender *iSe
     dboRemoveConverter = [&](const am_converterID_t converterID){
             mUpdateGraphNodesAction = true;
         };
+    dboNewSinks = [&](const std::vector<am_Sink_s> &){
+            mUpdateGraphNodesAction = true;
+        };
+    dboNewSources = [&](const std::vector<am_Source_s> &){
+            mUpdateGraphNodesAction = true;
+        };
+    dboRemovedSinks = [&](const std::vector<am_sinkID_t> &, const std::vector<bool> &){
+            mUpdateGraphNodesAction = true;
+        };
+    dboRemovedSources = [&](const std::vector<am_sourceID_t> &, const std::vector<bool> &){
+            mUpdateGraphNodesAction = true;
+        };
+    dboTimingInformationChanged = [&](const am_mainConnectionID_t, const am_timeSync_t){
+            // the edge costs of the hop model do not depend on the delays
+            if (mCostModel != RCM_HOPS)
+            {
+                mUpdateGraphNodesAction = true;
+            }
+        };
 }
 
 CAmRouter::~CAmRouter()
 {
+    stopWorkers();
 }
 
 /**
@@ -103,6 +177,14 @@ CAmRouter::~CAmRouter()
  */
 am_Error_e CAmRouter::getRoute(const bool onlyfree, const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_Route_s> &returnList)
 {
+    if (mTraceRoutes)
+    {
+        am_RouteTrace_s trace;
+        getRoute(onlyfree, sourceID, sinkID, returnList, trace);
+        logRouteTrace(sourceID, sinkID, trace);
+        return trace.error;
+    }
+
     if (mUpdateGraphNodesAction)
     {
         load();
@@ -117,6 +199,41 @@ am_Error_e CAmRouter::getRoute(const bool onlyfree, const am_Source_s &aSource,
     return getRoute(onlyfree, aSource.sourceID, aSink.sinkID, listRoutes);
 }
 
+am_Error_e CAmRouter::getRoute(const bool onlyfree, const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_Route_s> &returnList,
+    am_RouteTrace_s &trace)
+{
+    trace   = am_RouteTrace_s();
+    mpTrace = &trace;
+    if (mUpdateGraphNodesAction)
+    {
+        const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+        load();
+        mUpdateGraphNodesAction = false;
+        trace.loadTime          = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start);
+    }
+
+    trace.error = getRouteFromLoadedNodes(onlyfree, sourceID, sinkID, returnList);
+    mpTrace     = NULL;
+    logVerbose("CAmRouter::getRoute traced route from source", sourceID, "to sink", sinkID, "error", trace.error, "paths", trace.listPaths.size(),
+        "nodes", trace.nodesExplored, "edges", trace.edgesExplored, "controller calls", trace.connectionFormatChoices);
+    return trace.error;
+}
+
+void CAmRouter::logRouteTrace(const am_sourceID_t sourceID, const am_sinkID_t sinkID, const am_RouteTrace_s &trace) const
+{
+    logInfo("CAmRouter::logRouteTrace route from source", sourceID, "to sink", sinkID, "error", trace.error, "unreachable", trace.unreachable,
+        "searches", trace.searches, "nodes", trace.nodesExplored, "edges", trace.edgesExplored);
+    logInfo("CAmRouter::logRouteTrace pruned domain cycle", trace.pruned[RPR_DOMAIN_CYCLE], "unreachable domain", trace.pruned[RPR_UNREACHABLE_DOMAIN],
+        "busy", trace.pruned[RPR_BUSY], "format mismatch", trace.pruned[RPR_FORMAT_MISMATCH]);
+    logInfo("CAmRouter::logRouteTrace controller calls", trace.connectionFormatChoices, "cached", trace.cachedConnectionFormatChoices,
+        "load ns", trace.loadTime.count(), "search ns", trace.searchTime.count(), "permutation ns", trace.permutationTime.count());
+    for (auto it = trace.listPaths.begin(); it != trace.listPaths.end(); it++)
+    {
+        logInfo("CAmRouter::logRouteTrace path of", it->route.route.size(), "elements cost", it->cost, "evaluated", it->evaluated,
+            "permutations", it->permutations);
+    }
+}
+
 am_Error_e CAmRouter::getRouteFromLoadedNodes(const bool onlyfree, const am_sourceID_t sourceID, const am_sinkID_t sinkID,
     std::vector<am_Route_s> &returnList)
 {
@@ -130,6 +247,17 @@ am_Error_e CAmRouter::getRouteFromLoadedNodes(const bool onlyfree, const am_sour
         return E_NON_EXISTENT;
     }
 
+    // no gateway path between the domains
+    if (!isDomainReachable(pRootSource->getData().domainID(), pRootSink->getData().domainID()))
+    {
+        if (mpTrace)
+        {
+            mpTrace->unreachable = true;
+        }
+
+        return E_NOT_POSSIBLE;
+    }
+
     // try to find paths without cycles
     am_Error_e error = getFirstNShortestPaths(onlyfree, 0, mMaxPathCount, *pRootSource, *pRootSink, returnList);
 
@@ -152,16 +280,256 @@ am_Error_e CAmRouter::getRouteFromLoadedNodes(const bool onlyfree, const am_Sour
     return getRouteFromLoadedNodes(onlyfree, aSource.sourceID, aSink.sinkID, listRoutes);
 }
 
+am_Error_e CAmRouter::getRoutes(const bool onlyfree, const std::vector<std::pair<am_sourceID_t, am_sinkID_t> > &listPairs,
+    std::vector<std::vector<am_Route_s> > &listRoutes)
+{
+    if (mUpdateGraphNodesAction)
+    {
+        load();
+        mUpdateGraphNodesAction = false;
+    }
+
+    am_Error_e                    error = E_OK;
+    std::vector<CAmRoutingNode *> listSourceNodes(listPairs.size(), NULL);
+    std::vector<CAmRoutingNode *> listSinkNodes(listPairs.size(), NULL);
+    std::vector<size_t>           listIndexes;
+    listRoutes.assign(listPairs.size(), std::vector<am_Route_s>());
+    for (size_t i = 0; i < listPairs.size(); i++)
+    {
+        listSourceNodes[i] = sourceNodeWithID(listPairs[i].first);
+        listSinkNodes[i]   = sinkNodeWithID(listPairs[i].second);
+        if (!listSourceNodes[i] || !listSinkNodes[i])
+        {
+            error = E_NON_EXISTENT;
+        }
+        else if (isDomainReachable(listSourceNodes[i]->getData().domainID(), listSinkNodes[i]->getData().domainID()))
+        {
+            listIndexes.push_back(i);
+        }
+    }
+
+    // the graph search runs on the workers, the controller is asked for the connection formats on this thread only
+    std::vector<am_RoutingPaths_s> listPaths(listPairs.size());
+    findPathsConcurrently(onlyfree, 0, listIndexes, listSourceNodes, listSinkNodes, listPaths);
+    std::vector<size_t> listCycleIndexes;
+    for (auto it = listIndexes.begin(); it != listIndexes.end(); it++)
+    {
+        if (cfPermutationsForPaths(listPaths[*it], mMaxPathCount, listRoutes[*it]) != E_OK)
+        {
+            listCycleIndexes.push_back(*it);
+        }
+    }
+
+    // a second search with cycles for the pairs without routes, like getRoute
+    if (mMaxAllowedCycles > 0 && !listCycleIndexes.empty())
+    {
+        for (auto it = listCycleIndexes.begin(); it != listCycleIndexes.end(); it++)
+        {
+            listPaths[*it] = am_RoutingPaths_s();
+        }
+
+        findPathsConcurrently(onlyfree, mMaxAllowedCycles, listCycleIndexes, listSourceNodes, listSinkNodes, listPaths);
+        for (auto it = listCycleIndexes.begin(); it != listCycleIndexes.end(); it++)
+        {
+            cfPermutationsForPaths(listPaths[*it], mMaxPathCount, listRoutes[*it]);
+        }
+    }
+
+    for (auto it = listRoutes.begin(); error == E_OK && it != listRoutes.end(); it++)
+    {
+        if (it->empty())
+        {
+            error = E_NOT_POSSIBLE;
+        }
+    }
+
+    return error;
+}
+
+am_Error_e CAmRouter::getRoutesToAllSinks(const bool onlyfree, const am_sourceID_t sourceID, CAmRoutingSinkFilter filter,
+    std::vector<am_Route_s> &returnList)
+{
+    if (mUpdateGraphNodesAction)
+    {
+        load();
+        mUpdateGraphNodesAction = false;
+    }
+
+    returnList.clear();
+    CAmRoutingNode *pRootSource = sourceNodeWithID(sourceID);
+    if (!pRootSource)
+    {
+        return E_NON_EXISTENT;
+    }
+
+    const am_domainID_t           sourceDomainID = pRootSource->getData().domainID();
+    std::vector<CAmRoutingNode *> listSinkNodes;
+    for (auto it = mSinkNodeIndex.begin(); it != mSinkNodeIndex.end(); it++)
+    {
+        if (*it && isDomainReachable(sourceDomainID, (*it)->getData().domainID()) && (!filter || filter(*(*it)->getData().data.sink)))
+        {
+            listSinkNodes.push_back(*it);
+        }
+    }
+
+    return getRoutesForEach(onlyfree, *pRootSource, listSinkNodes, returnList);
+}
+
+am_Error_e CAmRouter::getRoutesFromAllSources(const bool onlyfree, const am_sinkID_t sinkID, CAmRoutingSourceFilter filter,
+    std::vector<am_Route_s> &returnList)
+{
+    if (mUpdateGraphNodesAction)
+    {
+        load();
+        mUpdateGraphNodesAction = false;
+    }
+
+    returnList.clear();
+    CAmRoutingNode *pRootSink = sinkNodeWithID(sinkID);
+    if (!pRootSink)
+    {
+        return E_NON_EXISTENT;
+    }
+
+    const am_domainID_t           sinkDomainID = pRootSink->getData().domainID();
+    std::vector<CAmRoutingNode *> listSourceNodes;
+    for (auto it = mSourceNodeIndex.begin(); it != mSourceNodeIndex.end(); it++)
+    {
+        if (*it && isDomainReachable((*it)->getData().domainID(), sinkDomainID) && (!filter || filter(*(*it)->getData().data.source)))
+        {
+            listSourceNodes.push_back(*it);
+        }
+    }
+
+    return getRoutesForEach(onlyfree, *pRootSink, listSourceNodes, returnList);
+}
+
+am_Error_e CAmRouter::getRoutesForEach(const bool onlyfree, CAmRoutingNode &node, const std::vector<CAmRoutingNode *> &listEndNodes,
+    std::vector<am_Route_s> &returnList)
+{
+    // try to find paths without cycles
+    std::vector<std::vector<am_Route_s> > listRoutes(listEndNodes.size());
+    getFirstNShortestPathsForEach(onlyfree, 0, mMaxPathCount, node, listEndNodes, listRoutes);
+
+    // a second search with cycles for the end nodes without paths.
+    if (mMaxAllowedCycles > 0)
+    {
+        std::vector<CAmRoutingNode *> listRemainingNodes;
+        std::vector<size_t>           listPositions;
+        for (size_t i = 0; i < listRoutes.size(); i++)
+        {
+            if (listRoutes[i].empty())
+            {
+                listRemainingNodes.push_back(listEndNodes[i]);
+                listPositions.push_back(i);
+            }
+        }
+
+        if (!listRemainingNodes.empty())
+        {
+            std::vector<std::vector<am_Route_s> > listCycleRoutes(listRemainingNodes.size());
+            getFirstNShortestPathsForEach(onlyfree, mMaxAllowedCycles, mMaxPathCount, node, listRemainingNodes, listCycleRoutes);
+            for (size_t i = 0; i < listPositions.size(); i++)
+            {
+                listRoutes[listPositions[i]].swap(listCycleRoutes[i]);
+            }
+        }
+    }
+
+    for (auto it = listRoutes.begin(); it != listRoutes.end(); it++)
+    {
+        returnList.insert(returnList.end(), it->begin(), it->end());
+    }
+
+    return returnList.empty() ? E_NOT_POSSIBLE : E_OK;
+}
+
+am_Error_e CAmRouter::setCostModel(const am_RoutingCostModel_e model, CAmRoutingEdgeCost customEdgeCost)
+{
+    if (model == RCM_CUSTOM && !customEdgeCost)
+    {
+        logError("CAmRouter::setCostModel the custom cost model needs a callback");
+        return E_NOT_POSSIBLE;
+    }
+
+    mCostModel              = model;
+    mCustomEdgeCost         = customEdgeCost;
+    mUpdateGraphNodesAction = true;
+    return E_OK;
+}
+
+am_Error_e CAmRouter::setUnknownDelay(const am_timeSync_t delay)
+{
+    if (delay < 0)
+    {
+        logError("CAmRouter::setUnknownDelay the delay must not be negative", delay);
+        return E_OUT_OF_RANGE;
+    }
+
+    mUnknownDelay = delay;
+    if (mCostModel == RCM_DELAY)
+    {
+        mUpdateGraphNodesAction = true;
+    }
+
+    return E_OK;
+}
+
+uint16_t CAmRouter::edgeCost(const CAmRoutingNode &from, const CAmRoutingNode &to) const
+{
+    if (mCostModel == RCM_HOPS)
+    {
+        return 1;
+    }
+
+    const am_RoutingNodeData_s &fromData = from.getData();
+    const am_RoutingNodeData_s &toData   = to.getData();
+    const bool                  connects = (fromData.type == CAmNodeDataType::SOURCE && toData.type == CAmNodeDataType::SINK);
+    am_timeSync_t               delay    = -1;
+    if (connects)
+    {
+        auto iter = mConnectionDelays.find(std::make_pair(fromData.data.source->sourceID, toData.data.sink->sinkID));
+        if (iter != mConnectionDelays.end())
+        {
+            delay = iter->second;
+        }
+    }
+
+    if (mCostModel == RCM_CUSTOM)
+    {
+        return mCustomEdgeCost(fromData, toData, delay);
+    }
+
+    // the edges within a gateway or converter have no delay of their own
+    if (connects && delay < 0)
+    {
+        delay = mUnknownDelay;
+    }
+
+    return (delay > 0) ? 1 + delay : 1;
+}
+
 void CAmRouter::load()
 {
     clear();
 
+    if (mCostModel != RCM_HOPS)
+    {
+        std::vector<am_Connection_s> listConnections;
+        mpDatabaseHandler->getListConnections(listConnections);
+        for (auto it = listConnections.begin(); it != listConnections.end(); it++)
+        {
+            mConnectionDelays[std::make_pair(it->sourceID, it->sinkID)] = it->delay;
+        }
+    }
+
     am_RoutingNodeData_s nodeDataSrc;
     nodeDataSrc.type = CAmNodeDataType::SOURCE;
     mpDatabaseHandler->enumerateSources([&](const am_Source_s &obj){
             nodeDataSrc.data.source = (am_Source_s *)&obj;
             auto node = &mRoutingGraph.addNode(nodeDataSrc);
             mNodeListSources[nodeDataSrc.data.source->domainID].push_back(node);
+            indexNode(mSourceNodeIndex, nodeDataSrc.data.source->sourceID, node);
         });
 
     am_RoutingNodeData_s nodeDataSink;
@@ -170,6 +538,7 @@ void CAmRouter::load()
             nodeDataSink.data.sink = (am_Sink_s *)&obj;
             auto node = &mRoutingGraph.addNode(nodeDataSink);
             mNodeListSinks[nodeDataSink.data.sink->domainID].push_back(node);
+            indexNode(mSinkNodeIndex, nodeDataSink.data.sink->sinkID, node);
         });
 
     am_RoutingNodeData_s nodeDataGateway;
@@ -178,6 +547,7 @@ void CAmRouter::load()
             nodeDataGateway.data.gateway = (am_Gateway_s *)&obj;
             auto node = &mRoutingGraph.addNode(nodeDataGateway);
             mNodeListGateways[nodeDataGateway.data.gateway->controlDomainID].push_back(node);
+            indexNode(mGatewayNodeIndex, nodeDataGateway.data.gateway->sinkID, node);
         });
 
     am_RoutingNodeData_s nodeDataConverter;
@@ -186,11 +556,13 @@ void CAmRouter::load()
             nodeDataConverter.data.converter = (am_Converter_s *)&obj;
             auto node = &mRoutingGraph.addNode(nodeDataConverter);
             mNodeListConverters[nodeDataConverter.data.converter->domainID].push_back(node);
+            indexNode(mConverterNodeIndex, nodeDataConverter.data.converter->sinkID, node);
         });
 
     constructConverterConnections();
     constructGatewayConnections();
     constructSourceSinkConnections();
+    constructDomainReachability();
 
 #ifdef TRACE_GRAPH
     mRoutingGraph.trace([&](const CAmRoutingNode &node, const std::vector<CAmVertex<am_RoutingNodeData_s, uint16_t> *> &list){
@@ -222,63 +594,214 @@ void CAmRouter::clear()
     mNodeListSinks.clear();
     mNodeListGateways.clear();
     mNodeListConverters.clear();
+    mSourceNodeIndex.clear();
+    mSinkNodeIndex.clear();
+    mGatewayNodeIndex.clear();
+    mConverterNodeIndex.clear();
+    mConnectionDelays.clear();
+    mConnectionFormatChoices.clear();
+    mDomainIndex.clear();
+    mDomainReachability.clear();
+    mDomainReachabilityWords = 0;
 }
 
-CAmRoutingNode *CAmRouter::sinkNodeWithID(const am_sinkID_t sinkID)
+void CAmRouter::constructDomainReachability()
 {
-    CAmRoutingNode *result = NULL;
+    std::vector<am_domainID_t> listDomainIDs;
+    auto                       addDomain = [this, &listDomainIDs](const am_domainID_t domainID){
+            if (domainID >= mDomainIndex.size())
+            {
+                mDomainIndex.resize(domainID + 1, UNKNOWN_DOMAIN_INDEX);
+            }
+
+            if (mDomainIndex[domainID] == UNKNOWN_DOMAIN_INDEX)
+            {
+                mDomainIndex[domainID] = listDomainIDs.size();
+                listDomainIDs.push_back(domainID);
+            }
+        };
+    for (auto it = mNodeListSources.begin(); it != mNodeListSources.end(); it++)
+    {
+        addDomain(it->first);
+    }
+
     for (auto it = mNodeListSinks.begin(); it != mNodeListSinks.end(); it++)
     {
-        result = sinkNodeWithID(sinkID, it->first);
-        if (result)
+        addDomain(it->first);
+    }
+
+    // only gateways that are connected to their source in the graph lead into another domain
+    std::vector<std::pair<am_domainID_t, am_domainID_t> > listGatewayDomains;
+    for (auto iter = mNodeListGateways.begin(); iter != mNodeListGateways.end(); iter++)
+    {
+        for (auto it = iter->second.begin(); it != iter->second.end(); it++)
         {
-            return result;
+            am_Gateway_s   *gateway           = (*it)->getData().data.gateway;
+            CAmRoutingNode *gatewaySourceNode = sourceNodeWithID(gateway->sourceID, gateway->domainSourceID);
+            if (gatewaySourceNode && mRoutingGraph.isAnyVertex(**it, *gatewaySourceNode))
+            {
+                addDomain(gateway->domainSinkID);
+                addDomain(gateway->domainSourceID);
+                listGatewayDomains.push_back(std::make_pair(gateway->domainSinkID, gateway->domainSourceID));
+            }
         }
     }
 
-    return result;
+    const size_t count = listDomainIDs.size();
+    mDomainReachabilityWords = (count + 63) / 64;
+    mDomainReachability.assign(count * mDomainReachabilityWords, 0);
+    auto setBit = [this](const size_t row, const size_t column){
+            mDomainReachability[row * mDomainReachabilityWords + column / 64] |= (uint64_t(1) << (column % 64));
+        };
+    for (size_t i = 0; i < count; i++)
+    {
+        setBit(i, i);
+    }
+
+    for (auto it = listGatewayDomains.begin(); it != listGatewayDomains.end(); it++)
+    {
+        setBit(mDomainIndex[it->first], mDomainIndex[it->second]);
+    }
+
+    // transitive closure (Warshall), rows are merged word by word
+    for (size_t k = 0; k < count; k++)
+    {
+        const uint64_t *rowK = &mDomainReachability[k * mDomainReachabilityWords];
+        for (size_t i = 0; i < count; i++)
+        {
+            uint64_t *rowI = &mDomainReachability[i * mDomainReachabilityWords];
+            if (i != k && (rowI[k / 64] & (uint64_t(1) << (k % 64))))
+            {
+                for (size_t w = 0; w < mDomainReachabilityWords; w++)
+                {
+                    rowI[w] |= rowK[w];
+                }
+            }
+        }
+    }
 }
 
-CAmRoutingNode *CAmRouter::sinkNodeWithID(const am_sinkID_t sinkID, const am_domainID_t domainID)
+bool CAmRouter::isDomainReachable(const am_domainID_t sourceDomainID, const am_domainID_t sinkDomainID) const
 {
-    CAmRoutingNode                *result = NULL;
-    std::vector<CAmRoutingNode *> &value = mNodeListSinks[domainID];
-    auto                           iter = std::find_if(value.begin(), value.end(), [sinkID](CAmRoutingNode *node){
-                return node->getData().data.sink->sinkID == sinkID;
-            });
-    if (iter != value.end())
+    if (sourceDomainID >= mDomainIndex.size() || sinkDomainID >= mDomainIndex.size())
     {
-        result = *iter;
+        return true;
     }
 
-    return result;
+    const uint16_t row    = mDomainIndex[sourceDomainID];
+    const uint16_t column = mDomainIndex[sinkDomainID];
+    if (row == UNKNOWN_DOMAIN_INDEX || column == UNKNOWN_DOMAIN_INDEX)
+    {
+        return true;
+    }
+
+    return (mDomainReachability[row * mDomainReachabilityWords + column / 64] & (uint64_t(1) << (column % 64))) != 0;
 }
 
-CAmRoutingNode *CAmRouter::sourceNodeWithID(const am_sourceID_t sourceID)
+bool CAmRouter::mayReachDomain(const am_RoutingNodeData_s &nodeData, const am_domainID_t domainID) const
 {
-    CAmRoutingNode *result = NULL;
-    for (auto it = mNodeListSources.begin(); it != mNodeListSources.end(); it++)
+    if (am_RoutingNodeData_s::GATEWAY == nodeData.type)
     {
-        result = sourceNodeWithID(sourceID, it->first);
-        if (result)
+        return isDomainReachable(nodeData.data.gateway->domainSourceID, domainID);
+    }
+
+    return isDomainReachable(nodeData.domainID(), domainID);
+}
+
+bool CAmRouter::mayBeReachedFromDomain(const am_RoutingNodeData_s &nodeData, const am_domainID_t domainID) const
+{
+    if (am_RoutingNodeData_s::GATEWAY == nodeData.type)
+    {
+        return isDomainReachable(domainID, nodeData.data.gateway->domainSinkID);
+    }
+
+    return isDomainReachable(domainID, nodeData.domainID());
+}
+
+void CAmRouter::setConnectionFormatChoiceCaching(const bool enable)
+{
+    if (enable && !mCacheConnectionFormatChoices)
+    {
+        mConnectionFormatChoiceHits   = 0;
+        mConnectionFormatChoiceMisses = 0;
+    }
+
+    mCacheConnectionFormatChoices = enable;
+    mConnectionFormatChoices.clear();
+}
+
+void CAmRouter::invalidateConnectionFormatChoices()
+{
+    logVerbose("CAmRouter::invalidateConnectionFormatChoices cached choices:", mConnectionFormatChoices.size(), "hits:", mConnectionFormatChoiceHits,
+        "misses:", mConnectionFormatChoiceMisses);
+    mConnectionFormatChoices.clear();
+}
+
+am_Error_e CAmRouter::getConnectionFormatChoice(const am_sourceID_t sourceID, const am_sinkID_t sinkID, const am_Route_s &route,
+    const std::vector<am_CustomConnectionFormat_t> &listPossibleConnectionFormats, std::vector<am_CustomConnectionFormat_t> &listPriorityConnectionFormats)
+{
+    if (!mCacheConnectionFormatChoices)
+    {
+        if (mpTrace)
         {
-            return result;
+            mpTrace->connectionFormatChoices++;
         }
+
+        return mpControlSender->getConnectionFormatChoice(sourceID, sinkID, route, listPossibleConnectionFormats, listPriorityConnectionFormats);
+    }
+
+    CAmConnectionFormatChoiceKey key(sourceID, sinkID, listPossibleConnectionFormats);
+    auto                         iter = mConnectionFormatChoices.find(key);
+    if (iter != mConnectionFormatChoices.end())
+    {
+        if (mpTrace)
+        {
+            mpTrace->cachedConnectionFormatChoices++;
+        }
+
+        mConnectionFormatChoiceHits++;
+        listPriorityConnectionFormats = iter->second.second;
+        return iter->second.first;
+    }
+
+    mConnectionFormatChoiceMisses++;
+    if (mpTrace)
+    {
+        mpTrace->connectionFormatChoices++;
+    }
+
+    am_Error_e error = mpControlSender->getConnectionFormatChoice(sourceID, sinkID, route, listPossibleConnectionFormats, listPriorityConnectionFormats);
+    mConnectionFormatChoices.emplace(std::move(key), CAmConnectionFormatChoice(error, listPriorityConnectionFormats));
+    return error;
+}
+
+CAmRoutingNode *CAmRouter::sinkNodeWithID(const am_sinkID_t sinkID)
+{
+    return nodeWithIndex(mSinkNodeIndex, sinkID);
+}
+
+CAmRoutingNode *CAmRouter::sinkNodeWithID(const am_sinkID_t sinkID, const am_domainID_t domainID)
+{
+    CAmRoutingNode *result = nodeWithIndex(mSinkNodeIndex, sinkID);
+    if (result && result->getData().data.sink->domainID != domainID)
+    {
+        result = NULL;
     }
 
     return result;
 }
 
+CAmRoutingNode *CAmRouter::sourceNodeWithID(const am_sourceID_t sourceID)
+{
+    return nodeWithIndex(mSourceNodeIndex, sourceID);
+}
+
 CAmRoutingNode *CAmRouter::sourceNodeWithID(const am_sourceID_t sourceID, const am_domainID_t domainID)
 {
-    CAmRoutingNode                *result = NULL;
-    std::vector<CAmRoutingNode *> &value = mNodeListSources[domainID];
-    auto                           iter = std::find_if(value.begin(), value.end(), [sourceID](CAmRoutingNode *node){
-                return node->getData().data.source->sourceID == sourceID;
-            });
-    if (iter != value.end())
+    CAmRoutingNode *result = nodeWithIndex(mSourceNodeIndex, sourceID);
+    if (result && result->getData().data.source->domainID != domainID)
     {
-        result = *iter;
+        result = NULL;
     }
 
     return result;
@@ -286,14 +809,10 @@ CAmRoutingNode *CAmRouter::sourceNodeWithID(const am_sourceID_t sourceID, const
 
 CAmRoutingNode *CAmRouter::converterNodeWithSinkID(const am_sinkID_t sinkID, const am_domainID_t domainID)
 {
-    CAmRoutingNode                *result = NULL;
-    std::vector<CAmRoutingNode *> &value = mNodeListConverters[domainID];
-    auto                           iter = std::find_if(value.begin(), value.end(), [sinkID](CAmRoutingNode *node){
-                return node->getData().data.converter->sinkID == sinkID;
-            });
-    if (iter != value.end())
+    CAmRoutingNode *result = nodeWithIndex(mConverterNodeIndex, sinkID);
+    if (result && result->getData().data.converter->domainID != domainID)
     {
-        result = *iter;
+        result = NULL;
     }
 
     return result;
@@ -301,19 +820,7 @@ CAmRoutingNode *CAmRouter::converterNodeWithSinkID(const am_sinkID_t sinkID, con
 
 CAmRoutingNode *CAmRouter::gatewayNodeWithSinkID(const am_sinkID_t sinkID)
 {
-    for (auto it = mNodeListGateways.begin(); it != mNodeListGateways.end(); it++)
-    {
-        std::vector<CAmRoutingNode *> &value = it->second;
-        auto                           iter = std::find_if(value.begin(), value.end(), [sinkID](CAmRoutingNode *node){
-                    return node->getData().data.gateway->sinkID == sinkID;
-                });
-        if (iter != value.end())
-        {
-            return *iter;
-        }
-    }
-
-    return NULL;
+    return nodeWithIndex(mGatewayNodeIndex, sinkID);
 }
 
 void CAmRouter::constructSourceSinkConnections()
@@ -337,7 +844,7 @@ void CAmRouter::constructSourceSinkConnections()
                 listPossibleConnectionFormats(source->listConnectionFormats, sink->listConnectionFormats, intersection);
                 if (intersection.size() > 0)     // OK  match source -> sink
                 {
-                    mRoutingGraph.connectNodes(*srcNode, *sinkNode, CF_UNKNOWN, 1);
+                    mRoutingGraph.connectNodes(*srcNode, *sinkNode, CF_UNKNOWN, edgeCost(*srcNode, *sinkNode));
                 }
             }
         }
@@ -371,8 +878,8 @@ void CAmRouter::constructGatewayConnections()
                     if (gatewaySourceNode)
                     {
                         // Connections hidden_sink->gateway->hidden_source
-                        mRoutingGraph.connectNodes(*gatewaySinkNode, *gatewayNode, CF_UNKNOWN, 1);
-                        mRoutingGraph.connectNodes(*gatewayNode, *gatewaySourceNode, CF_UNKNOWN, 1);
+                        mRoutingGraph.connectNodes(*gatewaySinkNode, *gatewayNode, CF_UNKNOWN, edgeCost(*gatewaySinkNode, *gatewayNode));
+                        mRoutingGraph.connectNodes(*gatewayNode, *gatewaySourceNode, CF_UNKNOWN, edgeCost(*gatewayNode, *gatewaySourceNode));
                     }
                 }
             }
@@ -408,8 +915,8 @@ void CAmRouter::constructConverterConnections()
                     if (converterSourceNode)
                     {
                         // Connections hidden_sink->converter->hidden_source
-                        mRoutingGraph.connectNodes(*converterSinkNode, *converterNode, CF_UNKNOWN, 1);
-                        mRoutingGraph.connectNodes(*converterNode, *converterSourceNode, CF_UNKNOWN, 1);
+                        mRoutingGraph.connectNodes(*converterSinkNode, *converterNode, CF_UNKNOWN, edgeCost(*converterSinkNode, *converterNode));
+                        mRoutingGraph.connectNodes(*converterNode, *converterSourceNode, CF_UNKNOWN, edgeCost(*converterNode, *converterSourceNode));
                     }
                 }
             }
@@ -434,7 +941,7 @@ void CAmRouter::getVerticesForSource(const CAmRoutingNode &node, CAmRoutingListV
         listPossibleConnectionFormats(source->listConnectionFormats, sink->listConnectionFormats, intersection);
         if (intersection.size() > 0)     // OK  match source -> sink
         {
-            list.emplace_back(sinkNode, CF_UNKNOWN, 1);
+            list.emplace_back(sinkNode, CF_UNKNOWN, edgeCost(node, *sinkNode));
         }
     }
 }
@@ -455,7 +962,7 @@ void CAmRouter::getVerticesForSink(const CAmRoutingNode &node, CAmRoutingListVer
         if (getAllowedFormatsFromConvMatrix(converter->convertionMatrix, converter->listSourceFormats, converter->listSinkFormats, sourceFormats,
                 sinkFormats))
         {
-            list.emplace_back(converterNode, CF_UNKNOWN, 1);
+            list.emplace_back(converterNode, CF_UNKNOWN, edgeCost(node, *converterNode));
         }
     }
     else
@@ -471,7 +978,7 @@ void CAmRouter::getVerticesForSink(const CAmRoutingNode &node, CAmRoutingListVer
             if (getAllowedFormatsFromConvMatrix(gateway->convertionMatrix, gateway->listSourceFormats, gateway->listSinkFormats, sourceFormats,
                     sinkFormats))
             {
-                list.emplace_back(gatewayNode, CF_UNKNOWN, 1);
+                list.emplace_back(gatewayNode, CF_UNKNOWN, edgeCost(node, *gatewayNode));
             }
         }
     }
@@ -488,7 +995,7 @@ void CAmRouter::getVerticesForConverter(const CAmRoutingNode &node, CAmRoutingLi
         CAmRoutingNode *converterSourceNode = this->sourceNodeWithID(converter->sourceID, converter->domainID);
         if (converterSourceNode)
         {
-            list.emplace_back(converterSourceNode, CF_UNKNOWN, 1);
+            list.emplace_back(converterSourceNode, CF_UNKNOWN, edgeCost(node, *converterSourceNode));
         }
     }
 }
@@ -504,7 +1011,7 @@ void CAmRouter::getVerticesForGateway(const CAmRoutingNode &node, CAmRoutingList
         if (gatewaySourceNode)
         {
             // Connections hidden_sink->gateway->hidden_source
-            list.emplace_back(gatewaySourceNode, CF_UNKNOWN, 1);
+            list.emplace_back(gatewaySourceNode, CF_UNKNOWN, edgeCost(node, *gatewaySourceNode));
         }
     }
 }
@@ -530,163 +1037,131 @@ void CAmRouter::getVerticesForNode(const CAmRoutingNode &node, CAmRoutingListVer
     }
 }
 
-am_Error_e CAmRouter::determineConnectionFormatsForPath(am_Route_s &routeObjects, std::vector<CAmRoutingNode *> &nodes, std::vector<am_Route_s> &result)
+am_Error_e CAmRouter::prioritizedConnectionFormats(const am_Route_s &routeObjects, const std::vector<CAmRoutingNode *> &nodes, const size_t index,
+    std::vector<am_CustomConnectionFormat_t> &listPriorityConnectionFormats)
 {
-    std::vector<am_RoutingElement_s>::iterator routingElementIterator = routeObjects.route.begin();
-    std::vector<CAmRoutingNode *>::iterator    nodeIterator           = nodes.begin();
-    if (routingElementIterator != routeObjects.route.end() && nodeIterator != nodes.end())
+    // the path is source, sink, followed by gateway or converter, source, sink for every further routing element
+    const size_t nodeIndex = 3 * index;
+    if (nodeIndex + 1 >= nodes.size())
     {
-        return doConnectionFormatsForPath(routeObjects, nodes, routingElementIterator, nodeIterator, result);
+        return (E_UNKNOWN);
     }
 
-    return E_OK;
-}
+    CAmRoutingNode *nodeSource = nodes[nodeIndex];
+    CAmRoutingNode *nodeSink   = nodes[nodeIndex + 1];
+    if (nodeSource->getData().type != CAmNodeDataType::SOURCE || nodeSink->getData().type != CAmNodeDataType::SINK)
+    {
+        return (E_UNKNOWN);
+    }
 
-am_Error_e CAmRouter::doConnectionFormatsForPath(am_Route_s &routeObjects, std::vector<CAmRoutingNode *> &nodes,
-    std::vector<am_RoutingElement_s>::iterator routingElementIterator, std::vector<CAmRoutingNode *>::iterator nodeIterator,
-    std::vector<am_Route_s> &result)
-{
-    am_Error_e                               returnError = E_NOT_POSSIBLE;
-    std::vector<am_CustomConnectionFormat_t> listConnectionFormats;
     std::vector<am_CustomConnectionFormat_t> listMergeConnectionFormats;
-
-    std::vector<CAmRoutingNode *>::iterator    currentNodeIterator           = nodeIterator;
-    std::vector<am_RoutingElement_s>::iterator currentRoutingElementIterator = routingElementIterator;
-
-    if (currentRoutingElementIterator != routeObjects.route.begin())
+    if (index > 0)
     {
-        std::vector<am_CustomConnectionFormat_t>   listConnectionFormats;
-        std::vector<am_RoutingElement_s>::iterator tempIterator = (currentRoutingElementIterator - 1);
-        CAmRoutingNode                            *currentNode  = *currentNodeIterator;
-        if ((returnError = getSourceSinkPossibleConnectionFormats(currentNodeIterator + 1, currentNodeIterator + 2, listConnectionFormats)) != E_OK)
-        {
-            return returnError;
-        }
+        std::vector<am_CustomConnectionFormat_t> listConnectionFormats;
+        listPossibleConnectionFormats(nodeSource->getData().data.source->listConnectionFormats, nodeSink->getData().data.sink->listConnectionFormats,
+            listConnectionFormats);
 
-        if (currentNode->getData().type == CAmNodeDataType::GATEWAY)
+        const am_CustomConnectionFormat_t previousFormat = routeObjects.route[index - 1].connectionFormat;
+        const am_RoutingNodeData_s       &nodeData       = nodes[nodeIndex - 1]->getData();
+        if (nodeData.type == CAmNodeDataType::GATEWAY)
         {
-            am_Gateway_s *gateway = currentNode->getData().data.gateway;
-            getMergeConnectionFormats(gateway, tempIterator->connectionFormat, listConnectionFormats, listMergeConnectionFormats);
+            getMergeConnectionFormats(nodeData.data.gateway, previousFormat, listConnectionFormats, listMergeConnectionFormats);
         }
-        else if (currentNode->getData().type == CAmNodeDataType::CONVERTER)
+        else if (nodeData.type == CAmNodeDataType::CONVERTER)
         {
-            am_Converter_s *converter = currentNode->getData().data.converter;
-            getMergeConnectionFormats(converter, tempIterator->connectionFormat, listConnectionFormats, listMergeConnectionFormats);
+            getMergeConnectionFormats(nodeData.data.converter, previousFormat, listConnectionFormats, listMergeConnectionFormats);
         }
         else
         {
             return (E_UNKNOWN);
         }
-
-        currentNodeIterator += 3;
     }
     else
     {
-        CAmRoutingNode *currentNode = *currentNodeIterator;
-        if (currentNode->getData().type != CAmNodeDataType::SOURCE)
-        {
-            return (E_UNKNOWN);
-        }
-
-        currentNodeIterator++;
-
-        if (currentNodeIterator == nodes.end())
-        {
-            return (E_UNKNOWN);
-        }
+        listPossibleConnectionFormats(nodeSource->getData().data.source->listConnectionFormats, nodeSink->getData().data.sink->listConnectionFormats,
+            listMergeConnectionFormats);
+    }
 
-        CAmRoutingNode *nodeSink = *currentNodeIterator;
-        if (nodeSink->getData().type != CAmNodeDataType::SINK)
-        {
-            return (E_UNKNOWN);
-        }
+    // let the controller decide:
+    const am_RoutingElement_s &routingElement = routeObjects.route[index];
+    return getConnectionFormatChoice(routingElement.sourceID, routingElement.sinkID, routeObjects, listMergeConnectionFormats,
+        listPriorityConnectionFormats);
+}
 
-        am_Source_s *source = currentNode->getData().data.source;
-        am_Sink_s   *sink   = nodeSink->getData().data.sink;
-        listPossibleConnectionFormats(source->listConnectionFormats, sink->listConnectionFormats, listMergeConnectionFormats);
-        currentNodeIterator += 1;     // now we are on the next converter/gateway
+am_Error_e CAmRouter::determineConnectionFormatsForPath(am_Route_s &routeObjects, const std::vector<CAmRoutingNode *> &nodes, const size_t maxCount,
+    std::vector<am_Route_s> &result)
+{
+    const size_t count = routeObjects.route.size();
+    if (count == 0 || nodes.empty() || maxCount == 0)
+    {
+        return E_OK;
     }
 
-    // let the controller decide:
-    std::vector<am_CustomConnectionFormat_t> listPriorityConnectionFormats;
-    if ((returnError = mpControlSender->getConnectionFormatChoice(currentRoutingElementIterator->sourceID, currentRoutingElementIterator->sinkID,
-                 routeObjects, listMergeConnectionFormats, listPriorityConnectionFormats)) != E_OK)
+    // formats of every routing element sorted by priority and the position of the format which is currently tried,
+    // the route itself holds the current permutation so all results share the formats of their common prefix while searching
+    std::vector<std::vector<am_CustomConnectionFormat_t> > listPriorityConnectionFormats(count);
+    std::vector<size_t>                                    listPosition(count, 0);
+    am_Error_e                                             returnError = prioritizedConnectionFormats(routeObjects, nodes, 0,
+        listPriorityConnectionFormats[0]);
+    if (returnError != E_OK)
     {
         return (returnError);
     }
 
-    if (listPriorityConnectionFormats.empty())
+    if (listPriorityConnectionFormats[0].empty())
     {
         return (E_NOT_POSSIBLE);
     }
 
-    // we have the list sorted after priors - now we try one after the other with the next part of the route
-    std::vector<am_CustomConnectionFormat_t>::iterator connectionFormatIterator = listPriorityConnectionFormats.begin();
-    // here we need to check if we are at the end and stop
-    std::vector<am_RoutingElement_s>::iterator nextIterator = currentRoutingElementIterator + 1;     // next pair source and sink
-    if (nextIterator == routeObjects.route.end())
+    size_t       index = 0;
+    const size_t limit = result.size() + maxCount;
+    while (result.size() < limit)
     {
-        for (; connectionFormatIterator != listPriorityConnectionFormats.end(); ++connectionFormatIterator)
+        if (listPosition[index] == listPriorityConnectionFormats[index].size())
+        {
+            // all formats of this element are done, go back to the previous one
+            routeObjects.route[index].connectionFormat = CF_UNKNOWN;
+            if (index == 0)
+            {
+                break;
+            }
+
+            listPosition[--index]++;
+            continue;
+        }
+
+        routeObjects.route[index].connectionFormat = listPriorityConnectionFormats[index][listPosition[index]];
+        if (index + 1 == count)
         {
-            currentRoutingElementIterator->connectionFormat = *connectionFormatIterator;
             result.push_back(routeObjects);
+            listPosition[index]++;
         }
-    }
-    else
-    {
-        for (; connectionFormatIterator != listPriorityConnectionFormats.end(); ++connectionFormatIterator)
+        else
         {
-            currentRoutingElementIterator->connectionFormat = *connectionFormatIterator;
-            doConnectionFormatsForPath(routeObjects, nodes, nextIterator, currentNodeIterator, result);
+            // a failing element only cuts off this branch
+            index++;
+            listPosition[index] = 0;
+            listPriorityConnectionFormats[index].clear();
+            if (prioritizedConnectionFormats(routeObjects, nodes, index, listPriorityConnectionFormats[index]) != E_OK)
+            {
+                listPriorityConnectionFormats[index].clear();
+            }
         }
     }
 
     return (E_OK);
 }
 
-am_Error_e CAmRouter::cfPermutationsForPath(am_Route_s shortestRoute, std::vector<CAmRoutingNode *> resultNodesPath, std::vector<am_Route_s> &resultPath)
+am_Error_e CAmRouter::cfPermutationsForPath(am_Route_s shortestRoute, const std::vector<CAmRoutingNode *> &resultNodesPath, const size_t maxCount,
+    std::vector<am_Route_s> &resultPath)
 {
     std::vector<am_Route_s> result;
-    am_Error_e              err = determineConnectionFormatsForPath(shortestRoute, resultNodesPath, result);
+    am_Error_e              err = determineConnectionFormatsForPath(shortestRoute, resultNodesPath, maxCount, result);
     if (err != E_UNKNOWN)
     {
         resultPath.insert(resultPath.end(), result.begin(), result.end());
-#ifdef TRACE_GRAPH
-        std::cout
-            << "Determined connection formats for path from source:"
-            << shortestRoute.sourceID << " to sink:" << shortestRoute.sinkID
-            << "\n";
-        for (auto routeConnectionFormats : result)
-        {
-            std::cout << "[";
-            for (auto it = routeConnectionFormats.route.begin(); it != routeConnectionFormats.route.end(); it++)
-            {
-                am_RoutingElement_s &routingElement = *it;
-                if (it - routeConnectionFormats.route.begin() > 0)
-                {
-                    std::cout << " -> ";
-                }
-
-                std::cout << routingElement.sourceID << ":"
-                          << routingElement.sinkID << " CF:"
-                          << routingElement.connectionFormat << " D:"
-                          << routingElement.domainID;
-            }
-
-            std::cout << "]\n";
-        }
-#endif      // ifdef TRACE_GRAPH
     }
 
-#ifdef TRACE_GRAPH
-    else
-    {
-        std::cout
-            << "Error by determining connection formats for path from source:"
-            << shortestRoute.sourceID << " to sink:" << shortestRoute.sinkID
-            << "\n";
-    }
-#endif  // ifdef TRACE_GRAPH
     return err;
 }
 
@@ -717,22 +1192,17 @@ am_Error_e CAmRouter::getShortestPath(CAmRoutingNode &aSource, CAmRoutingNode &a
                 element->connectionFormat = CF_UNKNOWN;
             }
         }
-        else if (routingData.type == CAmNodeDataType::SOURCE)
+        else if (routingData.type == CAmNodeDataType::SOURCE && !shortestRoute.route.empty())
         {
-            auto iter = shortestRoute.route.emplace(shortestRoute.route.begin());
-            element = &(*iter);
-            if(element != NULL)
-            {
-                element->domainID         = routingData.data.source->domainID;
-                element->sourceID         = routingData.data.source->sourceID;
-                element->connectionFormat = CF_UNKNOWN;
-            }
+            // the sink of this element has already been visited
+            element = &shortestRoute.route.front();
+            element->sourceID = routingData.data.source->sourceID;
         }
     });
 
     if (shortestRoute.route.size())
     {
-        err = cfPermutationsForPath(shortestRoute, resultNodesPath, resultPath);
+        err = cfPermutationsForPath(shortestRoute, resultNodesPath, std::numeric_limits<size_t>::max(), resultPath);
     }
 
     return err;
@@ -765,6 +1235,52 @@ int CAmRouter::insertPostion(const std::vector<CAmRoutingNode *> &path, const st
     return index;
 }
 
+template <class TTracePolicy>
+void CAmRouter::findPaths(const bool onlyFree, const unsigned cycles, const CAmRoutingNode &aSource, const CAmRoutingNode &aSink,
+    CAmRoutingGraph::CAmSearchContext &context, TTracePolicy &tracePolicy, am_RoutingPaths_s &paths)
+{
+    CAmRoutingDomainTracker visitedDomains;
+    visitedDomains.reset(aSource.getData().domainID());
+
+    const am_domainID_t sinkDomainID = aSink.getData().domainID();
+    auto                cbShouldVisitNode = [&visitedDomains, &cycles, &onlyFree, &sinkDomainID, &tracePolicy, this](const CAmRoutingNode *node) -> bool {
+            const am_RoutingNodeData_s &nodeData = node->getData();
+            tracePolicy.exploreEdge();
+            if (!visitedDomains.shouldGoInDomain(nodeData.domainID(), cycles))
+            {
+                tracePolicy.prune(RPR_DOMAIN_CYCLE);
+                return false;
+            }
+
+            // nodes in domains without a gateway path to the sink domain are skipped
+            if (!mayReachDomain(nodeData, sinkDomainID))
+            {
+                tracePolicy.prune(RPR_UNREACHABLE_DOMAIN);
+                return false;
+            }
+
+            if (!isNodeFree(nodeData, onlyFree))
+            {
+                tracePolicy.prune(RPR_BUSY);
+                return false;
+            }
+
+            return true;
+        };
+    auto cbWillVisitNode = [&visitedDomains, &tracePolicy](const CAmRoutingNode *node){
+            visitedDomains.enter(node->getData().domainID());
+            tracePolicy.exploreNode();
+        };
+    auto cbDidVisitNode = [&visitedDomains](const CAmRoutingNode *){
+        visitedDomains.leave();
+    };
+    auto cbDidFinish = [&paths](const std::vector<CAmRoutingNode *> &path, const CAmRoutingGraph::weight_t weight){
+        insertPath(path, weight, paths);
+    };
+
+    mRoutingGraph.getAllPaths(aSource, aSink, context, cbShouldVisitNode, cbWillVisitNode, cbDidVisitNode, cbDidFinish);
+}
+
 am_Error_e CAmRouter::getFirstNShortestPaths(const bool onlyFree, const unsigned cycles, const unsigned maxPathCount, CAmRoutingNode &aSource,
     CAmRoutingNode &aSink, std::vector<am_Route_s> &resultPath)
 {
@@ -773,88 +1289,292 @@ am_Error_e CAmRouter::getFirstNShortestPaths(const bool onlyFree, const unsigned
         return E_NOT_POSSIBLE;
     }
 
-    const am_sinkID_t                           sinkID   = aSink.getData().data.sink->sinkID;
-    const am_sourceID_t                         sourceID = aSource.getData().data.source->sourceID;
-    std::vector<am_Route_s>                     paths;
-    std::vector<std::vector<CAmRoutingNode *> > nodes;
-    std::vector<am_domainID_t>                  visitedDomains;
-    visitedDomains.push_back(((CAmRoutingNode *)&aSource)->getData().domainID());
+    am_RoutingPaths_s paths;
+    if (!mpTrace)
+    {
+        CAmRouteNoTrace noTrace;
+        findPaths(onlyFree, cycles, aSource, aSink, mSearchContext, noTrace, paths);
+        return cfPermutationsForPaths(paths, maxPathCount, resultPath);
+    }
+
+    const std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+    CAmRouteTraceCounter                        counter(*mpTrace);
+    findPaths(onlyFree, cycles, aSource, aSink, mSearchContext, counter, paths);
+    const std::chrono::steady_clock::time_point searched = std::chrono::steady_clock::now();
+    am_Error_e                                  error    = cfPermutationsForPaths(paths, maxPathCount, resultPath);
+    mpTrace->searches++;
+    mpTrace->searchTime      += std::chrono::duration_cast<std::chrono::nanoseconds>(searched - start);
+    mpTrace->permutationTime += std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - searched);
+    return error;
+}
 
-    auto cbShouldVisitNode = [&visitedDomains, &cycles, &onlyFree, this](const CAmRoutingNode *node) -> bool {
-            if (CAmRouter::shouldGoInDomain(visitedDomains, node->getData().domainID(), cycles))
+void CAmRouter::findPathsConcurrently(const bool onlyFree, const unsigned cycles, const std::vector<size_t> &listIndexes,
+    const std::vector<CAmRoutingNode *> &listSourceNodes, const std::vector<CAmRoutingNode *> &listSinkNodes, std::vector<am_RoutingPaths_s> &listPaths)
+{
+    // every thread keeps the traversal state of its searches to itself, the graph is only read
+    std::atomic<size_t> next(0);
+    const std::function<void(CAmRoutingGraph::CAmSearchContext &)> job = [&](CAmRoutingGraph::CAmSearchContext &context) {
+            CAmRouteNoTrace noTrace;
+            for (size_t index = next++; index < listIndexes.size(); index = next++)
             {
-                const am_RoutingNodeData_s &nodeData = node->getData();
-                if (am_RoutingNodeData_s::GATEWAY == nodeData.type)
-                {
-                    const am_Gateway_s *gateway = nodeData.data.gateway;
-                    return (!onlyFree || !isComponentConnected(*gateway));
-                }
-                else if (am_RoutingNodeData_s::CONVERTER == nodeData.type)
+                const size_t pair = listIndexes[index];
+                findPaths(onlyFree, cycles, *listSourceNodes[pair], *listSinkNodes[pair], context, noTrace, listPaths[pair]);
+            }
+        };
+
+    if (mWorkers.empty() || listIndexes.size() <= 1)
+    {
+        job(mSearchContext);
+        return;
+    }
+
+    runOnWorkers(job);
+}
+
+void CAmRouter::setRoutingThreads(const unsigned count)
+{
+    if (count == mRoutingThreads)
+    {
+        return;
+    }
+
+    stopWorkers();
+    mRoutingThreads = count;
+    mWorkersStop    = false;
+    for (unsigned worker = 1; worker < count; ++worker)
+    {
+        mWorkers.emplace_back(&CAmRouter::workerMain, this, mWorkGeneration);
+    }
+}
+
+void CAmRouter::stopWorkers()
+{
+    {
+        std::lock_guard<std::mutex> lock(mWorkMutex);
+        mWorkersStop = true;
+    }
+
+    mWorkCondition.notify_all();
+    for (std::vector<std::thread>::iterator it = mWorkers.begin(); it != mWorkers.end(); ++it)
+    {
+        it->join();
+    }
+
+    mWorkers.clear();
+}
+
+void CAmRouter::runOnWorkers(const std::function<void(CAmRoutingGraph::CAmSearchContext &)> &job)
+{
+    {
+        std::lock_guard<std::mutex> lock(mWorkMutex);
+        mpWork = &job;
+        mWorkGeneration++;
+        mWorkersBusy = mWorkers.size();
+    }
+
+    mWorkCondition.notify_all();
+    job(mSearchContext);
+
+    std::unique_lock<std::mutex> lock(mWorkMutex);
+    mWorkDoneCondition.wait(lock, [this]() {
+            return mWorkersBusy == 0;
+        });
+    mpWork = NULL;
+}
+
+void CAmRouter::workerMain(uint64_t generation)
+{
+    CAmRoutingGraph::CAmSearchContext context;
+    std::unique_lock<std::mutex>      lock(mWorkMutex);
+    while (true)
+    {
+        mWorkCondition.wait(lock, [this, &generation]() {
+                return mWorkersStop || mWorkGeneration != generation;
+            });
+        if (mWorkersStop)
+        {
+            return;
+        }
+
+        generation = mWorkGeneration;
+        const std::function<void(CAmRoutingGraph::CAmSearchContext &)> &job = *mpWork;
+        lock.unlock();
+        job(context);
+        lock.lock();
+        if (--mWorkersBusy == 0)
+        {
+            mWorkDoneCondition.notify_one();
+        }
+    }
+}
+
+am_Error_e CAmRouter::getFirstNShortestPathsForEach(const bool onlyFree, const unsigned cycles, const unsigned maxPathCount, CAmRoutingNode &aNode,
+    const std::vector<CAmRoutingNode *> &listEndNodes, std::vector<std::vector<am_Route_s> > &resultPaths)
+{
+    const bool backwards = (aNode.getData().type == CAmNodeDataType::SINK);
+    if (!backwards && aNode.getData().type != CAmNodeDataType::SOURCE)
+    {
+        return E_NOT_POSSIBLE;
+    }
+
+    // position of every node in listEndNodes, -1 for all other nodes
+    std::vector<int>           listEndNodePositions(mRoutingGraph.getNodes().size(), -1);
+    std::vector<am_domainID_t> listEndDomains;
+    for (auto it = listEndNodes.begin(); it != listEndNodes.end(); it++)
+    {
+        listEndNodePositions[(*it)->getIndex()] = it - listEndNodes.begin();
+        const am_domainID_t domainID = (*it)->getData().domainID();
+        if (std::find(listEndDomains.begin(), listEndDomains.end(), domainID) == listEndDomains.end())
+        {
+            listEndDomains.push_back(domainID);
+        }
+    }
+
+    std::vector<am_RoutingPaths_s> paths(listEndNodes.size());
+    CAmRoutingDomainTracker        visitedDomains;
+    visitedDomains.reset(aNode.getData().domainID());
+
+    auto cbIsEndNode = [&listEndNodePositions](const CAmRoutingNode *node) -> bool {
+            return listEndNodePositions[node->getIndex()] >= 0;
+        };
+    auto cbShouldVisitNode = [&visitedDomains, &listEndDomains, &cycles, &onlyFree, &backwards, this](const CAmRoutingNode *node) -> bool {
+            const am_RoutingNodeData_s &nodeData = node->getData();
+            if (!visitedDomains.shouldGoInDomain(nodeData.domainID(), cycles))
+            {
+                return false;
+            }
+
+            // nodes that are not connected to the domain of any end node are skipped
+            for (auto it = listEndDomains.begin(); it != listEndDomains.end(); it++)
+            {
+                if (backwards ? mayBeReachedFromDomain(nodeData, *it) : mayReachDomain(nodeData, *it))
                 {
-                    const am_Converter_s *converter = nodeData.data.converter;
-                    return (!onlyFree || !isComponentConnected(*converter));
+                    return isNodeFree(nodeData, onlyFree);
                 }
-
-                return true;
             }
 
             return false;
         };
     auto cbWillVisitNode = [&visitedDomains](const CAmRoutingNode *node){
-            visitedDomains.push_back(node->getData().domainID());
+            visitedDomains.enter(node->getData().domainID());
         };
-    auto cbDidVisitNode = [&visitedDomains](const CAmRoutingNode *node){
-        visitedDomains.erase(visitedDomains.end() - 1);
-    };
-    auto cbDidFinish = [&resultPath, &nodes, &paths, &sinkID, &sourceID](const std::vector<CAmRoutingNode *> &path)
-    {
-        int index = CAmRouter::insertPostion(path, nodes);
-        nodes.emplace(nodes.begin() + index);
-        paths.emplace(paths.begin() + index);
-        nodes[index] = path;
-        am_Route_s &nextRoute = paths[index];
-        nextRoute.sinkID   = sinkID;
-        nextRoute.sourceID = sourceID;
-        am_RoutingElement_s *element = NULL;
-        for (auto it = path.begin(); it != path.end(); it++)
+    auto cbDidVisitNode = [&visitedDomains](const CAmRoutingNode *){
+            visitedDomains.leave();
+        };
+    auto cbDidFinish = [&paths, &listEndNodePositions, &backwards](const std::vector<CAmRoutingNode *> &path, const CAmRoutingGraph::weight_t weight){
+            const CAmRoutingNode *endNode = backwards ? path.front() : path.back();
+            insertPath(path, weight, paths[listEndNodePositions[endNode->getIndex()]]);
+        };
+
+    if (backwards)
+    {
+        mRoutingGraph.getAllPathsToNode(aNode, mSearchContext, cbIsEndNode, cbShouldVisitNode, cbWillVisitNode, cbDidVisitNode, cbDidFinish);
+    }
+    else
+    {
+        mRoutingGraph.getAllPathsFromNode(aNode, mSearchContext, cbIsEndNode, cbShouldVisitNode, cbWillVisitNode, cbDidVisitNode, cbDidFinish);
+    }
+
+    am_Error_e error = E_NOT_POSSIBLE;
+    for (size_t i = 0; i < paths.size(); i++)
+    {
+        if (cfPermutationsForPaths(paths[i], maxPathCount, resultPaths[i]) == E_OK)
+        {
+            error = E_OK;
+        }
+    }
+
+    return error;
+}
+
+bool CAmRouter::isNodeFree(const am_RoutingNodeData_s &nodeData, const bool onlyFree)
+{
+    if (am_RoutingNodeData_s::GATEWAY == nodeData.type)
+    {
+        const am_Gateway_s *gateway = nodeData.data.gateway;
+        return (!onlyFree || !isComponentConnected(*gateway));
+    }
+    else if (am_RoutingNodeData_s::CONVERTER == nodeData.type)
+    {
+        const am_Converter_s *converter = nodeData.data.converter;
+        return (!onlyFree || !isComponentConnected(*converter));
+    }
+
+    return true;
+}
+
+void CAmRouter::insertPath(const std::vector<CAmRoutingNode *> &path, const CAmRoutingGraph::weight_t weight, am_RoutingPaths_s &paths)
+{
+    // the paths are sorted by their cost, paths with the same cost keep the order in which they were found
+    int index = std::upper_bound(paths.weights.begin(), paths.weights.end(), weight) - paths.weights.begin();
+    paths.weights.insert(paths.weights.begin() + index, weight);
+    paths.nodes.emplace(paths.nodes.begin() + index, path);
+    am_Route_s &nextRoute = *paths.routes.emplace(paths.routes.begin() + index);
+    nextRoute.sourceID = path.front()->getData().data.source->sourceID;
+    nextRoute.sinkID   = path.back()->getData().data.sink->sinkID;
+    am_RoutingElement_s *element = NULL;
+    for (auto it = path.begin(); it != path.end(); it++)
+    {
+        am_RoutingNodeData_s &routingData = (*it)->getData();
+        if (routingData.type == CAmNodeDataType::SOURCE)
         {
-            am_RoutingNodeData_s &routingData = (*it)->getData();
-            if (routingData.type == CAmNodeDataType::SOURCE)
+            auto iter = nextRoute.route.emplace(nextRoute.route.end());
+            element                   = &(*iter);
+            if(element != NULL)
             {
-                auto iter = nextRoute.route.emplace(nextRoute.route.end());
-                element                   = &(*iter);
-                if(element != NULL)
-                {
-                    element->domainID         = routingData.data.source->domainID;
-                    element->sourceID         = routingData.data.source->sourceID;
-                    element->connectionFormat = CF_UNKNOWN;
-                }
+                element->domainID         = routingData.data.source->domainID;
+                element->sourceID         = routingData.data.source->sourceID;
+                element->connectionFormat = CF_UNKNOWN;
             }
-            else if (routingData.type == CAmNodeDataType::SINK)
+        }
+        else if (routingData.type == CAmNodeDataType::SINK)
+        {
+            if(element != NULL)
             {
-                if(element != NULL)
-                {
-                    element->domainID         = routingData.data.sink->domainID;
-                    element->sinkID           = routingData.data.sink->sinkID;
-                    element->connectionFormat = CF_UNKNOWN;
-                }
+                element->domainID         = routingData.data.sink->domainID;
+                element->sinkID           = routingData.data.sink->sinkID;
+                element->connectionFormat = CF_UNKNOWN;
             }
         }
-    };
+    }
+}
 
-    mRoutingGraph.getAllPaths(aSource, aSink, cbShouldVisitNode, cbWillVisitNode, cbDidVisitNode, cbDidFinish);
-    unsigned   pathsFound = 0;
-    am_Error_e cfError    = E_OK;
-    for (auto it = paths.begin(); pathsFound < maxPathCount && it != paths.end(); it++)
+am_Error_e CAmRouter::cfPermutationsForPaths(am_RoutingPaths_s &paths, const unsigned maxPathCount, std::vector<am_Route_s> &resultPath)
+{
+    // every connection format permutation counts as one path, the permutations of the cheapest paths come first
+    const size_t limit = resultPath.size() + maxPathCount;
+    const size_t first = resultPath.size();
+    for (auto it = paths.routes.begin(); it != paths.routes.end(); it++)
     {
-        cfError = cfPermutationsForPath(*it, nodes[it - paths.begin()], resultPath);
-        if (E_OK == cfError)
+        // a traced search reports the paths that are not evaluated as well
+        const bool evaluated = resultPath.size() < limit;
+        if (!evaluated && !mpTrace)
+        {
+            break;
+        }
+
+        const size_t count = resultPath.size();
+        if (evaluated)
+        {
+            cfPermutationsForPath(*it, paths.nodes[it - paths.routes.begin()], limit - resultPath.size(), resultPath);
+        }
+
+        if (mpTrace)
         {
-            pathsFound += (resultPath.size() > 0);
+            am_RouteTracePath_s tracePath;
+            tracePath.route        = *it;
+            tracePath.cost         = paths.weights[it - paths.routes.begin()];
+            tracePath.permutations = resultPath.size() - count;
+            tracePath.evaluated    = evaluated;
+            mpTrace->listPaths.push_back(tracePath);
+            if (evaluated && tracePath.permutations == 0)
+            {
+                mpTrace->pruned[RPR_FORMAT_MISMATCH]++;
+            }
         }
     }
 
-    if (pathsFound)
+    if (resultPath.size() > first)
     {
         return E_OK;
     }
@@ -902,6 +1622,56 @@ bool CAmRouter::shouldGoInDomain(const std::vector<am_domainID_t> &visitedDomain
     return CAmRouter::shouldGoInDomain(visitedDomains, nodeDomainID, mMaxAllowedCycles);
 }
 
+CAmRoutingDomainTracker::CAmRoutingDomainTracker()
+    : mRuns()
+    , mEntries()
+{
+    reset(0);
+}
+
+void CAmRoutingDomainTracker::reset(const am_domainID_t domainID)
+{
+    // the counters of the domains of the old path are the only ones that are not zero
+    for (auto it = mRuns.begin(); it != mRuns.end(); it++)
+    {
+        if (it->first < mEntries.size())
+        {
+            mEntries[it->first] = 0;
+        }
+    }
+
+    // like shouldGoInDomain the path starts behind a domain 0, so a first node in domain 0 doesn't count as an entry
+    mRuns.clear();
+    mRuns.push_back(std::make_pair(0, 0));
+    enter(domainID);
+}
+
+void CAmRoutingDomainTracker::enter(const am_domainID_t domainID)
+{
+    if (mRuns.back().first == domainID)
+    {
+        mRuns.back().second++;
+        return;
+    }
+
+    if (domainID >= mEntries.size())
+    {
+        mEntries.resize(domainID + 1, 0);
+    }
+
+    mEntries[domainID]++;
+    mRuns.push_back(std::make_pair(domainID, 1));
+}
+
+void CAmRoutingDomainTracker::leave()
+{
+    if (--mRuns.back().second == 0 && mRuns.size() > 1)
+    {
+        mEntries[mRuns.back().first]--;
+        mRuns.pop_back();
+    }
+}
+
 bool CAmRouter::getAllowedFormatsFromConvMatrix(const std::vector<bool> &convertionMatrix,
     const std::vector<am_CustomConnectionFormat_t> &listSourceFormats, const std::vector<am_CustomConnectionFormat_t> &listSinkFormats,
     std::vector<am_CustomConnectionFormat_t> &sourceFormats, std::vector<am_CustomConnectionFormat_t> &sinkFormats)
@@ -1013,10 +1783,10 @@ am_Error_e CAmRouter::getAllPaths(CAmRoutingNode &aSource, CAmRoutingNode &aSink
     const am_sinkID_t          sinkID   = aSink.getData().data.sink->sinkID;
     const am_sourceID_t        sourceID = aSource.getData().data.source->sourceID;
     std::vector<am_Route_s>    paths;
-    std::vector<am_domainID_t> visitedDomains;
-    visitedDomains.push_back(((CAmRoutingNode *)&aSource)->getData().domainID());
+    CAmRoutingDomainTracker    visitedDomains;
+    visitedDomains.reset(aSource.getData().domainID());
     mRoutingGraph.getAllPaths(aSource, aSink, [&visitedDomains, &cycles, &onlyFree, this](const CAmRoutingNode *node) -> bool {
-            if (CAmRouter::shouldGoInDomain(visitedDomains, node->getData().domainID(), cycles))
+            if (visitedDomains.shouldGoInDomain(node->getData().domainID(), cycles))
             {
                 const am_RoutingNodeData_s &nodeData = node->getData();
                 if (am_RoutingNodeData_s::GATEWAY == nodeData.type)
@@ -1035,9 +1805,9 @@ am_Error_e CAmRouter::getAllPaths(CAmRoutingNode &aSource, CAmRoutingNode &aSink
 
             return false;
         }, [&visitedDomains](const CAmRoutingNode *node){
-            visitedDomains.push_back(node->getData().domainID());
-        }, [&visitedDomains](const CAmRoutingNode *node){
-            visitedDomains.erase(visitedDomains.end() - 1);
+            visitedDomains.enter(node->getData().domainID());
+        }, [&visitedDomains](const CAmRoutingNode *){
+            visitedDomains.leave();
         },
         [&resultPath, &resultNodesPath, &paths, &errorsCount, &successCount, &sinkID, &sourceID](const std::vector<CAmRoutingNode *> &path)
         {
@@ -1077,7 +1847,7 @@ am_Error_e CAmRouter::getAllPaths(CAmRoutingNode &aSource, CAmRoutingNode &aSink
 
     for (auto it = paths.begin(); successCount < mMaxPathCount && it != paths.end(); it++)
     {
-        if (cfPermutationsForPath(*it, resultNodesPath[it - paths.begin()], resultPath) == E_UNKNOWN)
+        if (cfPermutationsForPath(*it, resultNodesPath[it - paths.begin()], std::numeric_limits<size_t>::max(), resultPath) == E_UNKNOWN)
         {
             errorsCount++;
         }
@@ -361,6 +361,26 @@ am_Error_e CAmRoutingReceiver::deregisterSource(const am_sourceID_t sourceID)
     return (mpControlSender->hookSystemDeregisterSource(sourceID));
 }
 
+am_Error_e CAmRoutingReceiver::registerSinks(const std::vector<am_Sink_s> &listSinkData, std::vector<am_sinkID_t> &listSinkIDs)
+{
+    return (mpControlSender->hookSystemRegisterSinks(listSinkData, listSinkIDs));
+}
+
+am_Error_e CAmRoutingReceiver::deregisterSinks(const std::vector<am_sinkID_t> &listSinkIDs)
+{
+    return (mpControlSender->hookSystemDeregisterSinks(listSinkIDs));
+}
+
+am_Error_e CAmRoutingReceiver::registerSources(const std::vector<am_Source_s> &listSourceData, std::vector<am_sourceID_t> &listSourceIDs)
+{
+    return (mpControlSender->hookSystemRegisterSources(listSourceData, listSourceIDs));
+}
+
+am_Error_e CAmRoutingReceiver::deregisterSources(const std::vector<am_sourceID_t> &listSourceIDs)
+{
+    return (mpControlSender->hookSystemDeregisterSources(listSourceIDs));
+}
+
 am_Error_e CAmRoutingReceiver::registerCrossfader(const am_Crossfader_s &crossfaderData, am_crossfaderID_t &crossfaderID)
 {
     return (mpControlSender->hookSystemRegisterCrossfader(crossfaderData, crossfaderID));
@@ -163,6 +163,33 @@ TEST_F(CAmControlInterfaceTest,deregisterSource)
     ASSERT_EQ(E_OK, pRoutingReceiver.deregisterSource(sourceID));
 }
 
+TEST_F(CAmControlInterfaceTest,registerSinksAndSources)
+{
+    std::vector<am_Sink_s> listSinks(2);
+    std::vector<am_Source_s> listSources(2);
+    std::vector<am_sinkID_t> listSinkIDs;
+    std::vector<am_sourceID_t> listSourceIDs;
+    pCF.createSink(listSinks[0]);
+    pCF.createSink(listSinks[1]);
+    pCF.createSource(listSources[0]);
+    pCF.createSource(listSources[1]);
+
+    //the whole batch has to arrive at the controller in one call
+    std::vector<am_sinkID_t> assignedSinkIDs = {2, 3};
+    std::vector<am_sourceID_t> assignedSourceIDs = {4, 5};
+    EXPECT_CALL(pMockControlInterface,hookSystemRegisterSinks(SizeIs(2),_)).WillOnce(DoAll(SetArgReferee<1>(assignedSinkIDs), Return(E_OK)));
+    EXPECT_CALL(pMockControlInterface,hookSystemRegisterSources(SizeIs(2),_)).WillOnce(DoAll(SetArgReferee<1>(assignedSourceIDs), Return(E_OK)));
+    ASSERT_EQ(E_OK, pRoutingReceiver.registerSinks(listSinks,listSinkIDs));
+    ASSERT_EQ(E_OK, pRoutingReceiver.registerSources(listSources,listSourceIDs));
+    ASSERT_EQ(assignedSinkIDs, listSinkIDs);
+    ASSERT_EQ(assignedSourceIDs, listSourceIDs);
+
+    EXPECT_CALL(pMockControlInterface,hookSystemDeregisterSinks(assignedSinkIDs)).WillOnce(Return(E_OK));
+    EXPECT_CALL(pMockControlInterface,hookSystemDeregisterSources(assignedSourceIDs)).WillOnce(Return(E_OK));
+    ASSERT_EQ(E_OK, pRoutingReceiver.deregisterSinks(listSinkIDs));
+    ASSERT_EQ(E_OK, pRoutingReceiver.deregisterSources(listSourceIDs));
+}
+
 TEST_F(CAmControlInterfaceTest,hookInterruptStatusChange)
 {
     am_Source_s source;
@@ -651,6 +678,29 @@ TEST_F(CAmControlInterfaceTest,ackConnectNotPossible)
 
 }
 
+TEST_F(CAmControlInterfaceTest,journal)
+{
+    am_Sink_s sink;
+    am_sinkID_t sinkID;
+    std::vector<am_JournalEntry_s> listChanges;
+    am_JournalSnapshot_s snapshot;
+    pCF.createSink(sink);
+    sink.sinkID = 0;
+
+    //the controller sees the changes of the database through the journal
+    uint32_t version = pControlReceiver.getJournalVersion();
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+    ASSERT_LT(version, pControlReceiver.getJournalVersion());
+    ASSERT_EQ(E_OK, pControlReceiver.getJournalChanges(version,listChanges));
+    ASSERT_EQ(1u, listChanges.size());
+    ASSERT_EQ(JE_SINK, listChanges[0].element);
+    ASSERT_EQ(JO_ADDED, listChanges[0].operation);
+    ASSERT_EQ(sinkID, listChanges[0].elementID);
+
+    ASSERT_EQ(E_OK, pControlReceiver.getJournalSnapshot(snapshot));
+    ASSERT_EQ(pControlReceiver.getJournalVersion(), snapshot.version);
+}
+
 int main(int argc, char **argv)
 {
 	try
@@ -390,6 +390,191 @@ TEST_F(CAmMapHandlerTest, peekSinkID)
     ASSERT_EQ(sinkClassID, peekID);
 }
 
+TEST_F(CAmMapHandlerTest, enterSinksAndSourcesBatch)
+{
+    std::vector<am_Sink_s> listSinkData(3);
+    std::vector<am_Source_s> listSourceData(3);
+    std::vector<am_sinkID_t> listSinkIDs;
+    std::vector<am_sourceID_t> listSourceIDs;
+    for (size_t i = 0; i < 3; i++)
+    {
+        pCF.createSink(listSinkData[i]);
+        listSinkData[i].name = "sink" + int2string(i);
+        pCF.createSource(listSourceData[i]);
+        listSourceData[i].name = "source" + int2string(i);
+    }
+
+    //the third sink uses an unknown domain and must be refused, the others get entered anyway
+    listSinkData[2].domainID = 33;
+
+    //observers get exactly one batch notification, no single ones
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), newSink(_)).Times(0);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), newSource(_)).Times(0);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), newSinks(SizeIs(2))).Times(1);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), newSources(SizeIs(3))).Times(1);
+    ASSERT_EQ(E_NOT_POSSIBLE, pDatabaseHandler.enterSinksDB(listSinkData, listSinkIDs));
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourcesDB(listSourceData, listSourceIDs));
+    ASSERT_EQ(3u, listSinkIDs.size());
+    ASSERT_EQ(3u, listSourceIDs.size());
+    ASSERT_EQ(0, listSinkIDs[2]);
+
+    for (size_t i = 0; i < 2; i++)
+    {
+        am_Sink_s sink;
+        ASSERT_EQ(E_OK, pDatabaseHandler.getSinkInfoDB(listSinkIDs[i], sink));
+        ASSERT_EQ(listSinkData[i].name, sink.name);
+    }
+
+    for (size_t i = 0; i < 3; i++)
+    {
+        am_Source_s source;
+        ASSERT_EQ(E_OK, pDatabaseHandler.getSourceInfoDB(listSourceIDs[i], source));
+        ASSERT_EQ(listSourceData[i].name, source.name);
+    }
+
+    //removing is batched the same way, unknown IDs are reported but do not stop the batch
+    listSinkIDs[2] = 4711;
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), removedSink(_, _)).Times(0);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), removedSource(_, _)).Times(0);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), removedSinks(SizeIs(2), SizeIs(2))).Times(1);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), removedSources(SizeIs(3), SizeIs(3))).Times(1);
+    ASSERT_EQ(E_NON_EXISTENT, pDatabaseHandler.removeSinksDB(listSinkIDs));
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeSourcesDB(listSourceIDs));
+
+    std::vector<am_Sink_s> listSinks;
+    std::vector<am_Source_s> listSources;
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSinks(listSinks));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSources(listSources));
+    ASSERT_TRUE(listSinks.empty());
+    ASSERT_TRUE(listSources.empty());
+}
+
+TEST_F(CAmMapHandlerTest, peekSinkNameAfterRemove)
+{
+    am_Sink_s sink;
+    am_sinkID_t sinkID, secondSinkID, peekID;
+    pCF.createSink(sink);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), newSink(_)).Times(2);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), removedSink(_, _)).Times(2);
+
+    //two dynamic sinks are allowed to carry the same name
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,secondSinkID));
+    ASSERT_NE(sinkID, secondSinkID);
+
+    //the name must still be known as long as one of them exists
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeSinkDB(sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.peekSink(sink.name,peekID));
+    ASSERT_EQ(secondSinkID, peekID);
+
+    //now the name is free again and peeking reserves a new sink
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeSinkDB(secondSinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.peekSink(sink.name,peekID));
+    ASSERT_NE(secondSinkID, peekID);
+    ASSERT_FALSE(pDatabaseHandler.existSink(peekID));
+}
+
+TEST_F(CAmMapHandlerTest, removeAndReenterSinks)
+{
+    am_Sink_s sink;
+    std::vector<am_sinkID_t> listSinkIDs(5);
+    std::vector<am_Sink_s> listSinks;
+    pCF.createSink(sink);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), newSink(_)).Times(7);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), removedSink(_, _)).Times(2);
+
+    for (size_t i = 0; i < 5; i++)
+    {
+        sink.name = "sink" + int2string(i);
+        ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink, listSinkIDs[i]));
+    }
+
+    //the removed sinks leave holes which are filled by the next sinks
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeSinkDB(listSinkIDs[1]));
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeSinkDB(listSinkIDs[3]));
+    ASSERT_FALSE(pDatabaseHandler.existSink(listSinkIDs[1]));
+    ASSERT_FALSE(pDatabaseHandler.existSink(listSinkIDs[3]));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSinks(listSinks));
+    ASSERT_EQ(3u, listSinks.size());
+
+    for (size_t i = 5; i < 7; i++)
+    {
+        am_sinkID_t sinkID;
+        sink.name = "sink" + int2string(i);
+        ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink, sinkID));
+        ASSERT_NE(listSinkIDs[1], sinkID);
+        ASSERT_NE(listSinkIDs[3], sinkID);
+        listSinkIDs.push_back(sinkID);
+    }
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSinks(listSinks));
+    ASSERT_EQ(5u, listSinks.size());
+    for (size_t i = 0; i < listSinkIDs.size(); i++)
+    {
+        am_Sink_s returnSink;
+        if (i == 1 || i == 3)
+        {
+            ASSERT_EQ(E_NON_EXISTENT, pDatabaseHandler.getSinkInfoDB(listSinkIDs[i], returnSink));
+            continue;
+        }
+
+        ASSERT_EQ(E_OK, pDatabaseHandler.getSinkInfoDB(listSinkIDs[i], returnSink));
+        ASSERT_EQ("sink" + int2string(i), returnSink.name);
+        ASSERT_EQ(1u, std::count_if(listSinks.begin(), listSinks.end(), [&](const am_Sink_s &ref) {
+                return ref.sinkID == listSinkIDs[i];
+            }));
+    }
+}
+
+TEST_F(CAmMapHandlerTest, journalChangesAndSnapshot)
+{
+    am_Sink_s sink;
+    am_sinkID_t sinkID;
+    std::vector<am_JournalEntry_s> listChanges;
+    am_JournalSnapshot_s snapshot;
+    pCF.createSink(sink);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), newSink(_)).Times(1);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), volumeChanged(_, _)).Times(AM_JOURNAL_CAPACITY + 1);
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), removedSink(_, _)).Times(1);
+
+    uint32_t version = pDatabaseHandler.getJournalVersion();
+    ASSERT_EQ(E_OK, pDatabaseHandler.getJournalChanges(version, listChanges));
+    ASSERT_TRUE(listChanges.empty());
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink, sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(20, sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getJournalChanges(version, listChanges));
+    ASSERT_EQ(2u, listChanges.size());
+    ASSERT_EQ(version + 1, listChanges[0].version);
+    ASSERT_EQ(JE_SINK, listChanges[0].element);
+    ASSERT_EQ(JO_ADDED, listChanges[0].operation);
+    ASSERT_EQ(sinkID, listChanges[0].elementID);
+    ASSERT_EQ(JO_CHANGED, listChanges[1].operation);
+    ASSERT_EQ(pDatabaseHandler.getJournalVersion(), listChanges[1].version);
+
+    //a consumer that is too far behind has to take the snapshot
+    for (uint32_t i = 0; i < AM_JOURNAL_CAPACITY; i++)
+    {
+        ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkMainVolumeDB(i % 2 ? 20 : 21, sinkID));
+    }
+
+    ASSERT_EQ(E_NOT_POSSIBLE, pDatabaseHandler.getJournalChanges(version, listChanges));
+    ASSERT_EQ(E_NOT_POSSIBLE, pDatabaseHandler.getJournalChanges(pDatabaseHandler.getJournalVersion() + 1, listChanges));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getJournalSnapshot(snapshot));
+    ASSERT_EQ(pDatabaseHandler.getJournalVersion(), snapshot.version);
+    ASSERT_EQ(1u, snapshot.listMainSinks.size());
+    ASSERT_EQ(sinkID, snapshot.listMainSinks[0].sinkID);
+
+    //and resumes from the version of the snapshot
+    ASSERT_EQ(E_OK, pDatabaseHandler.getJournalChanges(snapshot.version - AM_JOURNAL_CAPACITY, listChanges));
+    ASSERT_EQ(static_cast<size_t>(AM_JOURNAL_CAPACITY), listChanges.size());
+    ASSERT_EQ(E_OK, pDatabaseHandler.removeSinkDB(sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getJournalChanges(snapshot.version, listChanges));
+    ASSERT_EQ(1u, listChanges.size());
+    ASSERT_EQ(JO_REMOVED, listChanges[0].operation);
+    ASSERT_EQ(sinkID, listChanges[0].elementID);
+}
+
 TEST_F(CAmMapHandlerTest,crossfaders)
 {
     am_Crossfader_s crossfader;
@@ -1320,6 +1505,69 @@ TEST_F(CAmMapHandlerTest, changeSinkSoundProperty)
     ASSERT_EQ(E_NON_EXISTENT, pDatabaseHandler.getSinkSoundPropertyValue(sinkID, 1000, value));
 }
 
+TEST_F(CAmMapHandlerTest, soundPropertyLookupUnsortedList)
+{
+    am_Sink_s sink;
+    am_sinkID_t sinkID;
+    pCF.createSink(sink);
+    sink.listSoundProperties.clear();
+    sink.listMainSoundProperties.clear();
+
+    //enter 32 properties in descending type order, the list order must be kept
+    for (int16_t i = 32; i > 0; i--)
+    {
+        sink.listSoundProperties.push_back({static_cast<am_CustomSoundPropertyType_t>(i * 3), static_cast<int16_t>(i)});
+        sink.listMainSoundProperties.push_back({static_cast<am_CustomMainSoundPropertyType_t>(i * 3), static_cast<int16_t>(-i)});
+    }
+
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), newSink(_)).Times(1);
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkDB(sink,sinkID));
+
+    int16_t value;
+    for (int16_t i = 1; i <= 32; i++)
+    {
+        ASSERT_EQ(E_OK, pDatabaseHandler.getSinkSoundPropertyValue(sinkID, i * 3, value));
+        ASSERT_EQ(i, value);
+        ASSERT_EQ(E_OK, pDatabaseHandler.getMainSinkSoundPropertyValue(sinkID, i * 3, value));
+        ASSERT_EQ(-i, value);
+        ASSERT_EQ(E_NON_EXISTENT, pDatabaseHandler.getSinkSoundPropertyValue(sinkID, i * 3 + 1, value));
+        ASSERT_EQ(E_NON_EXISTENT, pDatabaseHandler.getMainSinkSoundPropertyValue(sinkID, i * 3 + 1, value));
+    }
+
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkSoundPropertyDB({30, 100}, sinkID));
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), mainSinkSoundPropertyChanged(_, _)).Times(1);
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeMainSinkSoundPropertyDB({60, 200}, sinkID));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getSinkSoundPropertyValue(sinkID, 30, value));
+    ASSERT_EQ(100, value);
+    ASSERT_EQ(E_OK, pDatabaseHandler.getMainSinkSoundPropertyValue(sinkID, 60, value));
+    ASSERT_EQ(200, value);
+
+    std::vector<am_SoundProperty_s> listSoundProperties;
+    std::vector<am_MainSoundProperty_s> listMainSoundProperties;
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSinkSoundProperties(sinkID, listSoundProperties));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListMainSinkSoundProperties(sinkID, listMainSoundProperties));
+    ASSERT_EQ(32u, listSoundProperties.size());
+    ASSERT_EQ(32u, listMainSoundProperties.size());
+    for (uint16_t i = 0; i < 32; i++)
+    {
+        ASSERT_EQ((32 - i) * 3, listSoundProperties[i].type);
+        ASSERT_EQ((32 - i) * 3, listMainSoundProperties[i].type);
+    }
+
+    ASSERT_EQ(100, listSoundProperties[22].value);
+    ASSERT_EQ(200, listMainSoundProperties[12].value);
+
+    //replacing the list must replace the lookup as well
+    EXPECT_CALL(*MockDatabaseObserver::getMockObserverObject(), sinkUpdated(_, _, _, _)).Times(1);
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeSinkDB(sinkID, 0, {{7, 70}}, {}, {{8, 80}}));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getSinkSoundPropertyValue(sinkID, 7, value));
+    ASSERT_EQ(70, value);
+    ASSERT_EQ(E_OK, pDatabaseHandler.getMainSinkSoundPropertyValue(sinkID, 8, value));
+    ASSERT_EQ(80, value);
+    ASSERT_EQ(E_NON_EXISTENT, pDatabaseHandler.getSinkSoundPropertyValue(sinkID, 30, value));
+    ASSERT_EQ(E_NON_EXISTENT, pDatabaseHandler.getMainSinkSoundPropertyValue(sinkID, 60, value));
+}
+
 TEST_F(CAmMapHandlerTest, peekDomain)
 {
     std::vector<am_Domain_s> listDomains;
@@ -52,6 +52,14 @@ CAmDatabaseObserver::CAmDatabaseObserver()
 		{ MockDatabaseObserver::getMockObserverObject()->removedSink(sinkID, visible); };
 		dboRemovedSource = [&](const am_sourceID_t sourceID, const bool visible)
 		{ MockDatabaseObserver::getMockObserverObject()->removedSource(sourceID, visible); };
+		dboNewSinks = [&](const std::vector<am_Sink_s>& listSinks)
+		{ MockDatabaseObserver::getMockObserverObject()->newSinks(listSinks); };
+		dboNewSources = [&](const std::vector<am_Source_s>& listSources)
+		{ MockDatabaseObserver::getMockObserverObject()->newSources(listSources); };
+		dboRemovedSinks = [&](const std::vector<am_sinkID_t>& listSinkIDs, const std::vector<bool>& listVisible)
+		{ MockDatabaseObserver::getMockObserverObject()->removedSinks(listSinkIDs, listVisible); };
+		dboRemovedSources = [&](const std::vector<am_sourceID_t>& listSourceIDs, const std::vector<bool>& listVisible)
+		{ MockDatabaseObserver::getMockObserverObject()->removedSources(listSourceIDs, listVisible); };
 		dboRemoveDomain = [&](const am_domainID_t domainID)
 		{ MockDatabaseObserver::getMockObserverObject()->removeDomain(domainID); };
 		dboRemoveGateway = [&](const am_gatewayID_t gatewayID)
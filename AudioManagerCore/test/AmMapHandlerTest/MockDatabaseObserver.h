@@ -55,6 +55,10 @@ public:
     virtual void removedMainConnection(const am_mainConnectionID_t mainConnection) = 0;
     virtual void removedSink(const am_sinkID_t sinkID, const bool visible) = 0;
     virtual void removedSource(const am_sourceID_t sourceID, const bool visible) = 0;
+    virtual void newSinks(const std::vector<am_Sink_s>& listSinks) = 0;
+    virtual void newSources(const std::vector<am_Source_s>& listSources) = 0;
+    virtual void removedSinks(const std::vector<am_sinkID_t>& listSinkIDs, const std::vector<bool>& listVisible) = 0;
+    virtual void removedSources(const std::vector<am_sourceID_t>& listSourceIDs, const std::vector<bool>& listVisible) = 0;
     virtual void removeDomain(const am_domainID_t domainID) = 0;
     virtual void removeGateway(const am_gatewayID_t gatewayID) = 0;
     virtual void removeConverter(const am_converterID_t converterID) = 0;
@@ -92,6 +96,10 @@ class MockDatabaseObserver : public IAmDatabaseObserver{
 	MOCK_METHOD1(removedMainConnection, void(const am_mainConnectionID_t mainConnection));
 	MOCK_METHOD2(removedSink, void(const am_sinkID_t sinkID, const bool visible));
 	MOCK_METHOD2(removedSource, void(const am_sourceID_t sourceID, const bool visible));
+	MOCK_METHOD1(newSinks, void(const std::vector<am_Sink_s>& listSinks));
+	MOCK_METHOD1(newSources, void(const std::vector<am_Source_s>& listSources));
+	MOCK_METHOD2(removedSinks, void(const std::vector<am_sinkID_t>& listSinkIDs, const std::vector<bool>& listVisible));
+	MOCK_METHOD2(removedSources, void(const std::vector<am_sourceID_t>& listSourceIDs, const std::vector<bool>& listVisible));
 	MOCK_METHOD1(removeDomain, void(const am_domainID_t domainID));
 	MOCK_METHOD1(removeGateway, void(const am_gatewayID_t gatewayID));
 	MOCK_METHOD1(removeConverter, void(const am_converterID_t converterID));
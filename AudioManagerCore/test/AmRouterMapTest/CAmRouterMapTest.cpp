@@ -22,6 +22,7 @@
 
 #include <ctime>
 #include <chrono>
+#include <random>
 #include "CAmRouterMapTest.h"
 #include <string.h>
 #include "CAmLogWrapper.h"
@@ -227,6 +228,44 @@ TEST_F(CAmRouterMapTest,checkInsertedDomain)
     ASSERT_TRUE(CAmRouter::shouldGoInDomain(domains, 60, 0));
 }
 
+TEST_F(CAmRouterMapTest,domainTrackerMatchesShouldGoInDomain)
+{
+    // random walks of a search that enters and leaves nodes, the tracker has to agree with the scan of the domain list at every step
+    std::mt19937 random(4711);
+    std::uniform_int_distribution<int> nextDomain(0, 5);
+    std::uniform_int_distribution<int> nextStep(0, 99);
+    const unsigned listCycles[] = { 0, 1, 2, UINT_MAX };
+    CAmRoutingDomainTracker tracker;
+    for (unsigned walk = 0; walk < 50; walk++)
+    {
+        std::vector<am_domainID_t> domains(1, nextDomain(random));
+        tracker.reset(domains.front());
+        for (unsigned step = 0; step < 500; step++)
+        {
+            for (am_domainID_t domainID = 0; domainID <= 6; domainID++)
+            {
+                for (unsigned cycles : listCycles)
+                {
+                    ASSERT_EQ(CAmRouter::shouldGoInDomain(domains, domainID, cycles), tracker.shouldGoInDomain(domainID, cycles))
+                        << "walk " << walk << " step " << step << " domain " << domainID << " cycles " << cycles;
+                }
+            }
+
+            // the search never leaves the node it started from
+            if (domains.size() > 1 && nextStep(random) < 45)
+            {
+                domains.pop_back();
+                tracker.leave();
+            }
+            else
+            {
+                domains.push_back(nextDomain(random));
+                tracker.enter(domains.back());
+            }
+        }
+    }
+}
+
 //test that checks just sinks and source in a domain but connectionformats do not match
 TEST_F(CAmRouterMapTest,simpleRoute2withDomainNoMatchFormats)
 {
@@ -3763,6 +3802,734 @@ TEST_F(CAmRouterMapTest, routeTunerHeadphonePathThroughGWPlus2OtherSinks)
     ASSERT_TRUE(pCF.compareRoute(compareRoute3, listRoutes[0]) || pCF.compareRoute(compareRoute3, listRoutes[1]));
 }
 
+TEST_F(CAmRouterMapTest, routeCostModels)
+{
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).WillRepeatedly(DoAll(returnConnectionFormat(), Return(E_OK)));
+
+    am_SourceClass_s sourceclass;
+    sourceclass.name = "sClass";
+    sourceclass.sourceClassID = 5;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceClassDB(sourceclass.sourceClassID, sourceclass));
+
+    am_SinkClass_s sinkclass;
+    sinkclass.sinkClassID = 5;
+    sinkclass.name = "sname";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkClassDB(sinkclass, sinkclass.sinkClassID));
+
+    am_domainID_t domainID1, domainID2;
+    enterDomainDB("domain1", domainID1);
+    enterDomainDB("domain2", domainID2);
+
+    std::vector<am_CustomConnectionFormat_t> cfStereo;
+    cfStereo.push_back(CF_GENIVI_STEREO);
+    std::vector<bool> matrix;
+    matrix.push_back(true);
+
+    // two gateways of the same length from domain1 to domain2
+    am_sourceID_t sourceID, gwSourceID1, gwSourceID2;
+    am_sinkID_t sinkID, gwSinkID1, gwSinkID2;
+    am_gatewayID_t gatewayID1, gatewayID2;
+    enterSourceDB("source", domainID1, cfStereo, sourceID);
+    enterSinkDB("sink", domainID2, cfStereo, sinkID);
+    enterSinkDB("gwSink1", domainID1, cfStereo, gwSinkID1);
+    enterSourceDB("gwSource1", domainID2, cfStereo, gwSourceID1);
+    enterGatewayDB("gateway1", domainID2, domainID1, cfStereo, cfStereo, matrix, gwSourceID1, gwSinkID1, gatewayID1);
+    enterSinkDB("gwSink2", domainID1, cfStereo, gwSinkID2);
+    enterSourceDB("gwSource2", domainID2, cfStereo, gwSourceID2);
+    enterGatewayDB("gateway2", domainID2, domainID1, cfStereo, cfStereo, matrix, gwSourceID2, gwSinkID2, gatewayID2);
+
+    // the connection to the first gateway is slower than the one to the second gateway
+    am_Connection_s connection;
+    am_connectionID_t connectionID1, connectionID2;
+    connection.connectionID = 0;
+    connection.sourceID = sourceID;
+    connection.sinkID = gwSinkID1;
+    connection.connectionFormat = CF_GENIVI_STEREO;
+    connection.delay = -1;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterConnectionDB(connection, connectionID1));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeConnectionFinal(connectionID1));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeConnectionTimingInformation(connectionID1, 50));
+    connection.sinkID = gwSinkID2;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterConnectionDB(connection, connectionID2));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeConnectionFinal(connectionID2));
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeConnectionTimingInformation(connectionID2, 5));
+
+    am_Route_s routeGateway1;
+    routeGateway1.sinkID = sinkID;
+    routeGateway1.sourceID = sourceID;
+    routeGateway1.route.push_back({ sourceID, gwSinkID1, domainID1, CF_GENIVI_STEREO });
+    routeGateway1.route.push_back({ gwSourceID1, sinkID, domainID2, CF_GENIVI_STEREO });
+    am_Route_s routeGateway2;
+    routeGateway2.sinkID = sinkID;
+    routeGateway2.sourceID = sourceID;
+    routeGateway2.route.push_back({ sourceID, gwSinkID2, domainID1, CF_GENIVI_STEREO });
+    routeGateway2.route.push_back({ gwSourceID2, sinkID, domainID2, CF_GENIVI_STEREO });
+
+    // hops: both routes have the same cost
+    std::vector<am_Route_s> listRoutes;
+    ASSERT_EQ(RCM_HOPS, pRouter.getCostModel());
+    ASSERT_EQ(E_OK, getRoute(false, true, sourceID, sinkID, listRoutes));
+    ASSERT_EQ(static_cast<uint>(2), listRoutes.size());
+    ASSERT_TRUE(pCF.compareRoute(routeGateway1, listRoutes[0]) || pCF.compareRoute(routeGateway1, listRoutes[1]));
+    ASSERT_TRUE(pCF.compareRoute(routeGateway2, listRoutes[0]) || pCF.compareRoute(routeGateway2, listRoutes[1]));
+
+    // delay: the faster connection to the second gateway wins
+    ASSERT_EQ(E_OK, pRouter.setCostModel(RCM_DELAY));
+    ASSERT_TRUE(pRouter.getUpdateGraphNodesAction());
+    ASSERT_EQ(E_OK, getRoute(false, false, sourceID, sinkID, listRoutes));
+    ASSERT_EQ(static_cast<uint>(2), listRoutes.size());
+    ASSERT_TRUE(pCF.compareRoute(routeGateway2, listRoutes[0]));
+    ASSERT_TRUE(pCF.compareRoute(routeGateway1, listRoutes[1]));
+
+    std::vector<am_Route_s> listShortest;
+    CAmRoutingNode *sourceNode = pRouter.sourceNodeWithID(sourceID);
+    CAmRoutingNode *sinkNode = pRouter.sinkNodeWithID(sinkID);
+    ASSERT_TRUE(sourceNode && sinkNode);
+    ASSERT_EQ(E_OK, pRouter.getShortestPath(*sourceNode, *sinkNode, listShortest));
+    ASSERT_EQ(static_cast<uint>(1), listShortest.size());
+    ASSERT_TRUE(pCF.compareRoute(routeGateway2, listShortest[0]));
+
+    // unknown delay: the unmeasured connection to the second gateway only wins while unmeasured edges are assumed fast
+    ASSERT_EQ(E_OK, pDatabaseHandler.changeConnectionTimingInformation(connectionID2, -1));
+    ASSERT_EQ(E_OK, getRoute(false, false, sourceID, sinkID, listRoutes));
+    ASSERT_EQ(static_cast<uint>(2), listRoutes.size());
+    ASSERT_TRUE(pCF.compareRoute(routeGateway2, listRoutes[0]));
+
+    ASSERT_EQ(0, pRouter.getUnknownDelay());
+    ASSERT_EQ(E_OUT_OF_RANGE, pRouter.setUnknownDelay(-1));
+    ASSERT_EQ(E_OK, pRouter.setUnknownDelay(100));
+    ASSERT_TRUE(pRouter.getUpdateGraphNodesAction());
+    ASSERT_EQ(E_OK, getRoute(false, false, sourceID, sinkID, listRoutes));
+    ASSERT_EQ(static_cast<uint>(2), listRoutes.size());
+    ASSERT_TRUE(pCF.compareRoute(routeGateway1, listRoutes[0]));
+    ASSERT_TRUE(pCF.compareRoute(routeGateway2, listRoutes[1]));
+    ASSERT_EQ(E_OK, pRouter.setUnknownDelay(0));
+
+    // custom: the controller rates the conversion in the second gateway as expensive
+    ASSERT_EQ(E_NOT_POSSIBLE, pRouter.setCostModel(RCM_CUSTOM));
+    ASSERT_EQ(E_OK, pRouter.setCostModel(RCM_CUSTOM, [gatewayID2](const am_RoutingNodeData_s &, const am_RoutingNodeData_s &to, const am_timeSync_t delay) -> uint16_t {
+        if (to.type == am_RoutingNodeData_s::GATEWAY && to.data.gateway->gatewayID == gatewayID2)
+        {
+            return 100;
+        }
+        return (delay > 0) ? 1 + delay : 1;
+    }));
+    ASSERT_EQ(E_OK, getRoute(false, false, sourceID, sinkID, listRoutes));
+    ASSERT_EQ(static_cast<uint>(2), listRoutes.size());
+    ASSERT_TRUE(pCF.compareRoute(routeGateway1, listRoutes[0]));
+    ASSERT_TRUE(pCF.compareRoute(routeGateway2, listRoutes[1]));
+
+    ASSERT_EQ(E_OK, pRouter.setCostModel(RCM_HOPS));
+}
+
+TEST_F(CAmRouterMapTest, routeCFPermutationsStopAtMaxPathCount)
+{
+    // 7 domains in a chain, connected by 6 gateways which convert between 4 formats in any direction.
+    // There are 4^7 permutations of the formats, only the first ones in the order of priority are generated.
+    const unsigned gateways = 6;
+    std::vector<am_CustomConnectionFormat_t> formats;
+    formats.push_back(CF_GENIVI_STEREO);
+    formats.push_back(CF_GENIVI_MONO);
+    formats.push_back(CF_GENIVI_AUTO);
+    formats.push_back(CF_GENIVI_ANALOG);
+    std::sort(formats.begin(), formats.end());
+    std::vector<bool> matrix(formats.size() * formats.size(), true);
+
+    // the first route needs one call per routing element, the following ones one more for the previous element
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).Times(gateways + 2).WillRepeatedly(DoAll(returnConnectionFormat(), Return(E_OK)));
+
+    am_SourceClass_s sourceclass;
+    sourceclass.name = "sClass";
+    sourceclass.sourceClassID = 5;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceClassDB(sourceclass.sourceClassID, sourceclass));
+
+    am_SinkClass_s sinkclass;
+    sinkclass.sinkClassID = 5;
+    sinkclass.name = "sname";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkClassDB(sinkclass, sinkclass.sinkClassID));
+
+    std::vector<am_domainID_t> domainIDs(gateways + 1);
+    for (unsigned i = 0; i <= gateways; i++)
+    {
+        enterDomainDB("domain" + std::to_string(i), domainIDs[i]);
+    }
+
+    am_sourceID_t sourceID;
+    enterSourceDB("source", domainIDs[0], formats, sourceID);
+
+    am_Route_s compareRoute;
+    compareRoute.sourceID = sourceID;
+    am_sourceID_t elementSourceID = sourceID;
+    for (unsigned i = 0; i < gateways; i++)
+    {
+        am_sinkID_t gwSinkID;
+        am_sourceID_t gwSourceID;
+        am_gatewayID_t gatewayID;
+        enterSinkDB("gwSink" + std::to_string(i), domainIDs[i], formats, gwSinkID);
+        enterSourceDB("gwSource" + std::to_string(i), domainIDs[i + 1], formats, gwSourceID);
+        enterGatewayDB("gateway" + std::to_string(i), domainIDs[i + 1], domainIDs[i], formats, formats, matrix, gwSourceID, gwSinkID, gatewayID);
+        compareRoute.route.push_back({ elementSourceID, gwSinkID, domainIDs[i], formats[0] });
+        elementSourceID = gwSourceID;
+    }
+
+    am_sinkID_t sinkID;
+    enterSinkDB("sink", domainIDs[gateways], formats, sinkID);
+    compareRoute.sinkID = sinkID;
+    compareRoute.route.push_back({ elementSourceID, sinkID, domainIDs[gateways], formats[0] });
+
+    std::vector<am_Route_s> listRoutes;
+    ASSERT_EQ(E_OK, getRoute(false, true, sourceID, sinkID, listRoutes));
+    ASSERT_EQ(static_cast<uint>(MAX_ROUTING_PATHS), listRoutes.size());
+
+    // depth first in the order of priority: the last element changes first
+    for (unsigned i = 0; i < listRoutes.size(); i++)
+    {
+        compareRoute.route[gateways].connectionFormat = formats[i % formats.size()];
+        compareRoute.route[gateways - 1].connectionFormat = formats[i / formats.size()];
+        ASSERT_TRUE(pCF.compareRoute(compareRoute, listRoutes[i]));
+    }
+}
+
+TEST_F(CAmRouterMapTest, routeConnectionFormatChoiceCache)
+{
+    // 3 calls without the cache, then 2 misses, 0 misses and after the invalidation 2 misses again
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).Times(7).WillRepeatedly(DoAll(returnConnectionFormat(), Return(E_OK)));
+
+    am_SourceClass_s sourceclass;
+    sourceclass.name = "sClass";
+    sourceclass.sourceClassID = 5;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceClassDB(sourceclass.sourceClassID, sourceclass));
+
+    am_SinkClass_s sinkclass;
+    sinkclass.sinkClassID = 5;
+    sinkclass.name = "sname";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkClassDB(sinkclass, sinkclass.sinkClassID));
+
+    am_domainID_t domainID1, domainID2;
+    enterDomainDB("domain1", domainID1);
+    enterDomainDB("domain2", domainID2);
+
+    std::vector<am_CustomConnectionFormat_t> formats;
+    formats.push_back(CF_GENIVI_STEREO);
+    formats.push_back(CF_GENIVI_MONO);
+    std::vector<bool> matrix(formats.size() * formats.size(), true);
+
+    // both formats of the first element lead to the same choice for the second element
+    am_sourceID_t sourceID, gwSourceID;
+    am_sinkID_t sinkID, gwSinkID;
+    am_gatewayID_t gatewayID;
+    enterSourceDB("source", domainID1, formats, sourceID);
+    enterSinkDB("gwSink", domainID1, formats, gwSinkID);
+    enterSourceDB("gwSource", domainID2, formats, gwSourceID);
+    enterGatewayDB("gateway", domainID2, domainID1, formats, formats, matrix, gwSourceID, gwSinkID, gatewayID);
+    enterSinkDB("sink", domainID2, formats, sinkID);
+
+    std::vector<am_Route_s> listRoutes, listCachedRoutes;
+    unsigned hits, misses;
+    ASSERT_FALSE(pRouter.getConnectionFormatChoiceCaching());
+    ASSERT_EQ(E_OK, getRoute(false, false, sourceID, sinkID, listRoutes));
+    ASSERT_EQ(static_cast<uint>(4), listRoutes.size());
+
+    pControlReceiver.setConnectionFormatChoiceCaching(true);
+    ASSERT_TRUE(pRouter.getConnectionFormatChoiceCaching());
+    ASSERT_EQ(E_OK, getRoute(false, false, sourceID, sinkID, listCachedRoutes));
+    pRouter.getConnectionFormatChoiceStatistics(hits, misses);
+    ASSERT_EQ(1u, hits);
+    ASSERT_EQ(2u, misses);
+    ASSERT_EQ(listRoutes.size(), listCachedRoutes.size());
+    for (unsigned i = 0; i < listRoutes.size(); i++)
+    {
+        ASSERT_TRUE(pCF.compareRoute(listRoutes[i], listCachedRoutes[i]));
+    }
+
+    ASSERT_EQ(E_OK, getRoute(false, false, sourceID, sinkID, listCachedRoutes));
+    ASSERT_EQ(listRoutes.size(), listCachedRoutes.size());
+    pRouter.getConnectionFormatChoiceStatistics(hits, misses);
+    ASSERT_EQ(4u, hits);
+    ASSERT_EQ(2u, misses);
+
+    pControlReceiver.invalidateConnectionFormatChoices();
+    ASSERT_EQ(E_OK, getRoute(false, false, sourceID, sinkID, listCachedRoutes));
+    ASSERT_EQ(listRoutes.size(), listCachedRoutes.size());
+    pRouter.getConnectionFormatChoiceStatistics(hits, misses);
+    ASSERT_EQ(5u, hits);
+    ASSERT_EQ(4u, misses);
+
+    pControlReceiver.setConnectionFormatChoiceCaching(false);
+}
+
+TEST_F(CAmRouterMapTest, routeDomainReachability)
+{
+    // impossible routes are answered without asking the controller
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).Times(0);
+
+    am_SourceClass_s sourceclass;
+    sourceclass.name = "sClass";
+    sourceclass.sourceClassID = 5;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceClassDB(sourceclass.sourceClassID, sourceclass));
+
+    am_SinkClass_s sinkclass;
+    sinkclass.sinkClassID = 5;
+    sinkclass.name = "sname";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkClassDB(sinkclass, sinkclass.sinkClassID));
+
+    am_domainID_t domainID1, domainID2, domainID3;
+    enterDomainDB("domain1", domainID1);
+    enterDomainDB("domain2", domainID2);
+    enterDomainDB("domain3", domainID3);
+
+    std::vector<am_CustomConnectionFormat_t> formats;
+    formats.push_back(CF_GENIVI_STEREO);
+    std::vector<bool> matrix(1, true);
+    std::vector<bool> blockedMatrix(1, false);
+
+    // domain1 -> domain2 over gateway1, the way back over gateway2 is blocked by its matrix, domain3 is isolated
+    am_sourceID_t source1ID, source2ID, source3ID, gw1SourceID, gw2SourceID;
+    am_sinkID_t sink1ID, sink3ID, gw1SinkID, gw2SinkID;
+    am_gatewayID_t gateway1ID, gateway2ID;
+    enterSourceDB("source1", domainID1, formats, source1ID);
+    enterSinkDB("sink1", domainID1, formats, sink1ID);
+    enterSinkDB("gw1Sink", domainID1, formats, gw1SinkID);
+    enterSourceDB("gw1Source", domainID2, formats, gw1SourceID);
+    enterGatewayDB("gateway1", domainID2, domainID1, formats, formats, matrix, gw1SourceID, gw1SinkID, gateway1ID);
+    enterSourceDB("source2", domainID2, formats, source2ID);
+    enterSinkDB("gw2Sink", domainID2, formats, gw2SinkID);
+    enterSourceDB("gw2Source", domainID1, formats, gw2SourceID);
+    enterGatewayDB("gateway2", domainID1, domainID2, formats, formats, blockedMatrix, gw2SourceID, gw2SinkID, gateway2ID);
+    enterSourceDB("source3", domainID3, formats, source3ID);
+    enterSinkDB("sink3", domainID3, formats, sink3ID);
+
+    pRouter.load();
+    ASSERT_TRUE(pRouter.isDomainReachable(domainID1, domainID1));
+    ASSERT_TRUE(pRouter.isDomainReachable(domainID1, domainID2));
+    ASSERT_FALSE(pRouter.isDomainReachable(domainID2, domainID1));
+    ASSERT_FALSE(pRouter.isDomainReachable(domainID1, domainID3));
+    ASSERT_FALSE(pRouter.isDomainReachable(domainID3, domainID2));
+    ASSERT_TRUE(pRouter.isDomainReachable(domainID3, domainID3));
+    // unknown domains are never excluded
+    ASSERT_TRUE(pRouter.isDomainReachable(domainID1, 100));
+
+    std::vector<am_Route_s> listRoutes;
+    ASSERT_EQ(E_NOT_POSSIBLE, getRoute(false, false, source2ID, sink1ID, listRoutes));
+    ASSERT_TRUE(listRoutes.empty());
+    ASSERT_EQ(E_NOT_POSSIBLE, getRoute(false, false, source1ID, sink3ID, listRoutes));
+    ASSERT_TRUE(listRoutes.empty());
+}
+
+TEST_F(CAmRouterMapTest, routeToAllSinksAndFromAllSources)
+{
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).WillRepeatedly(DoAll(returnConnectionFormat(), Return(E_OK)));
+
+    am_SourceClass_s sourceclass;
+    sourceclass.name = "sClass";
+    sourceclass.sourceClassID = 5;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceClassDB(sourceclass.sourceClassID, sourceclass));
+
+    am_SinkClass_s sinkclass;
+    sinkclass.sinkClassID = 5;
+    sinkclass.name = "sname";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkClassDB(sinkclass, sinkclass.sinkClassID));
+
+    am_domainID_t domainID1, domainID2, domainID3;
+    enterDomainDB("domain1", domainID1);
+    enterDomainDB("domain2", domainID2);
+    enterDomainDB("domain3", domainID3);
+
+    std::vector<am_CustomConnectionFormat_t> formats;
+    formats.push_back(CF_GENIVI_STEREO);
+    formats.push_back(CF_GENIVI_MONO);
+    std::vector<am_CustomConnectionFormat_t> stereo(1, CF_GENIVI_STEREO);
+    std::vector<bool> matrix(formats.size() * formats.size(), true);
+
+    // a ring of domains with a shortcut back from domain2 to domain1
+    am_sourceID_t source1ID, source2ID, source3ID, gwSourceID;
+    am_sinkID_t sink1ID, sink2ID, sink3ID, sink4ID, gwSinkID;
+    am_gatewayID_t gatewayID;
+    enterSourceDB("source1", domainID1, formats, source1ID);
+    enterSourceDB("source2", domainID1, stereo, source2ID);
+    enterSinkDB("sink1", domainID1, formats, sink1ID);
+    enterSourceDB("source3", domainID2, formats, source3ID);
+    enterSinkDB("sink2", domainID2, stereo, sink2ID);
+    enterSinkDB("sink3", domainID3, formats, sink3ID);
+    enterSinkDB("sink4", domainID3, stereo, sink4ID);
+    enterSinkDB("gw12Sink", domainID1, formats, gwSinkID);
+    enterSourceDB("gw12Source", domainID2, formats, gwSourceID);
+    enterGatewayDB("gw12", domainID2, domainID1, formats, formats, matrix, gwSourceID, gwSinkID, gatewayID);
+    enterSinkDB("gw23Sink", domainID2, formats, gwSinkID);
+    enterSourceDB("gw23Source", domainID3, formats, gwSourceID);
+    enterGatewayDB("gw23", domainID3, domainID2, formats, formats, matrix, gwSourceID, gwSinkID, gatewayID);
+    enterSinkDB("gw31Sink", domainID3, formats, gwSinkID);
+    enterSourceDB("gw31Source", domainID1, formats, gwSourceID);
+    enterGatewayDB("gw31", domainID1, domainID3, formats, formats, matrix, gwSourceID, gwSinkID, gatewayID);
+    enterSinkDB("gw21Sink", domainID2, stereo, gwSinkID);
+    enterSourceDB("gw21Source", domainID1, stereo, gwSourceID);
+    enterGatewayDB("gw21", domainID1, domainID2, stereo, stereo, std::vector<bool>(1, true), gwSourceID, gwSinkID, gatewayID);
+
+    std::vector<am_Sink_s> listSinks;
+    std::vector<am_Source_s> listSources;
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSinks(listSinks));
+    ASSERT_EQ(E_OK, pDatabaseHandler.getListSources(listSources));
+    std::vector<am_sinkID_t> listSinkIDs;
+    std::vector<am_sourceID_t> listSourceIDs;
+    for (auto it = listSinks.begin(); it != listSinks.end(); it++)
+    {
+        listSinkIDs.push_back(it->sinkID);
+    }
+    for (auto it = listSources.begin(); it != listSources.end(); it++)
+    {
+        listSourceIDs.push_back(it->sourceID);
+    }
+
+    // with one cycle allowed routes into other domains can lead through the domain of the end point
+    pRouter.setMaxAllowedCycles(1);
+    pRouter.setMaxPathCount(100);
+    std::vector<am_Route_s> listRoutes, listPairRoutes, listExpectedRoutes;
+    ASSERT_EQ(E_OK, pRouter.getRoutesToAllSinks(false, source1ID, CAmRoutingSinkFilter(), listRoutes));
+    std::sort(listSinkIDs.begin(), listSinkIDs.end());
+    for (auto it = listSinkIDs.begin(); it != listSinkIDs.end(); it++)
+    {
+        pRouter.getRoute(false, source1ID, *it, listPairRoutes);
+        listExpectedRoutes.insert(listExpectedRoutes.end(), listPairRoutes.begin(), listPairRoutes.end());
+    }
+
+    ASSERT_EQ(listExpectedRoutes.size(), listRoutes.size());
+    for (unsigned i = 0; i < listRoutes.size(); i++)
+    {
+        ASSERT_TRUE(pCF.compareRoute(listExpectedRoutes[i], listRoutes[i]));
+    }
+
+    // the backward search finds the same routes, routes of the same length may be in a different order
+    ASSERT_EQ(E_OK, pRouter.getRoutesFromAllSources(false, sink3ID, CAmRoutingSourceFilter(), listRoutes));
+    listExpectedRoutes.clear();
+    for (auto it = listSourceIDs.begin(); it != listSourceIDs.end(); it++)
+    {
+        pRouter.getRoute(false, *it, sink3ID, listPairRoutes);
+        listExpectedRoutes.insert(listExpectedRoutes.end(), listPairRoutes.begin(), listPairRoutes.end());
+    }
+
+    ASSERT_EQ(listExpectedRoutes.size(), listRoutes.size());
+    for (auto it = listExpectedRoutes.begin(); it != listExpectedRoutes.end(); it++)
+    {
+        ASSERT_TRUE(std::any_of(listRoutes.begin(), listRoutes.end(), [&](const am_Route_s &route){
+            return it->route.size() == route.route.size() && pCF.compareRoute(*it, route);
+        }));
+    }
+
+    // the filters of the control interface
+    std::vector<am_sinkID_t> listFilteredSinkIDs;
+    listFilteredSinkIDs.push_back(sink4ID);
+    listFilteredSinkIDs.push_back(sink2ID);
+    ASSERT_EQ(E_OK, pControlReceiver.getRoutesToAllSinks(false, source2ID, listFilteredSinkIDs, listRoutes));
+    ASSERT_FALSE(listRoutes.empty());
+    for (auto it = listRoutes.begin(); it != listRoutes.end(); it++)
+    {
+        ASSERT_TRUE(it->sinkID == sink2ID || it->sinkID == sink4ID);
+        ASSERT_EQ(source2ID, it->sourceID);
+    }
+    ASSERT_EQ(sink2ID, listRoutes.front().sinkID);
+    ASSERT_EQ(sink4ID, listRoutes.back().sinkID);
+
+    std::vector<am_sourceID_t> listFilteredSourceIDs(1, source3ID);
+    ASSERT_EQ(E_OK, pControlReceiver.getRoutesFromAllSources(false, sink1ID, listFilteredSourceIDs, listRoutes));
+    pRouter.getRoute(false, source3ID, sink1ID, listPairRoutes);
+    ASSERT_EQ(listPairRoutes.size(), listRoutes.size());
+
+    ASSERT_EQ(E_NON_EXISTENT, pRouter.getRoutesToAllSinks(false, 1000, CAmRoutingSinkFilter(), listRoutes));
+    ASSERT_EQ(E_NON_EXISTENT, pRouter.getRoutesFromAllSources(false, 1000, CAmRoutingSourceFilter(), listRoutes));
+}
+
+TEST_F(CAmRouterMapTest, routeBatchOnWorkerThreads)
+{
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).WillRepeatedly(DoAll(returnConnectionFormat(), Return(E_OK)));
+
+    am_SourceClass_s sourceclass;
+    sourceclass.name = "sClass";
+    sourceclass.sourceClassID = 5;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceClassDB(sourceclass.sourceClassID, sourceclass));
+
+    am_SinkClass_s sinkclass;
+    sinkclass.sinkClassID = 5;
+    sinkclass.name = "sname";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkClassDB(sinkclass, sinkclass.sinkClassID));
+
+    am_domainID_t domainID1, domainID2, domainID3;
+    enterDomainDB("domain1", domainID1);
+    enterDomainDB("domain2", domainID2);
+    enterDomainDB("domain3", domainID3);
+
+    std::vector<am_CustomConnectionFormat_t> formats;
+    formats.push_back(CF_GENIVI_STEREO);
+    formats.push_back(CF_GENIVI_MONO);
+    std::vector<bool> matrix(formats.size() * formats.size(), true);
+
+    // domain1 and domain2 are connected in both directions, domain3 is isolated
+    am_sourceID_t source1ID, source2ID, source3ID, gwSourceID;
+    am_sinkID_t sink1ID, sink2ID, sink3ID, gwSinkID;
+    am_gatewayID_t gatewayID;
+    enterSourceDB("source1", domainID1, formats, source1ID);
+    enterSinkDB("sink1", domainID1, formats, sink1ID);
+    enterSourceDB("source2", domainID2, formats, source2ID);
+    enterSinkDB("sink2", domainID2, formats, sink2ID);
+    enterSourceDB("source3", domainID3, formats, source3ID);
+    enterSinkDB("sink3", domainID3, formats, sink3ID);
+    for (unsigned i = 0; i < 2; i++)
+    {
+        enterSinkDB("gw12Sink" + std::to_string(i), domainID1, formats, gwSinkID);
+        enterSourceDB("gw12Source" + std::to_string(i), domainID2, formats, gwSourceID);
+        enterGatewayDB("gw12" + std::to_string(i), domainID2, domainID1, formats, formats, matrix, gwSourceID, gwSinkID, gatewayID);
+        enterSinkDB("gw21Sink" + std::to_string(i), domainID2, formats, gwSinkID);
+        enterSourceDB("gw21Source" + std::to_string(i), domainID1, formats, gwSourceID);
+        enterGatewayDB("gw21" + std::to_string(i), domainID1, domainID2, formats, formats, matrix, gwSourceID, gwSinkID, gatewayID);
+    }
+
+    std::vector<std::pair<am_sourceID_t, am_sinkID_t> > listPairs;
+    listPairs.push_back(std::make_pair(source1ID, sink2ID));
+    listPairs.push_back(std::make_pair(source2ID, sink1ID));
+    listPairs.push_back(std::make_pair(source1ID, sink1ID));
+    listPairs.push_back(std::make_pair(source2ID, sink2ID));
+    listPairs.push_back(std::make_pair(source3ID, sink3ID));
+
+    pRouter.setMaxAllowedCycles(1);
+    pRouter.setMaxPathCount(MAX_ROUTING_PATHS);
+    pRouter.setRoutingThreads(4);
+    std::vector<std::vector<am_Route_s> > listRoutes;
+    std::vector<am_Route_s> listPairRoutes;
+    ASSERT_EQ(E_OK, pControlReceiver.getRoutes(false, listPairs, listRoutes));
+    ASSERT_EQ(listPairs.size(), listRoutes.size());
+    for (unsigned i = 0; i < listPairs.size(); i++)
+    {
+        ASSERT_EQ(E_OK, pRouter.getRoute(false, listPairs[i].first, listPairs[i].second, listPairRoutes));
+        ASSERT_EQ(listPairRoutes.size(), listRoutes[i].size());
+        for (unsigned j = 0; j < listPairRoutes.size(); j++)
+        {
+            ASSERT_TRUE(pCF.compareRoute(listPairRoutes[j], listRoutes[i][j]));
+        }
+    }
+
+    // the workers are kept between the calls and replaced if the number of threads changes
+    std::vector<std::vector<am_Route_s> > listRoutesAgain;
+    for (unsigned threads = 4; threads > 0; threads--)
+    {
+        pRouter.setRoutingThreads(threads);
+        ASSERT_EQ(threads, pRouter.getRoutingThreads());
+        ASSERT_EQ(E_OK, pRouter.getRoutes(false, listPairs, listRoutesAgain));
+        ASSERT_EQ(listRoutes.size(), listRoutesAgain.size());
+        for (unsigned i = 0; i < listRoutes.size(); i++)
+        {
+            ASSERT_EQ(listRoutes[i].size(), listRoutesAgain[i].size());
+            for (unsigned j = 0; j < listRoutes[i].size(); j++)
+            {
+                ASSERT_TRUE(pCF.compareRoute(listRoutes[i][j], listRoutesAgain[i][j]));
+            }
+        }
+    }
+
+    // the other pairs are computed even if one of them fails
+    pRouter.setRoutingThreads(4);
+    listPairs.push_back(std::make_pair(source1ID, sink3ID));
+    ASSERT_EQ(E_NOT_POSSIBLE, pRouter.getRoutes(false, listPairs, listRoutes));
+    ASSERT_TRUE(listRoutes.back().empty());
+    ASSERT_FALSE(listRoutes.front().empty());
+    listPairs.push_back(std::make_pair(source1ID, 1000));
+    ASSERT_EQ(E_NON_EXISTENT, pRouter.getRoutes(false, listPairs, listRoutes));
+    ASSERT_EQ(listPairs.size(), listRoutes.size());
+    ASSERT_FALSE(listRoutes.front().empty());
+
+    pRouter.setRoutingThreads(0);
+}
+
+TEST_F(CAmRouterMapTest, routeTrace)
+{
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).WillRepeatedly(DoAll(returnConnectionFormat(), Return(E_OK)));
+
+    am_SourceClass_s sourceclass;
+    sourceclass.name = "sClass";
+    sourceclass.sourceClassID = 5;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSourceClassDB(sourceclass.sourceClassID, sourceclass));
+
+    am_SinkClass_s sinkclass;
+    sinkclass.sinkClassID = 5;
+    sinkclass.name = "sname";
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterSinkClassDB(sinkclass, sinkclass.sinkClassID));
+
+    am_domainID_t domainID1, domainID2, domainID3;
+    enterDomainDB("domain1", domainID1);
+    enterDomainDB("domain2", domainID2);
+    enterDomainDB("domain3", domainID3);
+
+    std::vector<am_CustomConnectionFormat_t> formats;
+    formats.push_back(CF_GENIVI_STEREO);
+    formats.push_back(CF_GENIVI_MONO);
+    std::vector<bool> matrix(formats.size() * formats.size(), true);
+
+    // domain1 and domain2 are connected in both directions, domain3 is isolated
+    am_sourceID_t source1ID, source3ID, gw12SourceID, gw21SourceID;
+    am_sinkID_t sink2ID, sink3ID, gw12SinkID, gw21SinkID;
+    am_gatewayID_t gatewayID;
+    enterSourceDB("source1", domainID1, formats, source1ID);
+    enterSinkDB("sink2", domainID2, formats, sink2ID);
+    enterSourceDB("source3", domainID3, formats, source3ID);
+    enterSinkDB("sink3", domainID3, formats, sink3ID);
+    enterSinkDB("gw12Sink", domainID1, formats, gw12SinkID);
+    enterSourceDB("gw12Source", domainID2, formats, gw12SourceID);
+    enterGatewayDB("gw12", domainID2, domainID1, formats, formats, matrix, gw12SourceID, gw12SinkID, gatewayID);
+    enterSinkDB("gw21Sink", domainID2, formats, gw21SinkID);
+    enterSourceDB("gw21Source", domainID1, formats, gw21SourceID);
+    enterGatewayDB("gw21", domainID1, domainID2, formats, formats, matrix, gw21SourceID, gw21SinkID, gatewayID);
+
+    pRouter.setMaxAllowedCycles(0);
+    pRouter.setMaxPathCount(MAX_ROUTING_PATHS);
+
+    // the traced search returns the same routes and reports the paths they come from
+    std::vector<am_Route_s> listRoutes, listTracedRoutes;
+    am_RouteTrace_s trace;
+    ASSERT_EQ(E_OK, pRouter.getRoute(false, source1ID, sink2ID, listRoutes));
+    ASSERT_EQ(E_OK, pRouter.getRoute(false, source1ID, sink2ID, listTracedRoutes, trace));
+    ASSERT_EQ(listRoutes.size(), listTracedRoutes.size());
+    for (unsigned i = 0; i < listRoutes.size(); i++)
+    {
+        ASSERT_TRUE(pCF.compareRoute(listRoutes[i], listTracedRoutes[i]));
+    }
+
+    ASSERT_EQ(E_OK, trace.error);
+    ASSERT_FALSE(trace.unreachable);
+    ASSERT_EQ(1u, trace.searches);
+    ASSERT_EQ(1u, trace.listPaths.size());
+    ASSERT_TRUE(trace.listPaths[0].evaluated);
+    ASSERT_EQ(listRoutes.size(), trace.listPaths[0].permutations);
+    ASSERT_EQ(2u, trace.listPaths[0].route.route.size());
+    ASSERT_GT(trace.nodesExplored, 0u);
+    ASSERT_GE(trace.edgesExplored, trace.nodesExplored);
+    // the way back from domain2 into domain1 is cut off
+    ASSERT_GT(trace.pruned[RPR_DOMAIN_CYCLE], 0u);
+    ASSERT_EQ(0u, trace.pruned[RPR_BUSY]);
+    ASSERT_EQ(0u, trace.pruned[RPR_FORMAT_MISMATCH]);
+    ASSERT_GT(trace.connectionFormatChoices, 0u);
+    ASSERT_EQ(0u, trace.cachedConnectionFormatChoices);
+
+    // tracing every getRoute doesn't change the routes either
+    ASSERT_FALSE(pRouter.getTraceRoutes());
+    pRouter.setTraceRoutes(true);
+    ASSERT_TRUE(pRouter.getTraceRoutes());
+    ASSERT_EQ(E_OK, pRouter.getRoute(false, source1ID, sink2ID, listTracedRoutes));
+    pRouter.setTraceRoutes(false);
+    ASSERT_EQ(listRoutes.size(), listTracedRoutes.size());
+    for (unsigned i = 0; i < listRoutes.size(); i++)
+    {
+        ASSERT_TRUE(pCF.compareRoute(listRoutes[i], listTracedRoutes[i]));
+    }
+
+    // with the cache the second search doesn't ask the controller
+    pRouter.setConnectionFormatChoiceCaching(true);
+    ASSERT_EQ(E_OK, pRouter.getRoute(false, source1ID, sink2ID, listTracedRoutes, trace));
+    ASSERT_GT(trace.connectionFormatChoices, 0u);
+    ASSERT_EQ(E_OK, pRouter.getRoute(false, source1ID, sink2ID, listTracedRoutes, trace));
+    ASSERT_EQ(0u, trace.connectionFormatChoices);
+    ASSERT_GT(trace.cachedConnectionFormatChoices, 0u);
+    pRouter.setConnectionFormatChoiceCaching(false);
+
+    // nothing is searched between domains without a gateway path
+    ASSERT_EQ(E_NOT_POSSIBLE, pRouter.getRoute(false, source1ID, sink3ID, listTracedRoutes, trace));
+    ASSERT_TRUE(trace.unreachable);
+    ASSERT_EQ(0u, trace.searches);
+    ASSERT_TRUE(trace.listPaths.empty());
+
+    // the controller accepts no format, the path is found but dropped
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).WillRepeatedly(Return(E_OK));
+    ASSERT_EQ(E_NOT_POSSIBLE, pRouter.getRoute(false, source1ID, sink2ID, listTracedRoutes, trace));
+    ASSERT_EQ(1u, trace.listPaths.size());
+    ASSERT_EQ(0u, trace.listPaths[0].permutations);
+    ASSERT_EQ(1u, trace.pruned[RPR_FORMAT_MISMATCH]);
+    EXPECT_CALL(pMockControlInterface,getConnectionFormatChoice(_,_,_,_,_)).WillRepeatedly(DoAll(returnConnectionFormat(), Return(E_OK)));
+
+    // the only gateway from domain1 to domain2 is in use
+    am_Connection_s connection;
+    am_connectionID_t connectionID;
+    connection.sourceID = source1ID;
+    connection.sinkID = gw12SinkID;
+    connection.connectionFormat = CF_GENIVI_STEREO;
+    connection.connectionID = 0;
+    ASSERT_EQ(E_OK, pDatabaseHandler.enterConnectionDB(connection, connectionID));
+    ASSERT_EQ(E_NOT_POSSIBLE, pRouter.getRoute(true, source1ID, sink2ID, listTracedRoutes, trace));
+    ASSERT_GT(trace.pruned[RPR_BUSY], 0u);
+    ASSERT_TRUE(trace.listPaths.empty());
+}
+
+TEST_F(CAmRouterMapTest, graphSearchContexts)
+{
+    typedef CAmGraph<int, int> CAmIntGraph;
+    CAmIntGraph graph;
+    std::vector<CAmNode<int> *> nodes;
+    for (int i = 0; i < 5; i++)
+    {
+        nodes.push_back(&graph.addNode(i));
+    }
+
+    // every node is connected to every other node in both directions
+    for (int i = 0; i < 5; i++)
+    {
+        for (int j = 0; j < 5; j++)
+        {
+            if (i != j)
+            {
+                graph.connectNodes(*nodes[i], *nodes[j], 0, 1 + i + j);
+            }
+        }
+    }
+
+    auto cbShouldVisitNode = [](const CAmNode<int> *){ return true; };
+    auto cbVisitNode = [](const CAmNode<int> *){ };
+    typedef std::pair<std::vector<int>, CAmIntGraph::weight_t> CAmIntPath;
+    auto toPath = [](const std::vector<CAmNode<int> *> &path, const CAmIntGraph::weight_t weight){
+        std::vector<int> values;
+        for (auto it = path.begin(); it != path.end(); it++)
+        {
+            values.push_back((*it)->getData());
+        }
+
+        return CAmIntPath(values, weight);
+    };
+
+    std::vector<CAmIntPath> listExpected;
+    graph.getAllPaths(*nodes[0], *nodes[4], cbShouldVisitNode, cbVisitNode, cbVisitNode, [&](const std::vector<CAmNode<int> *> &path, const CAmIntGraph::weight_t weight){
+        listExpected.push_back(toPath(path, weight));
+    });
+    ASSERT_EQ(16u, listExpected.size());
+
+    // a context is reused by repeated searches, a second context can search while the first one is in the middle of its search
+    const CAmIntGraph &constGraph = graph;
+    CAmIntGraph::CAmSearchContext outerContext, innerContext;
+    for (unsigned repeat = 0; repeat < 3; repeat++)
+    {
+        std::vector<CAmIntPath> listOuter;
+        constGraph.getAllPaths(*nodes[0], *nodes[4], outerContext, cbShouldVisitNode, cbVisitNode, cbVisitNode, [&](const std::vector<CAmNode<int> *> &path, const CAmIntGraph::weight_t weight){
+            listOuter.push_back(toPath(path, weight));
+            std::vector<CAmIntPath> listInner;
+            constGraph.getAllPaths(*nodes[0], *nodes[4], innerContext, cbShouldVisitNode, cbVisitNode, cbVisitNode, [&](const std::vector<CAmNode<int> *> &innerPath, const CAmIntGraph::weight_t innerWeight){
+                listInner.push_back(toPath(innerPath, innerWeight));
+            });
+            ASSERT_EQ(listExpected, listInner);
+        });
+        ASSERT_EQ(listExpected, listOuter);
+    }
+
+    // the searches for several end nodes agree with the search for one of them
+    std::vector<CAmIntPath> listForward, listBackward;
+    constGraph.getAllPathsFromNode(*nodes[0], outerContext, [&](const CAmNode<int> *node){ return node == nodes[4]; },
+        cbShouldVisitNode, cbVisitNode, cbVisitNode, [&](const std::vector<CAmNode<int> *> &path, const CAmIntGraph::weight_t weight){
+            listForward.push_back(toPath(path, weight));
+        });
+    constGraph.getAllPathsToNode(*nodes[4], innerContext, [&](const CAmNode<int> *node){ return node == nodes[0]; },
+        cbShouldVisitNode, cbVisitNode, cbVisitNode, [&](const std::vector<CAmNode<int> *> &path, const CAmIntGraph::weight_t weight){
+            listBackward.push_back(toPath(path, weight));
+        });
+    std::sort(listExpected.begin(), listExpected.end());
+    std::sort(listForward.begin(), listForward.end());
+    std::sort(listBackward.begin(), listBackward.end());
+    ASSERT_EQ(listExpected, listForward);
+    ASSERT_EQ(listExpected, listBackward);
+}
+
 int main(int argc, char **argv)
 {
     try
@@ -0,0 +1,560 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include "CAmRouterStressTest.h"
+#include <algorithm>
+#include <chrono>
+#include <climits>
+#include <cstdlib>
+#include <iostream>
+#include <new>
+#include <tuple>
+#include "CAmLogWrapper.h"
+#include "CAmCommandLineSingleton.h"
+
+TCLAP::SwitchArg enableDebug("V", "logDlt", "print DLT logs to stdout or dlt-daemon default off", false);
+
+/*
+ * Counts the bytes allocated while gCountAllocations is set, this is the memory figure of the report.
+ */
+static bool   gCountAllocations = false;
+static size_t gAllocatedBytes   = 0;
+
+void *operator new(std::size_t size)
+{
+    if (gCountAllocations)
+    {
+        gAllocatedBytes += size;
+    }
+
+    void *pointer = std::malloc(size ? size : 1);
+    if (!pointer)
+    {
+        throw std::bad_alloc();
+    }
+
+    return (pointer);
+}
+
+void operator delete(void *pointer) noexcept
+{
+    std::free(pointer);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept
+{
+    std::free(pointer);
+}
+
+using namespace am;
+using namespace testing;
+
+namespace
+{
+
+typedef std::tuple<am_sourceID_t, am_sinkID_t, am_domainID_t, am_CustomConnectionFormat_t> RouteElementKey;
+typedef std::vector<RouteElementKey>                                                       RouteKey;
+
+/**
+ * Brings a list of routes into a canonical form, the order of the routes does not matter.
+ */
+std::vector<RouteKey> canonical(const std::vector<am_Route_s> &listRoutes)
+{
+    std::vector<RouteKey> listKeys;
+    for (const am_Route_s &route : listRoutes)
+    {
+        RouteKey key;
+        for (const am_RoutingElement_s &element : route.route)
+        {
+            key.emplace_back(element.sourceID, element.sinkID, element.domainID, element.connectionFormat);
+        }
+
+        listKeys.push_back(key);
+    }
+
+    std::sort(listKeys.begin(), listKeys.end());
+    return (listKeys);
+}
+
+template<typename T>
+T percentile(std::vector<T> &values, const unsigned percent)
+{
+    if (values.empty())
+    {
+        return (T());
+    }
+
+    std::sort(values.begin(), values.end());
+    return (values[(values.size() - 1) * percent / 100]);
+}
+
+std::vector<am_CustomConnectionFormat_t> intersect(std::vector<am_CustomConnectionFormat_t> first, std::vector<am_CustomConnectionFormat_t> second)
+{
+    std::vector<am_CustomConnectionFormat_t> result;
+    std::sort(first.begin(), first.end());
+    std::sort(second.begin(), second.end());
+    std::set_intersection(first.begin(), first.end(), second.begin(), second.end(), std::back_inserter(result));
+    return (result);
+}
+
+}
+
+CAmReferenceRouter::CAmReferenceRouter(const IAmDatabaseHandler &databaseHandler)
+    : mListSources()
+    , mListSinks()
+    , mListGateways()
+    , mListConverters()
+    , mListConnections()
+{
+    databaseHandler.getListSources(mListSources);
+    databaseHandler.getListSinks(mListSinks);
+    databaseHandler.getListGateways(mListGateways);
+    databaseHandler.getListConverters(mListConverters);
+    databaseHandler.getListConnections(mListConnections);
+}
+
+void CAmReferenceRouter::getRoute(const bool onlyfree, const unsigned maxCycles, const am_sourceID_t sourceID, const am_sinkID_t sinkID,
+    std::vector<am_Route_s> &returnList) const
+{
+    returnList.clear();
+
+    size_t sourceIndex = 0;
+    for (; sourceIndex < mListSources.size() && mListSources[sourceIndex].sourceID != sourceID; sourceIndex++)
+    {
+    }
+
+    if (sourceIndex == mListSources.size())
+    {
+        return;
+    }
+
+    // without cycles first, with cycles only if there was nothing
+    const unsigned listCycles[] = {0, maxCycles};
+    for (const unsigned cycles : listCycles)
+    {
+        am_Path_t                  path(1, am_Element_s{ET_SOURCE, sourceIndex});
+        std::vector<am_domainID_t> listVisitedDomains(1, mListSources[sourceIndex].domainID);
+        std::vector<am_Path_t>     listPaths;
+        findPaths(onlyfree, cycles, sinkID, path, listVisitedDomains, listPaths);
+
+        for (const am_Path_t &foundPath : listPaths)
+        {
+            am_Route_s route;
+            route.sourceID = sourceID;
+            route.sinkID   = sinkID;
+            route.route.resize((foundPath.size() + 1) / 3);
+            addFormatPermutations(foundPath, 0, route, returnList);
+        }
+
+        if (!returnList.empty() || maxCycles == 0)
+        {
+            return;
+        }
+    }
+}
+
+am_domainID_t CAmReferenceRouter::domainOf(const am_Element_s &element) const
+{
+    switch (element.type)
+    {
+    case ET_SOURCE:
+        return (mListSources[element.index].domainID);
+    case ET_SINK:
+        return (mListSinks[element.index].domainID);
+    case ET_GATEWAY:
+        return (mListGateways[element.index].controlDomainID);
+    default:
+        return (mListConverters[element.index].domainID);
+    }
+}
+
+bool CAmReferenceRouter::isBusy(const am_Element_s &element) const
+{
+    am_sourceID_t sourceID;
+    am_sinkID_t   sinkID;
+    if (element.type == ET_GATEWAY)
+    {
+        sourceID = mListGateways[element.index].sourceID;
+        sinkID   = mListGateways[element.index].sinkID;
+    }
+    else if (element.type == ET_CONVERTER)
+    {
+        sourceID = mListConverters[element.index].sourceID;
+        sinkID   = mListConverters[element.index].sinkID;
+    }
+    else
+    {
+        return (false);
+    }
+
+    for (const am_Connection_s &connection : mListConnections)
+    {
+        if ((connection.sourceID == sourceID) || (connection.sinkID == sinkID))
+        {
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+/**
+ * A domain may be entered again, if the route entered it at most cycles times before.
+ */
+bool CAmReferenceRouter::mayEnterDomain(const std::vector<am_domainID_t> &listVisitedDomains, const am_domainID_t domainID, const unsigned cycles) const
+{
+    if (listVisitedDomains.back() == domainID)
+    {
+        return (true);
+    }
+
+    unsigned entered = 0;
+    for (size_t i = 0; i < listVisitedDomains.size(); i++)
+    {
+        if ((listVisitedDomains[i] == domainID) && ((i == 0) || (listVisitedDomains[i - 1] != domainID)))
+        {
+            entered++;
+        }
+    }
+
+    return (entered <= cycles);
+}
+
+void CAmReferenceRouter::getSuccessors(const am_Element_s &element, std::vector<am_Element_s> &listSuccessors) const
+{
+    std::vector<am_CustomConnectionFormat_t> sourceFormats, sinkFormats;
+    size_t                                   index;
+    if (element.type == ET_SOURCE)
+    {
+        const am_Source_s &source = mListSources[element.index];
+        for (size_t i = 0; i < mListSinks.size(); i++)
+        {
+            if ((mListSinks[i].domainID == source.domainID) && !intersect(source.listConnectionFormats, mListSinks[i].listConnectionFormats).empty())
+            {
+                listSuccessors.push_back(am_Element_s{ET_SINK, i});
+            }
+        }
+    }
+    else if (element.type == ET_SINK)
+    {
+        const am_Sink_s &sink = mListSinks[element.index];
+        for (size_t i = 0; i < mListConverters.size(); i++)
+        {
+            const am_Converter_s &converter = mListConverters[i];
+            sourceFormats.clear();
+            sinkFormats.clear();
+            if ((converter.sinkID == sink.sinkID) && (converter.domainID == sink.domainID)
+                && findSourceIndex(converter.sourceID, converter.domainID, index)
+                && CAmRouter::getAllowedFormatsFromConvMatrix(converter.convertionMatrix, converter.listSourceFormats, converter.listSinkFormats, sourceFormats, sinkFormats))
+            {
+                listSuccessors.push_back(am_Element_s{ET_CONVERTER, i});
+            }
+        }
+
+        for (size_t i = 0; i < mListGateways.size(); i++)
+        {
+            const am_Gateway_s &gateway = mListGateways[i];
+            sourceFormats.clear();
+            sinkFormats.clear();
+            if ((gateway.sinkID == sink.sinkID) && (gateway.domainSinkID == sink.domainID)
+                && findSourceIndex(gateway.sourceID, gateway.domainSourceID, index)
+                && CAmRouter::getAllowedFormatsFromConvMatrix(gateway.convertionMatrix, gateway.listSourceFormats, gateway.listSinkFormats, sourceFormats, sinkFormats))
+            {
+                listSuccessors.push_back(am_Element_s{ET_GATEWAY, i});
+            }
+        }
+    }
+    else if (element.type == ET_GATEWAY)
+    {
+        const am_Gateway_s &gateway = mListGateways[element.index];
+        if (findSourceIndex(gateway.sourceID, gateway.domainSourceID, index))
+        {
+            listSuccessors.push_back(am_Element_s{ET_SOURCE, index});
+        }
+    }
+    else
+    {
+        const am_Converter_s &converter = mListConverters[element.index];
+        if (findSourceIndex(converter.sourceID, converter.domainID, index))
+        {
+            listSuccessors.push_back(am_Element_s{ET_SOURCE, index});
+        }
+    }
+}
+
+void CAmReferenceRouter::findPaths(const bool onlyfree, const unsigned cycles, const am_sinkID_t sinkID, am_Path_t &path,
+    std::vector<am_domainID_t> &listVisitedDomains, std::vector<am_Path_t> &listPaths) const
+{
+    std::vector<am_Element_s> listSuccessors;
+    getSuccessors(path.back(), listSuccessors);
+    for (const am_Element_s &next : listSuccessors)
+    {
+        if ((std::find(path.begin(), path.end(), next) != path.end())
+            || !mayEnterDomain(listVisitedDomains, domainOf(next), cycles)
+            || (onlyfree && isBusy(next)))
+        {
+            continue;
+        }
+
+        path.push_back(next);
+        listVisitedDomains.push_back(domainOf(next));
+        if ((next.type == ET_SINK) && (mListSinks[next.index].sinkID == sinkID))
+        {
+            listPaths.push_back(path);
+        }
+        else
+        {
+            findPaths(onlyfree, cycles, sinkID, path, listVisitedDomains, listPaths);
+        }
+
+        listVisitedDomains.pop_back();
+        path.pop_back();
+    }
+}
+
+/**
+ * A path is source, sink [, gateway or converter, source, sink]... and every source/sink pair is one routing element.
+ * The formats of the first element are the common formats of source and sink, every further element is restricted
+ * by the conversion matrix of the gateway or converter in front of it.
+ */
+void CAmReferenceRouter::addFormatPermutations(const am_Path_t &path, const size_t elementIndex, am_Route_s &route, std::vector<am_Route_s> &returnList) const
+{
+    if (elementIndex == route.route.size())
+    {
+        returnList.push_back(route);
+        return;
+    }
+
+    const am_Source_s                       &source = mListSources[path[3 * elementIndex].index];
+    const am_Sink_s                         &sink   = mListSinks[path[3 * elementIndex + 1].index];
+    std::vector<am_CustomConnectionFormat_t> listFormats = intersect(source.listConnectionFormats, sink.listConnectionFormats);
+    if (elementIndex > 0)
+    {
+        const am_Element_s                      &element = path[3 * elementIndex - 1];
+        const am_CustomConnectionFormat_t        previousFormat = route.route[elementIndex - 1].connectionFormat;
+        std::vector<am_CustomConnectionFormat_t> listRestricted;
+        if (element.type == ET_GATEWAY)
+        {
+            const am_Gateway_s &gateway = mListGateways[element.index];
+            CAmRouter::getRestrictedOutputFormats(gateway.convertionMatrix, gateway.listSourceFormats, gateway.listSinkFormats, previousFormat, listRestricted);
+        }
+        else
+        {
+            const am_Converter_s &converter = mListConverters[element.index];
+            CAmRouter::getRestrictedOutputFormats(converter.convertionMatrix, converter.listSourceFormats, converter.listSinkFormats, previousFormat, listRestricted);
+        }
+
+        listFormats = intersect(listFormats, listRestricted);
+    }
+
+    am_RoutingElement_s &routingElement = route.route[elementIndex];
+    routingElement.sourceID = source.sourceID;
+    routingElement.sinkID   = sink.sinkID;
+    routingElement.domainID = sink.domainID;
+    for (const am_CustomConnectionFormat_t format : listFormats)
+    {
+        routingElement.connectionFormat = format;
+        addFormatPermutations(path, elementIndex + 1, route, returnList);
+    }
+}
+
+bool CAmReferenceRouter::findSourceIndex(const am_sourceID_t sourceID, const am_domainID_t domainID, size_t &index) const
+{
+    for (index = 0; index < mListSources.size(); index++)
+    {
+        if ((mListSources[index].sourceID == sourceID) && (mListSources[index].domainID == domainID))
+        {
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+CAmRouterStressTest::CAmRouterStressTest()
+    : pControlSender()
+    , pDatabaseHandler()
+    , pRouter(&pDatabaseHandler, &pControlSender)
+    , pController()
+    , pControlInterfaceBackdoor()
+    , pGenerator(pDatabaseHandler)
+{
+    pDatabaseHandler.registerObserver(&pRouter);
+    pControlInterfaceBackdoor.replaceController(&pControlSender, &pController);
+}
+
+CAmRouterStressTest::~CAmRouterStressTest()
+{
+}
+
+/**
+ * Generates the topology, compares getRoute for all source/sink pairs with the reference and reports
+ * the time and the allocated memory per getRoute call.
+ */
+void CAmRouterStressTest::stress(const std::string &name, const CAmTopologyGenerator::am_TopologyParameters_s &parameters, const unsigned maxCycles)
+{
+    ASSERT_EQ(E_OK, pGenerator.generate(parameters));
+    pRouter.setMaxAllowedCycles(maxCycles);
+    pRouter.setMaxPathCount(UINT_MAX);
+
+    CAmReferenceRouter      referenceRouter(pDatabaseHandler);
+    std::vector<am_Route_s> listRoutes, listReferenceRoutes;
+    std::vector<int64_t>    listNanoseconds;
+    std::vector<size_t>     listBytes;
+    size_t                  routes = 0;
+
+    for (const bool onlyfree : {false, true})
+    {
+        for (const am_sourceID_t sourceID : pGenerator.getListSourceIDs())
+        {
+            for (const am_sinkID_t sinkID : pGenerator.getListSinkIDs())
+            {
+                gAllocatedBytes   = 0;
+                gCountAllocations = true;
+                const auto start = std::chrono::steady_clock::now();
+                pRouter.getRoute(onlyfree, sourceID, sinkID, listRoutes);
+                const auto stop = std::chrono::steady_clock::now();
+                gCountAllocations = false;
+                listNanoseconds.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(stop - start).count());
+                listBytes.push_back(gAllocatedBytes);
+
+                referenceRouter.getRoute(onlyfree, maxCycles, sourceID, sinkID, listReferenceRoutes);
+                ASSERT_EQ(canonical(listReferenceRoutes), canonical(listRoutes))
+                    << "onlyfree=" << onlyfree << " source=" << sourceID << " sink=" << sinkID;
+                routes += listRoutes.size();
+            }
+        }
+    }
+
+    std::cout << "[ STRESS   ] " << name << ": " << listNanoseconds.size() << " calls, " << routes << " routes" << std::endl
+              << "[ STRESS   ] time [us]    p50=" << percentile(listNanoseconds, 50) / 1000 << " p90=" << percentile(listNanoseconds, 90) / 1000
+              << " p99=" << percentile(listNanoseconds, 99) / 1000 << " max=" << percentile(listNanoseconds, 100) / 1000 << std::endl
+              << "[ STRESS   ] memory [B]   p50=" << percentile(listBytes, 50) << " p90=" << percentile(listBytes, 90)
+              << " p99=" << percentile(listBytes, 99) << " max=" << percentile(listBytes, 100) << std::endl;
+    RecordProperty("calls", static_cast<int>(listNanoseconds.size()));
+    RecordProperty("routes", static_cast<int>(routes));
+    RecordProperty("timeP99Us", static_cast<int>(percentile(listNanoseconds, 99) / 1000));
+    RecordProperty("memoryP99Bytes", static_cast<int>(percentile(listBytes, 99)));
+}
+
+TEST_F(CAmRouterStressTest, generatorIsDeterministic)
+{
+    CAmTopologyGenerator::am_TopologyParameters_s parameters = CAmTopologyGenerator::defaultParameters();
+    parameters.convertersPerDomain = 1;
+    parameters.formats             = 4;
+    parameters.matrixDensity       = 0.5;
+    parameters.cycles              = true;
+    ASSERT_EQ(E_OK, pGenerator.generate(parameters));
+
+    CAmDatabaseHandlerMap otherDatabase;
+    CAmTopologyGenerator  otherGenerator(otherDatabase);
+    ASSERT_EQ(E_OK, otherGenerator.generate(parameters));
+
+    std::vector<am_Gateway_s> listGateways, listOtherGateways;
+    pDatabaseHandler.getListGateways(listGateways);
+    otherDatabase.getListGateways(listOtherGateways);
+    ASSERT_EQ(8u, listGateways.size());
+    ASSERT_EQ(listGateways.size(), listOtherGateways.size());
+    for (size_t i = 0; i < listGateways.size(); i++)
+    {
+        EXPECT_EQ(listGateways[i].listSinkFormats, listOtherGateways[i].listSinkFormats);
+        EXPECT_EQ(listGateways[i].listSourceFormats, listOtherGateways[i].listSourceFormats);
+        EXPECT_EQ(listGateways[i].convertionMatrix, listOtherGateways[i].convertionMatrix);
+    }
+
+    EXPECT_EQ(4u, pGenerator.getListConverterIDs().size());
+    EXPECT_EQ(8u, pGenerator.getListSourceIDs().size());
+    EXPECT_EQ(8u, pGenerator.getListSinkIDs().size());
+}
+
+TEST_F(CAmRouterStressTest, chainWithoutCycles)
+{
+    CAmTopologyGenerator::am_TopologyParameters_s parameters = CAmTopologyGenerator::defaultParameters();
+    parameters.domains               = 5;
+    parameters.gatewaysPerDomainPair = 2;
+    parameters.formats               = 3;
+    parameters.matrixDensity         = 0.7;
+    stress("chainWithoutCycles", parameters, 0);
+}
+
+TEST_F(CAmRouterStressTest, carTopology)
+{
+    CAmTopologyGenerator::am_TopologyParameters_s parameters = CAmTopologyGenerator::defaultParameters();
+    parameters.domains               = 4;
+    parameters.sourcesPerDomain      = 3;
+    parameters.sinksPerDomain        = 3;
+    parameters.gatewaysPerDomainPair = 1;
+    parameters.convertersPerDomain   = 1;
+    parameters.formats               = 4;
+    parameters.formatsPerElement     = 2;
+    parameters.matrixDensity         = 0.6;
+    parameters.busyRatio             = 0.2;
+    parameters.cycles                = true;
+    parameters.seed                  = 7;
+    stress("carTopology", parameters, 1);
+}
+
+TEST_F(CAmRouterStressTest, rearSeatEntertainmentTopology)
+{
+    CAmTopologyGenerator::am_TopologyParameters_s parameters = CAmTopologyGenerator::defaultParameters();
+    parameters.domains               = 6;
+    parameters.sourcesPerDomain      = 2;
+    parameters.sinksPerDomain        = 3;
+    parameters.gatewaysPerDomainPair = 1;
+    parameters.convertersPerDomain   = 1;
+    parameters.formats               = 3;
+    parameters.formatsPerElement     = 3;
+    parameters.matrixDensity         = 0.5;
+    parameters.busyRatio             = 0.1;
+    parameters.cycles                = true;
+    parameters.seed                  = 42;
+    stress("rearSeatEntertainmentTopology", parameters, 2);
+}
+
+TEST_F(CAmRouterStressTest, sparseMatrices)
+{
+    CAmTopologyGenerator::am_TopologyParameters_s parameters = CAmTopologyGenerator::defaultParameters();
+    parameters.domains               = 5;
+    parameters.gatewaysPerDomainPair = 2;
+    parameters.formats               = 4;
+    parameters.formatsPerElement     = 4;
+    parameters.matrixDensity         = 0.2;
+    parameters.cycles                = true;
+    parameters.seed                  = 3;
+    stress("sparseMatrices", parameters, 1);
+}
+
+int main(int argc, char **argv)
+{
+    try
+    {
+        TCLAP::CmdLine *cmd(CAmCommandLineSingleton::instanciateOnce("The team of the AudioManager wishes you a nice day!", ' ', DAEMONVERSION, true));
+        cmd->add(enableDebug);
+    }
+    catch (TCLAP::ArgException &e)  // catch any exceptions
+    {
+        std::cerr << "error: " << e.error() << " for arg " << e.argId() << std::endl;
+    }
+
+    CAmCommandLineSingleton::instance()->preparse(argc, argv);
+    CAmLogWrapper::instantiateOnce("sTEST", "RouterStress Test"
+        , enableDebug.getValue() ? LS_ON : LS_OFF, LOG_SERVICE_DLT);
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,121 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#ifndef ROUTERSTRESSTEST_H_
+#define ROUTERSTRESSTEST_H_
+
+#define UNIT_TEST 1
+
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include <string>
+#include <vector>
+#include "CAmDatabaseHandlerMap.h"
+#include "CAmControlSender.h"
+#include "CAmRouter.h"
+#include "../IAmControlBackdoor.h"
+#include "../MockIAmControlSend.h"
+#include "../CAmTopologyGenerator.h"
+
+namespace am
+{
+
+/**
+ * A controller that accepts all possible connection formats in the given order.
+ * It does not go through gmock, so it does not distort the measurements.
+ */
+class CAmAcceptAllController : public ::testing::NiceMock<MockIAmControlSend>
+{
+public:
+    am_Error_e getConnectionFormatChoice(const am_sourceID_t, const am_sinkID_t, const am_Route_s,
+        const std::vector<am_CustomConnectionFormat_t> listPossibleConnectionFormats,
+        std::vector<am_CustomConnectionFormat_t> &listPrioConnectionFormats) override
+    {
+        listPrioConnectionFormats = listPossibleConnectionFormats;
+        return (E_OK);
+    }
+};
+
+/**
+ * Straightforward depth first router that enumerates all routes between a source and a sink without any graph.
+ * It follows the rules of CAmRouter: no element is used twice in a route, a domain may only be entered again
+ * maxCycles times, and a second search with cycles is done only if the search without cycles found nothing.
+ */
+class CAmReferenceRouter
+{
+public:
+    explicit CAmReferenceRouter(const IAmDatabaseHandler &databaseHandler);
+    void getRoute(const bool onlyfree, const unsigned maxCycles, const am_sourceID_t sourceID, const am_sinkID_t sinkID, std::vector<am_Route_s> &returnList) const;
+
+private:
+    enum am_ElementType_e
+    {
+        ET_SOURCE,
+        ET_SINK,
+        ET_GATEWAY,
+        ET_CONVERTER
+    };
+
+    struct am_Element_s
+    {
+        am_ElementType_e type;
+        size_t           index;
+
+        bool operator ==(const am_Element_s &other) const
+        {
+            return ((type == other.type) && (index == other.index));
+        }
+    };
+
+    typedef std::vector<am_Element_s> am_Path_t;
+
+    am_domainID_t domainOf(const am_Element_s &element) const;
+    bool isBusy(const am_Element_s &element) const;
+    bool mayEnterDomain(const std::vector<am_domainID_t> &listVisitedDomains, const am_domainID_t domainID, const unsigned cycles) const;
+    void getSuccessors(const am_Element_s &element, std::vector<am_Element_s> &listSuccessors) const;
+    void findPaths(const bool onlyfree, const unsigned cycles, const am_sinkID_t sinkID, am_Path_t &path,
+        std::vector<am_domainID_t> &listVisitedDomains, std::vector<am_Path_t> &listPaths) const;
+    void addFormatPermutations(const am_Path_t &path, const size_t elementIndex, am_Route_s &route, std::vector<am_Route_s> &returnList) const;
+    bool findSourceIndex(const am_sourceID_t sourceID, const am_domainID_t domainID, size_t &index) const;
+
+    std::vector<am_Source_s>     mListSources;
+    std::vector<am_Sink_s>       mListSinks;
+    std::vector<am_Gateway_s>    mListGateways;
+    std::vector<am_Converter_s>  mListConverters;
+    std::vector<am_Connection_s> mListConnections;
+};
+
+class CAmRouterStressTest : public ::testing::Test
+{
+public:
+    CAmRouterStressTest();
+    ~CAmRouterStressTest();
+    CAmControlSender         pControlSender;
+    CAmDatabaseHandlerMap    pDatabaseHandler;
+    CAmRouter                pRouter;
+    CAmAcceptAllController   pController;
+    IAmControlBackdoor       pControlInterfaceBackdoor;
+    CAmTopologyGenerator     pGenerator;
+
+    void stress(const std::string &name, const CAmTopologyGenerator::am_TopologyParameters_s &parameters, const unsigned maxCycles);
+};
+
+}
+
+#endif /* ROUTERSTRESSTEST_H_ */
@@ -0,0 +1,306 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include "CAmTopologyGenerator.h"
+#include <algorithm>
+#include <sstream>
+
+namespace am
+{
+
+CAmTopologyGenerator::am_TopologyParameters_s CAmTopologyGenerator::defaultParameters()
+{
+    am_TopologyParameters_s parameters;
+    parameters.domains               = 4;
+    parameters.sourcesPerDomain      = 2;
+    parameters.sinksPerDomain        = 2;
+    parameters.gatewaysPerDomainPair = 1;
+    parameters.convertersPerDomain   = 0;
+    parameters.formats               = 2;
+    parameters.formatsPerElement     = 2;
+    parameters.matrixDensity         = 1.0;
+    parameters.busyRatio             = 0.0;
+    parameters.cycles                = false;
+    parameters.seed                  = 1;
+    return (parameters);
+}
+
+CAmTopologyGenerator::CAmTopologyGenerator(IAmDatabaseHandler &databaseHandler)
+    : mDatabaseHandler(databaseHandler)
+    , mParameters(defaultParameters())
+    , mRandom()
+    , mSinkClassID(0)
+    , mSourceClassID(0)
+    , mCounter(0)
+    , mListDomainIDs()
+    , mListSourceIDs()
+    , mListSinkIDs()
+    , mListGatewayIDs()
+    , mListConverterIDs()
+{
+}
+
+am_Error_e CAmTopologyGenerator::generate(const am_TopologyParameters_s &parameters)
+{
+    if ((parameters.domains == 0) || (parameters.formats == 0) || (parameters.formatsPerElement == 0))
+    {
+        return (E_NOT_POSSIBLE);
+    }
+
+    mParameters = parameters;
+    mRandom.seed(parameters.seed);
+
+    am_Error_e       error;
+    am_SinkClass_s   sinkClass;
+    am_SourceClass_s sourceClass;
+    sinkClass.sinkClassID     = 0;
+    sinkClass.name            = "topologySinkClass";
+    sourceClass.sourceClassID = 0;
+    sourceClass.name          = "topologySourceClass";
+    if (((error = mDatabaseHandler.enterSinkClassDB(sinkClass, mSinkClassID)) != E_OK)
+        || ((error = mDatabaseHandler.enterSourceClassDB(mSourceClassID, sourceClass)) != E_OK))
+    {
+        return (error);
+    }
+
+    for (unsigned i = 0; i < parameters.domains; i++)
+    {
+        std::ostringstream name;
+        name << "domain" << i;
+
+        am_Domain_s domain;
+        domain.domainID = 0;
+        domain.name     = name.str();
+        domain.busname  = "topologyBus";
+        domain.nodename = "topologyNode";
+        domain.early    = false;
+        domain.complete = true;
+        domain.state    = DS_CONTROLLED;
+
+        am_domainID_t domainID;
+        if ((error = mDatabaseHandler.enterDomainDB(domain, domainID)) != E_OK)
+        {
+            return (error);
+        }
+
+        mListDomainIDs.push_back(domainID);
+    }
+
+    for (const am_domainID_t domainID : mListDomainIDs)
+    {
+        for (unsigned i = 0; i < parameters.sourcesPerDomain; i++)
+        {
+            am_sourceID_t sourceID;
+            if ((error = enterSource("source", domainID, randomFormats(), sourceID)) != E_OK)
+            {
+                return (error);
+            }
+
+            mListSourceIDs.push_back(sourceID);
+        }
+
+        for (unsigned i = 0; i < parameters.sinksPerDomain; i++)
+        {
+            am_sinkID_t sinkID;
+            if ((error = enterSink("sink", domainID, randomFormats(), sinkID)) != E_OK)
+            {
+                return (error);
+            }
+
+            mListSinkIDs.push_back(sinkID);
+        }
+
+        for (unsigned i = 0; i < parameters.convertersPerDomain; i++)
+        {
+            if ((error = enterConverter(domainID)) != E_OK)
+            {
+                return (error);
+            }
+        }
+    }
+
+    // the chain, closed to a ring in case of cycles
+    const unsigned pairs = (parameters.cycles && parameters.domains > 2) ? parameters.domains : parameters.domains - 1;
+    for (unsigned i = 0; i < pairs; i++)
+    {
+        const am_domainID_t first  = mListDomainIDs[i];
+        const am_domainID_t second = mListDomainIDs[(i + 1) % parameters.domains];
+        for (unsigned j = 0; j < parameters.gatewaysPerDomainPair; j++)
+        {
+            if (((error = enterGateway(first, second)) != E_OK)
+                || (parameters.cycles && ((error = enterGateway(second, first)) != E_OK)))
+            {
+                return (error);
+            }
+        }
+    }
+
+    return (E_OK);
+}
+
+std::vector<am_CustomConnectionFormat_t> CAmTopologyGenerator::randomFormats()
+{
+    // mt19937 output is defined by the standard, unlike the distributions, so the topologies are the same everywhere
+    std::vector<am_CustomConnectionFormat_t> listFormats;
+    const unsigned count = 1 + mRandom() % std::min(mParameters.formats, mParameters.formatsPerElement);
+    while (listFormats.size() < count)
+    {
+        const am_CustomConnectionFormat_t format = static_cast<am_CustomConnectionFormat_t>(1 + mRandom() % mParameters.formats);
+        if (std::find(listFormats.begin(), listFormats.end(), format) == listFormats.end())
+        {
+            listFormats.push_back(format);
+        }
+    }
+
+    return (listFormats);
+}
+
+std::vector<bool> CAmTopologyGenerator::randomMatrix(const size_t sinkFormats, const size_t sourceFormats)
+{
+    std::vector<bool> convertionMatrix(sinkFormats * sourceFormats);
+    for (size_t i = 0; i < convertionMatrix.size(); i++)
+    {
+        convertionMatrix[i] = (mRandom() - mRandom.min()) < mParameters.matrixDensity * (mRandom.max() - mRandom.min());
+    }
+
+    return (convertionMatrix);
+}
+
+am_Error_e CAmTopologyGenerator::enterSource(const std::string &name, const am_domainID_t domainID,
+    const std::vector<am_CustomConnectionFormat_t> &listFormats, am_sourceID_t &sourceID)
+{
+    std::ostringstream uniqueName;
+    uniqueName << name << mCounter++;
+
+    am_Source_s source;
+    source.sourceID              = 0;
+    source.name                  = uniqueName.str();
+    source.domainID              = domainID;
+    source.sourceClassID         = mSourceClassID;
+    source.sourceState           = SS_ON;
+    source.visible               = true;
+    source.listConnectionFormats = listFormats;
+    return (mDatabaseHandler.enterSourceDB(source, sourceID));
+}
+
+am_Error_e CAmTopologyGenerator::enterSink(const std::string &name, const am_domainID_t domainID,
+    const std::vector<am_CustomConnectionFormat_t> &listFormats, am_sinkID_t &sinkID)
+{
+    std::ostringstream uniqueName;
+    uniqueName << name << mCounter++;
+
+    am_Sink_s sink;
+    sink.sinkID                = 0;
+    sink.name                  = uniqueName.str();
+    sink.domainID              = domainID;
+    sink.sinkClassID           = mSinkClassID;
+    sink.muteState             = MS_UNMUTED;
+    sink.visible               = true;
+    sink.listConnectionFormats = listFormats;
+    return (mDatabaseHandler.enterSinkDB(sink, sinkID));
+}
+
+am_Error_e CAmTopologyGenerator::enterGateway(const am_domainID_t domainSinkID, const am_domainID_t domainSourceID)
+{
+    am_Error_e   error;
+    am_Gateway_s gateway;
+    gateway.gatewayID         = 0;
+    gateway.domainSinkID      = domainSinkID;
+    gateway.domainSourceID    = domainSourceID;
+    gateway.controlDomainID   = domainSinkID;
+    gateway.listSinkFormats   = randomFormats();
+    gateway.listSourceFormats = randomFormats();
+    gateway.convertionMatrix  = randomMatrix(gateway.listSinkFormats.size(), gateway.listSourceFormats.size());
+    if (((error = enterSink("gatewaySink", domainSinkID, gateway.listSinkFormats, gateway.sinkID)) != E_OK)
+        || ((error = enterSource("gatewaySource", domainSourceID, gateway.listSourceFormats, gateway.sourceID)) != E_OK))
+    {
+        return (error);
+    }
+
+    std::ostringstream name;
+    name << "gateway" << mCounter++;
+    gateway.name = name.str();
+
+    am_gatewayID_t gatewayID;
+    if ((error = mDatabaseHandler.enterGatewayDB(gateway, gatewayID)) != E_OK)
+    {
+        return (error);
+    }
+
+    mListGatewayIDs.push_back(gatewayID);
+    return (occupy(gateway.sourceID, gateway.sinkID));
+}
+
+am_Error_e CAmTopologyGenerator::enterConverter(const am_domainID_t domainID)
+{
+    am_Error_e     error;
+    am_Converter_s converter;
+    converter.converterID       = 0;
+    converter.domainID          = domainID;
+    converter.listSinkFormats   = randomFormats();
+    converter.listSourceFormats = randomFormats();
+    converter.convertionMatrix  = randomMatrix(converter.listSinkFormats.size(), converter.listSourceFormats.size());
+    if (((error = enterSink("converterSink", domainID, converter.listSinkFormats, converter.sinkID)) != E_OK)
+        || ((error = enterSource("converterSource", domainID, converter.listSourceFormats, converter.sourceID)) != E_OK))
+    {
+        return (error);
+    }
+
+    std::ostringstream name;
+    name << "converter" << mCounter++;
+    converter.name = name.str();
+
+    am_converterID_t converterID;
+    if ((error = mDatabaseHandler.enterConverterDB(converter, converterID)) != E_OK)
+    {
+        return (error);
+    }
+
+    mListConverterIDs.push_back(converterID);
+    return (occupy(converter.sourceID, converter.sinkID));
+}
+
+/**
+ * Marks a gateway or converter as used with a probability of busyRatio, by connecting its own hidden source and sink.
+ */
+am_Error_e CAmTopologyGenerator::occupy(const am_sourceID_t sourceID, const am_sinkID_t sinkID)
+{
+    if ((mRandom() - mRandom.min()) >= mParameters.busyRatio * (mRandom.max() - mRandom.min()))
+    {
+        return (E_OK);
+    }
+
+    am_Connection_s connection;
+    connection.connectionID     = 0;
+    connection.sourceID         = sourceID;
+    connection.sinkID           = sinkID;
+    connection.delay            = 0;
+    connection.connectionFormat = CF_UNKNOWN;
+
+    am_Error_e        error;
+    am_connectionID_t connectionID;
+    if ((error = mDatabaseHandler.enterConnectionDB(connection, connectionID, false)) != E_OK)
+    {
+        return (error);
+    }
+
+    return (mDatabaseHandler.changeConnectionFinal(connectionID));
+}
+
+}
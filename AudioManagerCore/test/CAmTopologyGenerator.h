@@ -0,0 +1,113 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#ifndef CAMTOPOLOGYGENERATOR_H_
+#define CAMTOPOLOGYGENERATOR_H_
+
+#include <random>
+#include <string>
+#include <vector>
+#include "audiomanagertypes.h"
+#include "IAmDatabaseHandler.h"
+
+namespace am
+{
+
+/**
+ * Populates a database with a synthetic routing topology.
+ * The domains are connected as a chain, every domain pair gets a number of gateways. With cycles enabled the chain is
+ * closed to a ring and every pair is connected in both directions. Every gateway and converter gets its own hidden sink
+ * and source which carry the same formats as the element. The formats of all elements are random subsets of a common
+ * format set, the conversion matrices are filled randomly with the given density.
+ * The generator is deterministic for a given seed.
+ */
+class CAmTopologyGenerator
+{
+public:
+    struct am_TopologyParameters_s
+    {
+        unsigned domains;                //!< number of domains
+        unsigned sourcesPerDomain;       //!< number of plain sources in each domain
+        unsigned sinksPerDomain;         //!< number of plain sinks in each domain
+        unsigned gatewaysPerDomainPair;  //!< number of gateways between two neighbouring domains (per direction)
+        unsigned convertersPerDomain;    //!< number of converters in each domain
+        unsigned formats;                //!< size of the common connection format set
+        unsigned formatsPerElement;      //!< maximum number of formats of a single element
+        double   matrixDensity;          //!< probability of a true entry in a conversion matrix
+        double   busyRatio;              //!< fraction of gateways and converters that are already in use by a connection
+        bool     cycles;                 //!< connect the domains as ring in both directions
+        unsigned seed;                   //!< seed for the random generator
+    };
+
+    static am_TopologyParameters_s defaultParameters();
+
+    explicit CAmTopologyGenerator(IAmDatabaseHandler &databaseHandler);
+
+    am_Error_e generate(const am_TopologyParameters_s &parameters);
+
+    const std::vector<am_domainID_t> &getListDomainIDs() const
+    {
+        return (mListDomainIDs);
+    }
+
+    const std::vector<am_sourceID_t> &getListSourceIDs() const
+    {
+        return (mListSourceIDs);
+    }
+
+    const std::vector<am_sinkID_t> &getListSinkIDs() const
+    {
+        return (mListSinkIDs);
+    }
+
+    const std::vector<am_gatewayID_t> &getListGatewayIDs() const
+    {
+        return (mListGatewayIDs);
+    }
+
+    const std::vector<am_converterID_t> &getListConverterIDs() const
+    {
+        return (mListConverterIDs);
+    }
+
+private:
+    std::vector<am_CustomConnectionFormat_t> randomFormats();
+    std::vector<bool> randomMatrix(const size_t sinkFormats, const size_t sourceFormats);
+    am_Error_e enterSource(const std::string &name, const am_domainID_t domainID, const std::vector<am_CustomConnectionFormat_t> &listFormats, am_sourceID_t &sourceID);
+    am_Error_e enterSink(const std::string &name, const am_domainID_t domainID, const std::vector<am_CustomConnectionFormat_t> &listFormats, am_sinkID_t &sinkID);
+    am_Error_e enterGateway(const am_domainID_t domainSinkID, const am_domainID_t domainSourceID);
+    am_Error_e enterConverter(const am_domainID_t domainID);
+    am_Error_e occupy(const am_sourceID_t sourceID, const am_sinkID_t sinkID);
+
+    IAmDatabaseHandler              &mDatabaseHandler;
+    am_TopologyParameters_s         mParameters;
+    std::mt19937                    mRandom;
+    am_sinkClass_t                  mSinkClassID;
+    am_sourceClass_t                mSourceClassID;
+    unsigned                        mCounter;           //!< used to generate unique names
+    std::vector<am_domainID_t>      mListDomainIDs;
+    std::vector<am_sourceID_t>      mListSourceIDs;     //!< the plain sources, without the hidden ones of gateways and converters
+    std::vector<am_sinkID_t>        mListSinkIDs;       //!< the plain sinks, without the hidden ones of gateways and converters
+    std::vector<am_gatewayID_t>     mListGatewayIDs;
+    std::vector<am_converterID_t>   mListConverterIDs;
+};
+
+}
+
+#endif /* CAMTOPOLOGYGENERATOR_H_ */
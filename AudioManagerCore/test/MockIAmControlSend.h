@@ -163,6 +163,14 @@ class MockIAmControlSend : public IAmControlSend {
       am_Error_e(const am_sourceID_t sourceID, const am_NotificationConfiguration_s& notificationConfiguration));
   MOCK_METHOD2(hookSystemSingleTimingInformationChanged,
       void(const am_connectionID_t connectionID, const am_timeSync_t time));
+  MOCK_METHOD2(hookSystemRegisterSinks,
+      am_Error_e(const std::vector<am_Sink_s>& listSinkData, std::vector<am_sinkID_t>& listSinkIDs));
+  MOCK_METHOD1(hookSystemDeregisterSinks,
+      am_Error_e(const std::vector<am_sinkID_t>& listSinkIDs));
+  MOCK_METHOD2(hookSystemRegisterSources,
+      am_Error_e(const std::vector<am_Source_s>& listSourceData, std::vector<am_sourceID_t>& listSourceIDs));
+  MOCK_METHOD1(hookSystemDeregisterSources,
+      am_Error_e(const std::vector<am_sourceID_t>& listSourceIDs));
   MOCK_METHOD1(removeHandle,
 	  am_Error_e(const am_Handle_s handle));       
 };
@@ -75,7 +75,7 @@ std::vector<std::string> listCommandPluginDirs;
 std::vector<std::string> listRoutingPluginDirs;
 
 // List of signals to be handled with signalfd
-std::vector<uint8_t> listOfSignalsFD = { SIGHUP, SIGTERM, SIGCHLD };
+std::vector<uint8_t> listOfSignalsFD = { SIGHUP, SIGTERM, SIGCHLD, SIGUSR1 };
 
 // commandline options used by the Audiomanager itself
 TCLAP::ValueArg<std::string>  controllerPlugin("c", "controllerPlugin", "use controllerPlugin full path with .so ending", false, CONTROLLER_PLUGIN_DIR, "string");
@@ -89,6 +89,11 @@ TCLAP::SwitchArg              dltEnable("e", "dltEnable", "Enables or disables d
 TCLAP::SwitchArg              dbusWrapperTypeBool("T", "dbusType", "DbusType to be used by CAmDbusWrapper: if option is selected, DBUS_SYSTEM is used otherwise DBUS_SESSION", false);
 TCLAP::SwitchArg              currentSettings("i", "currentSettings", "print current settings and exit", false);
 TCLAP::SwitchArg              daemonizeAM("d", "daemonize", "daemonize Audiomanager. Better use systemd...", false);
+TCLAP::SwitchArg              mainloopStatistics("S", "mainloopStatistics", "collect mainloop statistics, they are logged on SIGUSR1", false);
+TCLAP::ValueArg<unsigned int> routingThreads("t", "routingThreads", "number of threads that search routes in parallel if the controller asks for several routes at once. 0=sequential(default)", false, 0, "int");
+TCLAP::ValueArg<unsigned int> routingCostModel("M", "routingCostModel", "cost model of the route search. 0=fewest hops(default), 1=lowest delay of the existing connections", false, 0, "int");
+TCLAP::ValueArg<int16_t>      routingUnknownDelay("D", "routingUnknownDelay", "delay in ms the delay cost model assumes for edges without a known delay. Default = 0", false, 0, "int");
+TCLAP::SwitchArg              routingTrace("g", "routingTrace", "trace every route search of the controller and log what was explored, pruned and how long it took", false);
 
 int fd0, fd1, fd2;
 
@@ -177,6 +182,11 @@ void printCmdInformation()
         printf("\t                              \t\t%s\n", dirIter->c_str());
     }
 
+    printf("\tRouting threads: \t\t\t%u\n", routingThreads.getValue());
+    printf("\tRouting cost model: \t\t\t%u\n", routingCostModel.getValue());
+    printf("\tRouting unknown delay: \t\t\t%d\n", routingUnknownDelay.getValue());
+    printf("\tRouting trace: \t\t\t\t%s\n", routingTrace.getValue() ? "on" : "off");
+
     exit(0);
 }
 
@@ -224,6 +234,11 @@ void mainProgram(int argc, char *argv[])
         cmd->add(routingPluginDir);
         cmd->add(currentSettings);
         cmd->add(daemonizeAM);
+        cmd->add(mainloopStatistics);
+        cmd->add(routingThreads);
+        cmd->add(routingCostModel);
+        cmd->add(routingUnknownDelay);
+        cmd->add(routingTrace);
         cmd->add(dltEnable);
         cmd->add(dltLogFilename);
         cmd->add(dltOutput);
@@ -280,6 +295,11 @@ void mainProgram(int argc, char *argv[])
             case SIGHUP:
                 CAmControlSender::CallsetControllerRundownSafe(sig);
                 break;
+
+            /* log the mainloop statistics, see -S */
+            case SIGUSR1:
+                iSocketHandler.dumpStatistics();
+                break;
             default:
                 break;
             }
@@ -354,6 +374,18 @@ void mainProgram(int argc, char *argv[])
 #endif /*WITH_SYSTEMD_WATCHDOG*/
 
     CAmRouter iRouter(pDatabaseHandler, &iControlSender);
+    iRouter.setRoutingThreads(routingThreads.getValue());
+    if (routingCostModel.getValue() == RCM_DELAY)
+    {
+        iRouter.setCostModel(RCM_DELAY);
+    }
+    else if (routingCostModel.getValue() != RCM_HOPS)
+    {
+        logError("the routing cost model", routingCostModel.getValue(), "is not known, using the hop model");
+    }
+
+    iRouter.setUnknownDelay(routingUnknownDelay.getValue());
+    iRouter.setTraceRoutes(routingTrace.getValue());
 
 #ifdef WITH_DBUS_WRAPPER
     CAmCommandReceiver iCommandReceiver(pDatabaseHandler, &iControlSender, &iSocketHandler, &iDBusWrapper);
@@ -381,6 +413,8 @@ void mainProgram(int argc, char *argv[])
     iWatchdog.startWatchdog();
 #endif /*WITH_SYSTEMD_WATCHDOG*/
 
+    iSocketHandler.enableStatistics(mainloopStatistics.getValue());
+
     // start the mainloop here....
     iSocketHandler.start_listenting();
 }
@@ -0,0 +1,236 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include <memory>
+#include <vector>
+#include "CAmCommonAPIWrapper.h"
+#include "CAmSocketHandler.h"
+
+using namespace am;
+
+/**
+ * The stubs stand in for what a binding registers per proxy: a watch on a file descriptor with a dependent
+ * dispatch source, and a dispatch source that is prepared on wakeups. No binding or bus is needed.
+ */
+namespace
+{
+
+class CAmStubDispatchSource : public CommonAPI::DispatchSource
+{
+public:
+    explicit CAmStubDispatchSource(CAmSocketHandler *stopHandler = NULL)
+        : mpStopHandler(stopHandler)
+    {
+    }
+
+    virtual bool prepare(int64_t &timeout)
+    {
+        (void)timeout;
+        if (mpStopHandler != NULL)
+        {
+            mpStopHandler->stop_listening();
+        }
+
+        return (false);
+    }
+
+    virtual bool check()
+    {
+        return (false);
+    }
+
+    virtual bool dispatch()
+    {
+        if (mpStopHandler != NULL)
+        {
+            mpStopHandler->stop_listening();
+        }
+
+        return (false);
+    }
+
+private:
+    CAmSocketHandler *mpStopHandler;
+};
+
+class CAmStubWatch : public CommonAPI::Watch
+{
+public:
+    explicit CAmStubWatch(CommonAPI::DispatchSource *dependent)
+        : mPollFd()
+        , mListDependent(1, dependent)
+    {
+        mPollFd.fd     = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+        mPollFd.events = POLLIN;
+    }
+
+    virtual ~CAmStubWatch()
+    {
+        close(mPollFd.fd);
+    }
+
+    virtual void dispatch(unsigned int eventFlags)
+    {
+        (void)eventFlags;
+        uint64_t value;
+        benchmark::DoNotOptimize(read(mPollFd.fd, &value, sizeof(value)));
+    }
+
+    virtual const pollfd &getAssociatedFileDescriptor()
+    {
+        return (mPollFd);
+    }
+
+    virtual const std::vector<CommonAPI::DispatchSource *> &getDependentDispatchSources()
+    {
+        return (mListDependent);
+    }
+
+    virtual void addDependentDispatchSource(CommonAPI::DispatchSource *dispatchSource)
+    {
+        mListDependent.push_back(dispatchSource);
+    }
+
+    void signal()
+    {
+        const uint64_t one = 1;
+        benchmark::DoNotOptimize(write(mPollFd.fd, &one, sizeof(one)));
+    }
+
+private:
+    pollfd                                   mPollFd;
+    std::vector<CommonAPI::DispatchSource *> mListDependent;
+};
+
+/**
+ * registers the given number of stub proxies with the main loop context of the wrapper
+ */
+class CAmStubProxies
+{
+public:
+    CAmStubProxies(CAmSocketHandler &handler, const int64_t count)
+        : mpWrapper(CAmCommonAPIWrapper::instantiateOnce(&handler))
+        , mContext(mpWrapper->getMainLoopContext())
+    {
+        for (int64_t i = 0; i < count; i++)
+        {
+            mListSources.emplace_back(new CAmStubDispatchSource(&handler));
+            mListWatches.emplace_back(new CAmStubWatch(mListSources.back().get()));
+            mListIdle.emplace_back(new CAmStubDispatchSource());
+            mContext->registerWatch(mListWatches.back().get());
+            mContext->registerDispatchSource(mListIdle.back().get());
+        }
+    }
+
+    ~CAmStubProxies()
+    {
+        for (size_t i = 0; i < mListWatches.size(); i++)
+        {
+            mContext->deregisterWatch(mListWatches[i].get());
+            mContext->deregisterDispatchSource(mListIdle[i].get());
+        }
+
+        if (mStopSource)
+        {
+            mContext->deregisterDispatchSource(mStopSource.get());
+        }
+
+        mContext.reset();
+        CAmCommonAPIWrapper::deleteInstance();
+    }
+
+    /**
+     * adds a lowest priority source that stops the mainloop when it is prepared
+     */
+    void addStopSource(CAmSocketHandler &handler)
+    {
+        mStopSource.reset(new CAmStubDispatchSource(&handler));
+        mContext->registerDispatchSource(mStopSource.get(), CommonAPI::DispatchPriority::VERY_LOW);
+    }
+
+    CAmStubWatch &watch(const size_t index)
+    {
+        return (*mListWatches[index % mListWatches.size()]);
+    }
+
+    std::shared_ptr<CommonAPI::MainLoopContext> context()
+    {
+        return (mContext);
+    }
+
+private:
+    CAmCommonAPIWrapper                                *mpWrapper;
+    std::shared_ptr<CommonAPI::MainLoopContext>         mContext;
+    std::vector<std::unique_ptr<CAmStubDispatchSource> > mListSources;
+    std::vector<std::unique_ptr<CAmStubWatch> >          mListWatches;
+    std::vector<std::unique_ptr<CAmStubDispatchSource> > mListIdle;
+    std::unique_ptr<CAmStubDispatchSource>               mStopSource;
+};
+
+}
+
+/**
+ * Signals one watch out of many proxies and runs the mainloop until its dependent source was dispatched.
+ */
+static void BM_CommonAPIWatchDispatch(benchmark::State &state)
+{
+    CAmSocketHandler handler;
+    CAmStubProxies   proxies(handler, state.range(0));
+
+    // let the prepare pass requested by the registrations run once
+    handler.post([&handler]() {
+        handler.stop_listening();
+    });
+    handler.start_listenting();
+
+    size_t next = 0;
+    for (auto _ : state)
+    {
+        proxies.watch(next++).signal();
+        handler.start_listenting();
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_CommonAPIWatchDispatch)->Arg(1)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Wakes up the context, which prepares all dispatch sources of all proxies once.
+ */
+static void BM_CommonAPIWakeup(benchmark::State &state)
+{
+    CAmSocketHandler handler;
+    CAmStubProxies   proxies(handler, state.range(0));
+    proxies.addStopSource(handler);
+    handler.start_listenting();
+
+    for (auto _ : state)
+    {
+        proxies.context()->wakeup();
+        handler.start_listenting();
+    }
+
+    state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+
+BENCHMARK(BM_CommonAPIWakeup)->Arg(1)->Arg(64)->Arg(256)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,195 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdlib>
+#include "CAmDbusWrapper.h"
+#include "CAmSocketHandler.h"
+
+using namespace am;
+
+/**
+ * The D-Bus benchmarks need a session bus, for example started with
+ * dbus-run-session -- ./AmUtilitiesBenchmark --benchmark_filter=Dbus
+ */
+namespace
+{
+
+const char *BENCH_PATH      = "/org/genivi/audiomanager/benchmark";
+const char *BENCH_INTERFACE = "org.genivi.audiomanager.benchmark";
+const char *BENCH_RULE      = "type='signal',interface='org.genivi.audiomanager.benchmark'";
+
+bool haveSessionBus(benchmark::State &state)
+{
+    if (getenv("DBUS_SESSION_BUS_ADDRESS") == NULL)
+    {
+        state.SkipWithError("no session bus, run with dbus-run-session");
+        return (false);
+    }
+
+    return (true);
+}
+
+DBusMessage *newSignal()
+{
+    DBusMessage *signal = dbus_message_new_signal(BENCH_PATH, BENCH_INTERFACE, "Changed");
+    dbus_int32_t value  = 42;
+    dbus_message_append_args(signal, DBUS_TYPE_INT32, &value, DBUS_TYPE_INVALID);
+    return (signal);
+}
+
+}
+
+/**
+ * Emits a burst of signals the way command plugins used to: send and flush each one.
+ */
+static void BM_DbusSendFlushEach(benchmark::State &state)
+{
+    if (!haveSessionBus(state))
+    {
+        return;
+    }
+
+    const int64_t    batch = state.range(0);
+    CAmSocketHandler handler;
+    CAmDbusWrapper   wrapper(&handler, DBUS_BUS_SESSION, "", "");
+    DBusConnection  *connection = NULL;
+    wrapper.getDBusConnection(connection);
+
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < batch; i++)
+        {
+            DBusMessage *signal = newSignal();
+            dbus_connection_send(connection, signal, NULL);
+            dbus_connection_flush(connection);
+            dbus_message_unref(signal);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK(BM_DbusSendFlushEach)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Emits the same burst through sendBatched and lets the mainloop send it with one flush.
+ */
+static void BM_DbusSendBatched(benchmark::State &state)
+{
+    if (!haveSessionBus(state))
+    {
+        return;
+    }
+
+    const int64_t    batch = state.range(0);
+    CAmSocketHandler handler;
+    CAmDbusWrapper   wrapper(&handler, DBUS_BUS_SESSION, "", "");
+
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < batch; i++)
+        {
+            DBusMessage *signal = newSignal();
+            wrapper.sendBatched(signal);
+            dbus_message_unref(signal);
+        }
+
+        // one mainloop round, anything it did not get to is flushed right after
+        handler.post([&handler]() {
+            handler.stop_listening();
+        });
+        handler.start_listenting();
+        wrapper.flushBatched();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK(BM_DbusSendBatched)->Arg(100)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Receives a burst of signals from a second connection, dispatching the given number of messages per mainloop round.
+ */
+static void BM_DbusDispatchBatch(benchmark::State &state)
+{
+    if (!haveSessionBus(state))
+    {
+        return;
+    }
+
+    const int64_t    burst = 100;
+    CAmSocketHandler handler;
+    CAmDbusWrapper   wrapper(&handler, DBUS_BUS_SESSION, "", "");
+    wrapper.setDispatchBatch(static_cast<unsigned>(state.range(0)));
+
+    struct received_s
+    {
+        CAmSocketHandler *handler;
+        int64_t           count;
+        int64_t           expected;
+    } received = { &handler, 0, burst };
+
+    wrapper.registerSignalWatch([](DBusConnection *, DBusMessage *message, void *userData) -> DBusHandlerResult {
+            received_s *received = static_cast<received_s *>(userData);
+            if (!dbus_message_is_signal(message, BENCH_INTERFACE, "Changed"))
+            {
+                return (DBUS_HANDLER_RESULT_NOT_YET_HANDLED);
+            }
+
+            if (++received->count == received->expected)
+            {
+                received->handler->stop_listening();
+            }
+
+            return (DBUS_HANDLER_RESULT_HANDLED);
+        }, BENCH_RULE, &received);
+
+    DBusError error;
+    dbus_error_init(&error);
+    DBusConnection *sender = dbus_bus_get_private(DBUS_BUS_SESSION, &error);
+    if (sender == NULL)
+    {
+        dbus_error_free(&error);
+        state.SkipWithError("could not open the sending connection");
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        state.PauseTiming();
+        received.count = 0;
+        for (int64_t i = 0; i < burst; i++)
+        {
+            DBusMessage *signal = newSignal();
+            dbus_connection_send(sender, signal, NULL);
+            dbus_message_unref(signal);
+        }
+
+        dbus_connection_flush(sender);
+        state.ResumeTiming();
+        handler.start_listenting();
+    }
+
+    dbus_connection_close(sender);
+    dbus_connection_unref(sender);
+    state.SetItemsProcessed(state.iterations() * burst);
+}
+
+BENCHMARK(BM_DbusDispatchBatch)->Arg(1)->Arg(16)->Unit(benchmark::kMicrosecond);
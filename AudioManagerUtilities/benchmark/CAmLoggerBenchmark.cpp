@@ -0,0 +1,105 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <iostream>
+#include <streambuf>
+#include "CAmLoggerStdOut.h"
+#include "CAmLoggerFile.h"
+
+using namespace am;
+
+namespace
+{
+
+/**
+ * Swallows everything written to std::cout while it is in scope.
+ */
+class CAmDiscardStdOut : public std::streambuf
+{
+public:
+    CAmDiscardStdOut()
+        : mpOld(std::cout.rdbuf(this))
+    {
+    }
+
+    ~CAmDiscardStdOut()
+    {
+        std::cout.rdbuf(mpOld);
+    }
+
+protected:
+    int overflow(int c) override
+    {
+        return (traits_type::not_eof(c));
+    }
+
+    std::streamsize xsputn(const char *, std::streamsize count) override
+    {
+        return (count);
+    }
+
+private:
+    std::streambuf *mpOld;
+};
+
+void logMessages(benchmark::State &state, IAmLogger &logger)
+{
+    logger.registerApp("BENC", "Logger Benchmark");
+    IAmLogContext &context = logger.registerContext("BCTX", "Logger Benchmark Context");
+    int32_t        value   = 0;
+
+    for (auto _ : state)
+    {
+        context.info("benchmark message", value++, "with some payload");
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+}
+
+static void BM_LoggerStdOut(benchmark::State &state)
+{
+    CAmDiscardStdOut discard;
+    CAmLoggerStdOut  logger(LS_ON);
+    logMessages(state, logger);
+}
+
+BENCHMARK(BM_LoggerStdOut);
+
+static void BM_LoggerFile(benchmark::State &state)
+{
+    CAmLoggerFile logger(LS_ON, false, "/dev/null");
+    logMessages(state, logger);
+}
+
+BENCHMARK(BM_LoggerFile);
+
+/**
+ * Cost of a log statement that is filtered out by the log level.
+ */
+static void BM_LoggerFiltered(benchmark::State &state)
+{
+    CAmDiscardStdOut discard;
+    CAmLoggerStdOut  logger(LS_ON, true);
+    logMessages(state, logger);
+}
+
+BENCHMARK(BM_LoggerFiltered);
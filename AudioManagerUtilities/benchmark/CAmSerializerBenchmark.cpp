@@ -0,0 +1,104 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <functional>
+#include <thread>
+#include "CAmSocketHandler.h"
+#include "CAmSerializer.h"
+
+using namespace am;
+
+namespace
+{
+
+void count(int64_t *counter)
+{
+    (*counter)++;
+}
+
+/**
+ * Runs a mainloop with a serializer in a second thread, the serializer is created in the mainloop context.
+ */
+class CAmSerializerFixture
+{
+public:
+    CAmSerializerFixture()
+        : mHandler()
+        , mSerializer(&mHandler)
+        , mCounter(0)
+        , mThread(&CAmSocketHandler::start_listenting, &mHandler)
+    {
+    }
+
+    ~CAmSerializerFixture()
+    {
+        mHandler.post([this]() {
+            mHandler.stop_listening();
+        });
+        mThread.join();
+    }
+
+    CAmSocketHandler    mHandler;
+    V2::CAmSerializer   mSerializer;
+    int64_t             mCounter;
+    std::thread         mThread;
+};
+
+}
+
+/**
+ * Round trip of synchronous invocations into the mainloop.
+ */
+static void BM_SerializerSyncInvocation(benchmark::State &state)
+{
+    CAmSerializerFixture fixture;
+
+    for (auto _ : state)
+    {
+        fixture.mSerializer.syncInvocation(std::bind(&count, &fixture.mCounter));
+    }
+
+    state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(BM_SerializerSyncInvocation)->UseRealTime();
+
+/**
+ * Throughput of asynchronous invocations, each batch is drained with one synchronous invocation.
+ */
+static void BM_SerializerAsyncInvocation(benchmark::State &state)
+{
+    const int64_t        batch = state.range(0);
+    CAmSerializerFixture fixture;
+
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < batch; i++)
+        {
+            fixture.mSerializer.asyncInvocation(std::bind(&count, &fixture.mCounter));
+        }
+
+        fixture.mSerializer.syncInvocation(std::bind(&count, &fixture.mCounter));
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK(BM_SerializerAsyncInvocation)->Arg(100)->UseRealTime();
@@ -0,0 +1,144 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include <benchmark/benchmark.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+#include "CAmSocketHandler.h"
+
+using namespace am;
+
+/**
+ * Restarts a 1us timer from its own callback until a batch of expiries has been handled.
+ */
+static void BM_SocketHandlerTimerRestart(benchmark::State &state)
+{
+    const int64_t    batch = state.range(0);
+    CAmSocketHandler handler;
+    int64_t          expiries = 0;
+    sh_timerHandle_t handle   = 0;
+    timespec         timeout{0, 1000};
+
+    if (handler.addTimer(timeout, [&](const sh_timerHandle_t timer, void *) {
+            if (++expiries < batch)
+            {
+                handler.restartTimer(timer);
+            }
+            else
+            {
+                handler.stop_listening();
+            }
+        }, handle, NULL) != E_OK)
+    {
+        state.SkipWithError("addTimer failed");
+        return;
+    }
+
+    handler.stopTimer(handle);
+    for (auto _ : state)
+    {
+        expiries = 0;
+        handler.restartTimer(handle);
+        handler.start_listenting();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK(BM_SocketHandlerTimerRestart)->Arg(100)->Unit(benchmark::kMillisecond);
+
+/**
+ * Wakes up an eventfd poll and re-arms it from its dispatch until a batch of wakeups has been handled.
+ */
+static void BM_SocketHandlerFdDispatch(benchmark::State &state)
+{
+    const int64_t    batch  = state.range(0);
+    const uint64_t   one    = 1;
+    CAmSocketHandler handler;
+    int64_t          wakeups = 0;
+    sh_pollHandle_t  handle  = 0;
+    int              fd      = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+
+    if (handler.addFDPoll(fd, POLLIN, NULL,
+            [](const pollfd pfd, const sh_pollHandle_t, void *) {
+            uint64_t value;
+            benchmark::DoNotOptimize(read(pfd.fd, &value, sizeof(value)));
+        },
+            [](const sh_pollHandle_t, void *) {
+            return (true);
+        },
+            [&](const sh_pollHandle_t, void *) {
+            if (++wakeups < batch)
+            {
+                benchmark::DoNotOptimize(write(fd, &one, sizeof(one)));
+            }
+            else
+            {
+                handler.stop_listening();
+            }
+
+            return (false);
+        }, NULL, handle) != E_OK)
+    {
+        state.SkipWithError("addFDPoll failed");
+        close(fd);
+        return;
+    }
+
+    for (auto _ : state)
+    {
+        wakeups = 0;
+        benchmark::DoNotOptimize(write(fd, &one, sizeof(one)));
+        handler.start_listenting();
+    }
+
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK(BM_SocketHandlerFdDispatch)->Arg(1000)->Unit(benchmark::kMillisecond);
+
+/**
+ * Posts a batch of functions and runs the mainloop until all of them were called.
+ */
+static void BM_SocketHandlerPost(benchmark::State &state)
+{
+    const int64_t    batch = state.range(0);
+    CAmSocketHandler handler;
+    int64_t          calls = 0;
+
+    for (auto _ : state)
+    {
+        for (int64_t i = 0; i < batch; i++)
+        {
+            handler.post([&calls]() {
+                calls++;
+            });
+        }
+
+        handler.post([&handler]() {
+            handler.stop_listening();
+        });
+        handler.start_listenting();
+    }
+
+    benchmark::DoNotOptimize(calls);
+    state.SetItemsProcessed(state.iterations() * batch);
+}
+
+BENCHMARK(BM_SocketHandlerPost)->Arg(1000)->Unit(benchmark::kMillisecond);
@@ -22,6 +22,7 @@
 #include <list>
 #include <map>
 #include <queue>
+#include <vector>
 #include <memory>
 #include <cassert>
 #include <CommonAPI/CommonAPI.hpp>
@@ -47,10 +48,6 @@ class CAmSocketHandler;
 
 class CAmCommonAPIWrapper
 {
-    void commonPrepareCallback(const sh_pollHandle_t handle, void *userData);
-
-    TAmShPollPrepare<CAmCommonAPIWrapper> pCommonPrepareCallback;
-
     bool commonDispatchCallback(const sh_pollHandle_t handle, void *userData);
 
     TAmShPollDispatch<CAmCommonAPIWrapper> pCommonDispatchCallback;
@@ -67,12 +64,40 @@ class CAmCommonAPIWrapper
 
     TAmShTimerCallBack<CAmCommonAPIWrapper> pCommonTimerCallback;
 
+    void prepareTimerCallback(sh_timerHandle_t handle, void *userData);
+
+    TAmShTimerCallBack<CAmCommonAPIWrapper> pPrepareTimerCallback;
+
+    void wakeupFireCallback(const pollfd pollfd, const sh_pollHandle_t, void *);
+
+    TAmShPollFired<CAmCommonAPIWrapper> pWakeupFireCallback;
+
+    bool wakeupCheckCallback(const sh_pollHandle_t handle, void *userData);
+
+    TAmShPollCheck<CAmCommonAPIWrapper> pWakeupCheckCallback;
+
+    bool wakeupDispatchCallback(const sh_pollHandle_t handle, void *userData);
+
+    TAmShPollDispatch<CAmCommonAPIWrapper> pWakeupDispatchCallback;
+
     struct timerHandles
     {
         sh_timerHandle_t handle;
         CommonAPI::Timeout *timeout;
     };
 
+    /**
+     * one entry of the watch table, which is indexed by the file descriptor of the watch
+     */
+    struct watch_s
+    {
+        CommonAPI::Watch                        *pWatch;      //!< the watch, NULL if the fd is not watched
+        sh_pollHandle_t                          handle;      //!< the poll handle of the watch
+        std::vector<CommonAPI::DispatchSource *> listPending; //!< dependent sources that still need to be dispatched
+    };
+
+    typedef std::pair<CommonAPI::DispatchPriority, CommonAPI::DispatchSource *> dispatchSource_t;
+
     CAmSocketHandler                             *mpSocketHandler; //!< pointer to the sockethandler
 
     std::shared_ptr<CommonAPI::Runtime>           mRuntime;
@@ -82,11 +107,13 @@ class CAmCommonAPIWrapper
     CommonAPI::WatchListenerSubscription          mWatchListenerSubscription;
     CommonAPI::TimeoutSourceListenerSubscription  mTimeoutSourceListenerSubscription;
     CommonAPI::WakeupListenerSubscription         mWakeupListenerSubscription;
-    std::multimap<CommonAPI::DispatchPriority, CommonAPI::DispatchSource *> mRegisteredDispatchSources;
-    std::map<int, CommonAPI::Watch *>             mMapWatches;
-    CommonAPI::Watch                             *mWatchToCheck;
-    std::list<CommonAPI::DispatchSource *>        mSourcesToDispatch;
+    std::vector<dispatchSource_t>                 mRegisteredDispatchSources; //!< sorted by priority, highest first
+    std::vector<watch_s>                          mListWatches;               //!< flat fd to watch table
+    std::vector<CommonAPI::DispatchSource *>      mSourcesToDispatch;         //!< reused buffer for one dispatch round of a watch
     std::vector<timerHandles>                     mpListTimerhandles;
+    int                                           mWakeupFd;                  //!< eventfd that requests a prepare pass over all dispatch sources
+    sh_pollHandle_t                               mWakeupHandle;              //!< poll handle of mWakeupFd
+    sh_timerHandle_t                              mPrepareTimerHandle;        //!< repeats the prepare pass when the earliest source timeout expires
 
     void registerDispatchSource(CommonAPI::DispatchSource *dispatchSource, const CommonAPI::DispatchPriority dispatchPriority);
     void deregisterDispatchSource(CommonAPI::DispatchSource *dispatchSource);
@@ -95,6 +122,9 @@ class CAmCommonAPIWrapper
     void registerTimeout(CommonAPI::Timeout *timeout, const CommonAPI::DispatchPriority dispatchPriority);
     void deregisterTimeout(CommonAPI::Timeout *timeout);
     void wakeup();
+    void prepareDispatchSources();
+    void armPrepareTimer(const int64_t timeout);
+    watch_s *findWatch(const int fd);
 
 protected:
     CAmCommonAPIWrapper(CAmSocketHandler *socketHandler, const std::string &applicationName = "");
@@ -137,6 +167,13 @@ public:
      */
     CAmSocketHandler *getSocketHandler() const { return mpSocketHandler; }
 
+    /**
+     * \brief Getter for the main loop context that is passed to the runtime.
+     *
+     * @return The main loop context.
+     */
+    std::shared_ptr<CommonAPI::MainLoopContext> getMainLoopContext() const { return mContext; }
+
     /**
      * \brief Deprecated method. This class is used only in single connection applications and no connectionId is needed. Instead you should use bool registerService(const std::shared_ptr<TStubImp> & shStub, const std::string & domain, const std::string & instance).
      *
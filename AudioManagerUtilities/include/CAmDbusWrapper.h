@@ -25,6 +25,8 @@
 #include <string>
 #include <list>
 #include <map>
+#include <vector>
+#include <memory>
 #include "audiomanagerconfig.h"
 #include "CAmSocketHandler.h"
 
@@ -44,6 +46,10 @@ public:
     void registerCallback(const DBusObjectPathVTable *vtable, const std::string &path, void *userdata, const std::string &prefix = DBUS_SERVICE_OBJECT_PATH);
     void registerSignalWatch(DBusHandleMessageFunction handler, const std::string &rule, void *userdata);
     void getDBusConnection(DBusConnection * &connection) const;
+    void setTimeoutSlack(const unsigned slack);
+    void setDispatchBatch(const unsigned batch);
+    bool sendBatched(DBusMessage *message);
+    void flushBatched();
 
     static dbus_bool_t addWatch(DBusWatch *watch, void *userData);
     static void removeWatch(DBusWatch *watch, void *userData);
@@ -82,14 +88,34 @@ private:
     dbus_bool_t addTimeoutDelegate(DBusTimeout *timeout, void *userData);
     void removeTimeoutDelegate(DBusTimeout *timeout, void *userData);
     void toggleTimeoutDelegate(DBusTimeout *timeout, void *userData);
+    void scheduleTimeout(const size_t slot, const timespec &now);
+    void armTimeoutTimer(const timespec &now);
+
+    /**
+     * one entry of the pooled D-Bus timeout table. The slot index is stored on the DBusTimeout itself.
+     */
+    struct dbusTimeout_s
+    {
+        DBusTimeout *pTimeout; //!< the dbus timeout, NULL if the slot is free
+        timespec     expiry;   //!< absolute CLOCK_MONOTONIC expiry time
+        bool         enabled;  //!< true if the timeout is armed
+    };
 
     DBusObjectPathVTable                   mObjectPathVTable;  //!< the vpathtable
     DBusConnection                        *mpDbusConnection;   //!< pointer to the dbus connection used
     DBusError                              mDBusError;         //!< dbuserror
     std::vector<std::string>               mListNodes;         //!< holds a list of all nodes of the dbus
-    std::vector<sh_timerHandle_t *>        mpListTimerhandles; //!< pointer to the timer handles
+    std::vector<dbusTimeout_s>             mListTimeouts;      //!< pooled timeout slots
+    std::vector<size_t>                    mListFreeTimeouts;  //!< indices of free slots in mListTimeouts
+    std::vector<size_t>                    mListDueTimeouts;   //!< scratch list of the slots handled by one timer expiry
+    sh_timerHandle_t                       mTimeoutTimer;      //!< the one mainloop timer shared by all timeouts, 0 if not yet created
+    timespec                               mTimeoutTimerExpiry; //!< absolute expiry the shared timer is armed for
+    bool                                   mTimeoutTimerArmed; //!< true if the shared timer is running
+    timespec                               mTimeoutSlack;      //!< timeouts that expire within this slack are handled together
+    unsigned                               mDispatchBatch;     //!< max number of incoming messages dispatched per mainloop round
+    std::vector<DBusMessage *>             mListBatched;       //!< outgoing messages waiting for the end of the mainloop iteration
+    std::shared_ptr<CAmDbusWrapper *>      mpSelf;             //!< posted flushes only reach the wrapper while it is alive
     CAmSocketHandler                      *mpSocketHandler;    //!< pointer to the sockethandler
-    std::map<DBusWatch *, sh_pollHandle_t> mMapHandleWatch;    //!< map to the handle watches
     DBusBusType                            mDbusType;
 };
 
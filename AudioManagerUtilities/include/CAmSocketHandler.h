@@ -22,11 +22,13 @@
 #include <stdint.h>
 #include <sys/poll.h>
 #include <list>
+#include <deque>
 #include <map>
 #include <set>
 #include <signal.h>
 #include <vector>
 #include <functional>
+#include <atomic>
 #include <sys/signalfd.h>
 #include <audiomanagerconfig.h>
 #include "audiomanagertypes.h"
@@ -38,6 +40,7 @@
 # include <stdexcept>
 # include <unistd.h>
 # include <fcntl.h>
+# include <sys/timerfd.h>
 
 #endif // ifdef WITH_TIMERFD
 
@@ -47,10 +50,106 @@ namespace am
 #define MAX_NS          1000000000L
 #define MAX_TIMERHANDLE UINT16_MAX
 #define MAX_POLLHANDLE  UINT16_MAX
+#define SH_NO_SLOT      UINT32_MAX //!< marks an unused link of a dispatch queue
+
+#ifndef SH_DISPATCH_BUDGET
+# define SH_DISPATCH_BUDGET 32u //!< default number of dispatch calls per mainloop iteration
+#endif
 
 typedef uint16_t        sh_pollHandle_t;  //!< this is a handle for a filedescriptor to be used with the SocketHandler
 typedef sh_pollHandle_t sh_timerHandle_t; //!< this is a handle for a timer to be used with the SocketHandler
 
+/**
+ * dispatch priority of a poll handle, the levels match CommonAPI::DispatchPriority
+ */
+enum sh_priority_e : uint8_t
+{
+    SH_PRIORITY_VERY_HIGH = 0u,
+    SH_PRIORITY_HIGH      = 1u,
+    SH_PRIORITY_DEFAULT   = 2u,
+    SH_PRIORITY_LOW       = 3u,
+    SH_PRIORITY_VERY_LOW  = 4u,
+    SH_PRIORITY_MAX       = 5u
+};
+
+#define SH_LATENESS_BUCKETS 6u //!< timer lateness buckets: <0.1ms, <1ms, <10ms, <100ms, <1s, >=1s
+
+/**
+ * mainloop statistics of one callback of a poll
+ */
+struct sh_callbackStatistics_s
+{
+    uint64_t calls;   //!< number of calls
+    uint64_t totalNs; //!< time spent in the callback
+    uint64_t maxNs;   //!< longest single call
+    sh_callbackStatistics_s()
+        : calls(0)
+        , totalNs(0)
+        , maxNs(0)
+    {}
+};
+
+/**
+ * mainloop statistics of a poll
+ */
+struct sh_pollStatistics_s
+{
+    sh_pollHandle_t handle;
+    int fd;
+    sh_callbackStatistics_s fire;
+    sh_callbackStatistics_s check;
+    sh_callbackStatistics_s dispatch;
+    sh_pollStatistics_s()
+        : handle(0)
+        , fd(-1)
+        , fire()
+        , check()
+        , dispatch()
+    {}
+};
+
+/**
+ * mainloop statistics of a timer
+ */
+struct sh_timerStatistics_s
+{
+    sh_timerHandle_t handle;
+    uint64_t expiries;                      //!< number of measured expiries
+    uint64_t maxLatenessNs;                 //!< latest expiry
+    uint64_t lateness[SH_LATENESS_BUCKETS]; //!< histogram of the expiry lateness
+    sh_timerStatistics_s()
+        : handle(0)
+        , expiries(0)
+        , maxLatenessNs(0)
+        , lateness()
+    {}
+};
+
+/**
+ * mainloop statistics, see CAmSocketHandler::enableStatistics
+ */
+struct sh_statistics_s
+{
+    bool enabled;
+    uint64_t iterations;                      //!< number of ppoll wakeups
+    uint64_t blockedNs;                       //!< time spent blocked in ppoll
+    uint64_t workingNs;                       //!< time spent between the ppoll calls
+    uint64_t longestCallbackNs;               //!< longest single fire, check or dispatch call
+    sh_pollHandle_t longestCallbackHandle;    //!< poll which made the longest call
+    std::vector<sh_pollStatistics_s> polls;   //!< all registered polls
+    std::vector<sh_timerStatistics_s> timers; //!< all registered timers
+    sh_statistics_s()
+        : enabled(false)
+        , iterations(0)
+        , blockedNs(0)
+        , workingNs(0)
+        , longestCallbackNs(0)
+        , longestCallbackHandle(0)
+        , polls()
+        , timers()
+    {}
+};
+
 /**
  * prototype for poll prepared callback
  */
@@ -236,8 +335,8 @@ class CAmSocketHandler
         ADD     = 0u, // new, uninitialized element which needs to be added to ppoll array
         UPDATE  = 1u, // update of event information therefore update ppoll array
         VALID   = 2u, // it is a valid element in ppoll array
-        REMOVE  = 3u, // remove from ppoll array and internal map
-        INVALID = 4u  // uninit element requested to be removed from internal map only
+        REMOVE  = 3u, // remove from ppoll array and free the slot
+        INVALID = 4u  // free slot, can be reused by the next registration
     } poll_states_e;
 
     struct sh_poll_s //!< struct that holds information about polls
@@ -250,6 +349,10 @@ class CAmSocketHandler
         std::function<bool(const sh_pollHandle_t handle, void *userData)> dispatchCB;                   // dispatch callback
         void *userData;
         poll_states_e state;
+        sh_priority_e priority;                                                                         //!< dispatch priority
+        bool dispatchPending;                                                                           //!< true while queued for dispatching
+        uint32_t nextDispatch;                                                                          //!< slot of the next poll in the dispatch queue
+        sh_pollStatistics_s statistics;                                                                 //!< only collected if enabled
 
         sh_poll_s()
             : handle(0)
@@ -260,9 +363,29 @@ class CAmSocketHandler
             , dispatchCB()
             , userData(0)
             , state(ADD)
+            , priority(SH_PRIORITY_DEFAULT)
+            , dispatchPending(false)
+            , nextDispatch(SH_NO_SLOT)
+            , statistics()
+        {}
+    };
+
+    struct sh_dispatchQueue_s //!< intrusive fifo of slots waiting for dispatching
+    {
+        uint32_t head;
+        uint32_t tail;
+        sh_dispatchQueue_s()
+            : head(SH_NO_SLOT)
+            , tail(SH_NO_SLOT)
         {}
     };
 
+    struct sh_post_s //!< function posted to the mainloop
+    {
+        sh_post_s *next;
+        std::function<void()> function;
+    };
+
     struct sh_timer_s //!< struct that holds information of timers
     {
         sh_timerHandle_t handle; //!< the handle of the timer
@@ -274,6 +397,8 @@ class CAmSocketHandler
 #endif
         std::function<void(const sh_timerHandle_t handle, void *userData)> callback; // timer callback
         void *userData;
+        timespec expiry;                 //!< expected expiry, only set if statistics are enabled
+        sh_timerStatistics_s statistics; //!< only collected if enabled
         sh_timer_s()
             : handle(0)
 #ifdef WITH_TIMERFD
@@ -282,6 +407,8 @@ class CAmSocketHandler
             , countdown()
             , callback()
             , userData(0)
+            , expiry()
+            , statistics()
         {}
     };
 
@@ -311,7 +438,8 @@ class CAmSocketHandler
 
     typedef std::reverse_iterator<sh_timer_s> rListTimerIter;         //!< typedef for reverseiterator on timer lists
     typedef std::vector<pollfd>               VectorPollfd_t;         //!< vector of filedescriptors
-    typedef std::map<int, sh_poll_s>          MapShPoll_t;            //!< list for the callbacks
+    typedef std::deque<sh_poll_s>             DequeShPoll_t;          //!< slots for the callbacks, grows without moving elements
+    typedef std::vector<uint32_t>             VectorSlot_t;           //!< list of slots
     typedef std::vector<sh_signal_s>          VectorSignalHandlers_t; //!< list for the callbacks
 
     typedef enum : uint8_t
@@ -325,7 +453,9 @@ class CAmSocketHandler
     int                    mEventFd;
     int                    mSignalFd;
     bool                   mDispatchDone; // this starts / stops the mainloop
-    MapShPoll_t            mMapShPoll;    //!< list that holds all information for the ppoll
+    DequeShPoll_t          mPolls;        //!< registration table, one slot per filedescriptor
+    VectorPollfd_t         mPollFds;      //!< the polling array for ppoll, index equals the slot
+    VectorSlot_t           mReadyPolls;   //!< slots which fired in the current iteration
 
     sh_identifier_s        mSetPollKeys;  //! A set of all used ppoll keys
     sh_identifier_s        mSetTimerKeys; //! A set of all used timer keys
@@ -336,6 +466,10 @@ class CAmSocketHandler
     sh_identifier_s        mSetSignalhandlerKeys; //! A set of all used signal handler keys
     VectorSignalHandlers_t mSignalHandlers;
     internal_codes_t       mInternalCodes;
+    sh_dispatchQueue_s     mDispatchQueues[SH_PRIORITY_MAX]; //!< one round robin queue per priority
+    unsigned               mDispatchBudget; //!< max dispatch calls per iteration
+    std::atomic<sh_post_s *> mPosted; //!< lock-free stack of posted functions, newest first
+    sh_statistics_s        mStatistics;     //!< mainloop counters, the lists stay empty
 #ifndef WITH_TIMERFD
     timespec               mStartTime; //!< here the actual time is saved for timecorrection
 #endif
@@ -345,6 +479,17 @@ private:
     void wakeupWorker(const std::string &func, const uint64_t value = 1u);
 
     timespec *insertTime(timespec &buffertime);
+    bool dispatchPending() const;
+    void queueDispatch(const uint32_t slot);
+    void dispatch();
+    void dequeueDispatch(const uint32_t slot);
+    void freeSlot(sh_poll_s &poll);
+    void runPosted();
+    void postAt(const timespec &deadline, const std::function<void()> &function);
+    static void callPosted(const std::function<void()> &function);
+    void recordCallback(sh_callbackStatistics_s &statistics, const sh_pollHandle_t handle, const timespec &start);
+    void armStatistics(sh_timer_s &timer, const timespec &timeout);
+    void timerExpired(const sh_timerHandle_t handle);
 
 #ifdef WITH_TIMERFD
     am_Error_e createTimeFD(const itimerspec &timeouts, int &fd);
@@ -363,6 +508,7 @@ private:
     {
         return ((a.countdown.tv_sec == b.countdown.tv_sec) ? (a.countdown.tv_nsec < b.countdown.tv_nsec) : (a.countdown.tv_sec < b.countdown.tv_sec));
     }
+#endif  // ifdef WITH_TIMERFD
 
     /**
      * Subtracts b from a
@@ -415,6 +561,7 @@ private:
         return (result);
     }
 
+#ifndef WITH_TIMERFD
     /**
      * comapares timespec values
      * @param a
@@ -507,6 +654,8 @@ public:
     am_Error_e addFDPoll(const int fd, const short event, IAmShPollPrepare *prepare, IAmShPollFired *fired, IAmShPollCheck *check, IAmShPollDispatch *dispatch, void *userData, sh_pollHandle_t &handle);
     am_Error_e removeFDPoll(const sh_pollHandle_t handle);
     am_Error_e updateEventFlags(const sh_pollHandle_t handle, const short events);
+    am_Error_e setPollPriority(const sh_pollHandle_t handle, const sh_priority_e priority);
+    void setDispatchBudget(const unsigned budget);
     am_Error_e addSignalHandler(std::function<void(const sh_pollHandle_t handle, const signalfd_siginfo &info, void *userData)> callback, sh_pollHandle_t &handle, void *userData);
     am_Error_e removeSignalHandler(const sh_pollHandle_t handle);
 
@@ -528,6 +677,12 @@ public:
     am_Error_e restartTimer(const sh_timerHandle_t handle);
     am_Error_e updateTimer(const sh_timerHandle_t handle, const timespec &timeouts);
     am_Error_e stopTimer(const sh_timerHandle_t handle);
+    am_Error_e post(std::function<void()> function);
+    am_Error_e postDelayed(const timespec &delay, std::function<void()> function);
+    void enableStatistics(const bool enable);
+    void resetStatistics();
+    void getStatistics(sh_statistics_s &statistics) const;
+    void dumpStatistics() const;
     void start_listenting();
     void stop_listening();
     void exit_mainloop();
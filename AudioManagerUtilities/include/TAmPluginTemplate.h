@@ -25,7 +25,7 @@
 #define PLUGINTEMPLATE_H_
 
 #include <dlfcn.h>
-#include <libgen.h>
+#include <string>
 #include "CAmLogWrapper.h"
 
 namespace am
@@ -43,9 +43,8 @@ T *getCreateFunction(const std::string &libname, void * &libraryHandle)
 
     logInfo("getCreateFunction : Trying to load library with name: ", libname);
 
-    // cut off directories
-    char       *fileWithPath = const_cast<char *>(libname.c_str());
-    std::string libFileName  = basename(fileWithPath);
+    // cut off directories, without basename() which may modify its argument
+    std::string libFileName = libname.substr(libname.find_last_of('/') + 1);
 
     // cut off "lib" in front and cut off .so end"
     std::string createFunctionName = libFileName.substr(3, libFileName.length() - 6) + "Factory";
@@ -98,9 +97,8 @@ T *getDestroyFunction(const std::string &libname, void *libraryHandle)
 {
     logInfo("destroy : Trying to destroy : ", libname);
 
-    // cut off directories
-    char       *fileWithPath = const_cast<char *>(libname.c_str());
-    std::string libFileName  = basename(fileWithPath);
+    // cut off directories, without basename() which may modify its argument
+    std::string libFileName = libname.substr(libname.find_last_of('/') + 1);
 
     // cut off "lib" in front and cut off .so end"
     std::string destroyFunctionName = "destroy" + libFileName.substr(3, libFileName.length() - 6);
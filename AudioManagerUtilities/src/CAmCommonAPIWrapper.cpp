@@ -22,6 +22,9 @@
 #include <cstdlib>
 #include <stdexcept>
 #include <poll.h>
+#include <unistd.h>
+#include <sys/eventfd.h>
+#include <stdint.h>
 #include <tuple>
 #include <sstream>
 #include <vector>
@@ -35,15 +38,28 @@ namespace am
 static CAmCommonAPIWrapper *pSingleCommonAPIInstance = NULL;
 
 CAmCommonAPIWrapper::CAmCommonAPIWrapper(CAmSocketHandler *socketHandler, const std::string &applicationName)
-    : pCommonPrepareCallback(this, &CAmCommonAPIWrapper::commonPrepareCallback)
-    , pCommonDispatchCallback(this, &CAmCommonAPIWrapper::commonDispatchCallback)
+    : pCommonDispatchCallback(this, &CAmCommonAPIWrapper::commonDispatchCallback)
     , pCommonFireCallback(this, &CAmCommonAPIWrapper::commonFireCallback)
     , pCommonCheckCallback(this, &CAmCommonAPIWrapper::commonCheckCallback)
     , pCommonTimerCallback(this, &CAmCommonAPIWrapper::commonTimerCallback)
+    , pPrepareTimerCallback(this, &CAmCommonAPIWrapper::prepareTimerCallback)
+    , pWakeupFireCallback(this, &CAmCommonAPIWrapper::wakeupFireCallback)
+    , pWakeupCheckCallback(this, &CAmCommonAPIWrapper::wakeupCheckCallback)
+    , pWakeupDispatchCallback(this, &CAmCommonAPIWrapper::wakeupDispatchCallback)
     , mpSocketHandler(socketHandler)
-    , mWatchToCheck(NULL)
+    , mWakeupFd(-1)
+    , mWakeupHandle(0)
+    , mPrepareTimerHandle(0)
 {
     assert(NULL != socketHandler);
+
+    // dispatch sources are only prepared when this fd is signalled, everything else is driven by watches and timeouts
+    mWakeupFd = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    if ((mWakeupFd < 0) || (mpSocketHandler->addFDPoll(mWakeupFd, POLLIN, NULL, &pWakeupFireCallback, &pWakeupCheckCallback, &pWakeupDispatchCallback, NULL, mWakeupHandle) != E_OK))
+    {
+        logError(__func__, "registering the wakeup fd failed");
+    }
+
 // Get the runtime
     mRuntime = CommonAPI::Runtime::get();
     assert(NULL != mRuntime);
@@ -71,6 +87,8 @@ CAmCommonAPIWrapper::CAmCommonAPIWrapper(CAmSocketHandler *socketHandler, const
     mTimeoutSourceListenerSubscription = mContext->subscribeForTimeouts(
             std::bind(&CAmCommonAPIWrapper::registerTimeout, this, std::placeholders::_1, std::placeholders::_2),
             std::bind(&CAmCommonAPIWrapper::deregisterTimeout, this, std::placeholders::_1));
+    mWakeupListenerSubscription = mContext->subscribeForWakeupEvents(
+            std::bind(&CAmCommonAPIWrapper::wakeup, this));
 }
 
 CAmCommonAPIWrapper::~CAmCommonAPIWrapper()
@@ -78,9 +96,24 @@ CAmCommonAPIWrapper::~CAmCommonAPIWrapper()
     mContext->unsubscribeForDispatchSources(mDispatchSourceListenerSubscription);
     mContext->unsubscribeForWatches(mWatchListenerSubscription);
     mContext->unsubscribeForTimeouts(mTimeoutSourceListenerSubscription);
+    mContext->unsubscribeForWakeupEvents(mWakeupListenerSubscription);
     mContext.reset();
+    if (mPrepareTimerHandle != 0)
+    {
+        mpSocketHandler->removeTimer(mPrepareTimerHandle);
+    }
+
+    if (mWakeupHandle != 0)
+    {
+        mpSocketHandler->removeFDPoll(mWakeupHandle);
+    }
+
+    if (mWakeupFd >= 0)
+    {
+        close(mWakeupFd);
+    }
+
     mpSocketHandler = NULL;
-    mWatchToCheck   = NULL;
 }
 
 CAmCommonAPIWrapper *CAmCommonAPIWrapper::instantiateOnce(CAmSocketHandler *socketHandler, const std::string &applicationName)
@@ -127,103 +160,237 @@ CAmCommonAPIWrapper *CAmCommonAPIWrapper::getInstance()
     return pSingleCommonAPIInstance;
 }
 
+/**
+ * returns the table entry of a watched fd
+ * @param fd the file descriptor
+ * @return the entry or NULL if the fd is not watched
+ */
+CAmCommonAPIWrapper::watch_s *CAmCommonAPIWrapper::findWatch(const int fd)
+{
+    if ((fd < 0) || (static_cast<size_t>(fd) >= mListWatches.size()) || (mListWatches[fd].pWatch == NULL))
+    {
+        return (NULL);
+    }
+
+    return (&mListWatches[fd]);
+}
+
 bool CAmCommonAPIWrapper::commonDispatchCallback(const sh_pollHandle_t handle, void *userData)
 {
     (void)handle;
-    (void)userData;
+    const int fd    = static_cast<int>(reinterpret_cast<intptr_t>(userData));
+    watch_s  *entry = findWatch(fd);
+    if (entry == NULL)
+    {
+        return (false);
+    }
 
-    std::list<CommonAPI::DispatchSource *>::iterator iterator(mSourcesToDispatch.begin());
-    for (; iterator != mSourcesToDispatch.end();)
+    // dispatching may (de)register watches and sources and move the table, so work on a swapped buffer
+    CommonAPI::Watch *watch = entry->pWatch;
+    mSourcesToDispatch.clear();
+    mSourcesToDispatch.swap(entry->listPending);
+    for (size_t index = 0; index < mSourcesToDispatch.size(); ++index)
     {
-        CommonAPI::DispatchSource *source = *iterator;
-        if (!source->dispatch())
-        {
-            iterator = mSourcesToDispatch.erase(iterator);
-        }
-        else
+        CommonAPI::DispatchSource *source = mSourcesToDispatch[index];
+        if ((source != NULL) && source->dispatch() && ((entry = findWatch(fd)) != NULL) && (entry->pWatch == watch))
         {
-            iterator++;
+            entry->listPending.push_back(source);
         }
     }
 
-    if (!mSourcesToDispatch.empty())
+    // sources that have more to do are dispatched again in the next round, at the priority of the watch
+    entry = findWatch(fd);
+    return ((entry != NULL) && (entry->pWatch == watch) && !entry->listPending.empty());
+}
+
+bool CAmCommonAPIWrapper::commonCheckCallback(const sh_pollHandle_t, void *userData)
+{
+    watch_s *entry = findWatch(static_cast<int>(reinterpret_cast<intptr_t>(userData)));
+    if (entry == NULL)
+    {
+        return (false);
+    }
+
+    const std::vector<CommonAPI::DispatchSource *> &dependent = entry->pWatch->getDependentDispatchSources();
+    for (std::vector<CommonAPI::DispatchSource *>::const_iterator it = dependent.begin(); it != dependent.end(); ++it)
     {
-        return (true);
+        if (std::find(entry->listPending.begin(), entry->listPending.end(), *it) == entry->listPending.end())
+        {
+            entry->listPending.push_back(*it);
+        }
     }
 
-    return false;
+    return (!entry->listPending.empty());
 }
 
-bool CAmCommonAPIWrapper::commonCheckCallback(const sh_pollHandle_t, void *)
+void CAmCommonAPIWrapper::commonFireCallback(const pollfd pollfd, const sh_pollHandle_t, void *)
 {
-    std::vector<CommonAPI::DispatchSource *> vecDispatch = mWatchToCheck->getDependentDispatchSources();
-    mSourcesToDispatch.insert(mSourcesToDispatch.end(), vecDispatch.begin(), vecDispatch.end());
+    watch_s *entry = findWatch(pollfd.fd);
+    if (entry == NULL)
+    {
+        logInfo(__PRETTY_FUNCTION__, "no watch for fd", pollfd.fd);
+        return;
+    }
 
-    return (mWatchToCheck || !mSourcesToDispatch.empty());
+    entry->pWatch->dispatch(pollfd.revents);
 }
 
-void CAmCommonAPIWrapper::commonFireCallback(const pollfd pollfd, const sh_pollHandle_t, void *)
+/**
+ * asks for a prepare pass over all registered dispatch sources in the next mainloop iteration.
+ * Can be called from any thread.
+ */
+void CAmCommonAPIWrapper::wakeup()
 {
-    mWatchToCheck = NULL;
-    try
+    const uint64_t value = 1u;
+    if ((mWakeupFd >= 0) && (write(mWakeupFd, &value, sizeof(value)) < 0))
     {
-        mWatchToCheck = mMapWatches.at(pollfd.fd);
+        logError(__func__, "could not signal the wakeup fd");
     }
-    catch (const std::out_of_range &error)
+}
+
+void CAmCommonAPIWrapper::wakeupFireCallback(const pollfd pollfd, const sh_pollHandle_t, void *)
+{
+    uint64_t value;
+    if (read(pollfd.fd, &value, sizeof(value)) < 0)
     {
-        logInfo(__PRETTY_FUNCTION__, error.what());
-        return;
+        logInfo(__PRETTY_FUNCTION__, "nothing to read");
     }
+}
 
-    mWatchToCheck->dispatch(pollfd.revents);
+bool CAmCommonAPIWrapper::wakeupCheckCallback(const sh_pollHandle_t, void *)
+{
+    return (true);
 }
 
-void CAmCommonAPIWrapper::commonPrepareCallback(const sh_pollHandle_t, void *)
+bool CAmCommonAPIWrapper::wakeupDispatchCallback(const sh_pollHandle_t, void *)
 {
-    for (auto dispatchSourceIterator = mRegisteredDispatchSources.begin();
-         dispatchSourceIterator != mRegisteredDispatchSources.end();
-         dispatchSourceIterator++)
+    prepareDispatchSources();
+    return (false);
+}
+
+/**
+ * prepares all registered dispatch sources in priority order and dispatches those that are ready.
+ * Sources that are not ready yet may ask to be prepared again after a timeout, the earliest of these
+ * timeouts arms the prepare timer.
+ */
+void CAmCommonAPIWrapper::prepareDispatchSources()
+{
+    int64_t nextTimeout(CommonAPI::TIMEOUT_INFINITE);
+
+    // index based, dispatching may (de)register sources
+    for (size_t index = 0; index < mRegisteredDispatchSources.size(); ++index)
     {
-        int64_t dispatchTimeout(CommonAPI::TIMEOUT_INFINITE);
-        if (dispatchSourceIterator->second->prepare(dispatchTimeout))
+        CommonAPI::DispatchSource *source = mRegisteredDispatchSources[index].second;
+        int64_t                    dispatchTimeout(CommonAPI::TIMEOUT_INFINITE);
+        if (source->prepare(dispatchTimeout))
         {
-            while (dispatchSourceIterator->second->dispatch())
+            while (source->dispatch())
             {
             }
         }
+        else if ((dispatchTimeout != CommonAPI::TIMEOUT_INFINITE) && (dispatchTimeout >= 0) &&
+                 ((nextTimeout == CommonAPI::TIMEOUT_INFINITE) || (dispatchTimeout < nextTimeout)))
+        {
+            nextTimeout = dispatchTimeout;
+        }
     }
+
+    armPrepareTimer(nextTimeout);
+}
+
+/**
+ * arms the prepare timer with the given timeout in ms, or stops it if the timeout is infinite
+ */
+void CAmCommonAPIWrapper::armPrepareTimer(const int64_t timeout)
+{
+    if (CommonAPI::TIMEOUT_INFINITE == timeout)
+    {
+        if (mPrepareTimerHandle != 0)
+        {
+            mpSocketHandler->stopTimer(mPrepareTimerHandle);
+        }
+
+        return;
+    }
+
+    timespec pollTimeout;
+    if (CommonAPI::TIMEOUT_NONE == timeout)// prepare again as soon as possible
+    {
+        pollTimeout.tv_sec  = 0;
+        pollTimeout.tv_nsec = 1000000;
+    }
+    else
+    {
+        pollTimeout.tv_sec  = timeout / 1000;
+        pollTimeout.tv_nsec = (timeout % 1000) * 1000000;
+    }
+
+    if (mPrepareTimerHandle == 0)
+    {
+        if (mpSocketHandler->addTimer(pollTimeout, &pPrepareTimerCallback, mPrepareTimerHandle, NULL) != E_OK)
+        {
+            logError(__func__, "adding the prepare timer failed");
+            mPrepareTimerHandle = 0;
+        }
+    }
+    else if (mpSocketHandler->updateTimer(mPrepareTimerHandle, pollTimeout) != E_OK)
+    {
+        logError(__func__, "updating the prepare timer failed");
+    }
+}
+
+void CAmCommonAPIWrapper::prepareTimerCallback(sh_timerHandle_t handle, void *userData)
+{
+    (void)handle;
+    (void)userData;
+    prepareDispatchSources();
 }
 
 void CAmCommonAPIWrapper::registerDispatchSource(CommonAPI::DispatchSource *dispatchSource, const CommonAPI::DispatchPriority dispatchPriority)
 {
-    mRegisteredDispatchSources.insert({dispatchPriority, dispatchSource});
+    // keep the insertion order within one priority, as the multimap did before
+    std::vector<dispatchSource_t>::iterator position = std::upper_bound(mRegisteredDispatchSources.begin(), mRegisteredDispatchSources.end(), dispatchPriority,
+            [](const CommonAPI::DispatchPriority priority, const dispatchSource_t &item) {
+            return (priority < item.first);
+        });
+    mRegisteredDispatchSources.insert(position, dispatchSource_t(dispatchPriority, dispatchSource));
+
+    // the new source may already have something to dispatch
+    wakeup();
 }
 
 void CAmCommonAPIWrapper::deregisterDispatchSource(CommonAPI::DispatchSource *dispatchSource)
 {
-    for (auto dispatchSourceIterator = mRegisteredDispatchSources.begin();
-         dispatchSourceIterator != mRegisteredDispatchSources.end();
-         dispatchSourceIterator++)
+    for (std::vector<dispatchSource_t>::iterator it = mRegisteredDispatchSources.begin(); it != mRegisteredDispatchSources.end(); ++it)
     {
-
-        if (dispatchSourceIterator->second == dispatchSource)
+        if (it->second == dispatchSource)
         {
-            mRegisteredDispatchSources.erase(dispatchSourceIterator);
+            mRegisteredDispatchSources.erase(it);
             break;
         }
     }
+
+    // a watch must not dispatch a source that is gone, not even in the round that is running
+    for (std::vector<watch_s>::iterator it = mListWatches.begin(); it != mListWatches.end(); ++it)
+    {
+        it->listPending.erase(std::remove(it->listPending.begin(), it->listPending.end(), dispatchSource), it->listPending.end());
+    }
+
+    std::replace(mSourcesToDispatch.begin(), mSourcesToDispatch.end(), dispatchSource, static_cast<CommonAPI::DispatchSource *>(NULL));
 }
 
 void CAmCommonAPIWrapper::deregisterWatch(CommonAPI::Watch *watch)
 {
-    for (std::map<int, CommonAPI::Watch *>::iterator iter(mMapWatches.begin()); iter != mMapWatches.end(); iter++)
+    watch_s *entry = findWatch(watch->getAssociatedFileDescriptor().fd);
+    if ((entry == NULL) || (entry->pWatch != watch))
     {
-        if (iter->second == watch)
-        {
-            mMapWatches.erase(iter);
-            break;
-        }
+        return;
     }
+
+    mpSocketHandler->removeFDPoll(entry->handle);
+    entry->pWatch = NULL;
+    entry->handle = 0;
+    entry->listPending.clear();
 }
 
 void CAmCommonAPIWrapper::registerTimeout(CommonAPI::Timeout *timeout, const CommonAPI::DispatchPriority)
@@ -270,38 +437,73 @@ void CAmCommonAPIWrapper::deregisterTimeout(CommonAPI::Timeout *timeout)
         if (iter->timeout == timeout)
         {
             mpSocketHandler->removeTimer(iter->handle);
+            *iter = mpListTimerhandles.back();
+            mpListTimerhandles.pop_back();
+            break;
         }
     }
 }
 
-void CAmCommonAPIWrapper::registerWatch(CommonAPI::Watch *watch, const CommonAPI::DispatchPriority)
+static sh_priority_e convertPriority(const CommonAPI::DispatchPriority dispatchPriority)
+{
+    switch (dispatchPriority)
+    {
+    case CommonAPI::DispatchPriority::VERY_HIGH:
+        return SH_PRIORITY_VERY_HIGH;
+    case CommonAPI::DispatchPriority::HIGH:
+        return SH_PRIORITY_HIGH;
+    case CommonAPI::DispatchPriority::LOW:
+        return SH_PRIORITY_LOW;
+    case CommonAPI::DispatchPriority::VERY_LOW:
+        return SH_PRIORITY_VERY_LOW;
+    default:
+        return SH_PRIORITY_DEFAULT;
+    }
+}
+
+void CAmCommonAPIWrapper::registerWatch(CommonAPI::Watch *watch, const CommonAPI::DispatchPriority dispatchPriority)
 {
     logInfo(__PRETTY_FUNCTION__);
     pollfd          pollfd_(watch->getAssociatedFileDescriptor());
     sh_pollHandle_t handle(0);
 
-    am_Error_e error = mpSocketHandler->addFDPoll(pollfd_.fd, pollfd_.events, &pCommonPrepareCallback, &pCommonFireCallback, &pCommonCheckCallback, &pCommonDispatchCallback, watch, handle);
+    if (pollfd_.fd < 0)
+    {
+        logError(__func__, "watch without file descriptor");
+        return;
+    }
 
-    // if everything is alright, add the watch and the handle to our map so we know this relationship
+    // the fd travels as user data, so fire, check and dispatch find their entry without a search
+    am_Error_e error = mpSocketHandler->addFDPoll(pollfd_.fd, pollfd_.events, NULL, &pCommonFireCallback, &pCommonCheckCallback, &pCommonDispatchCallback, reinterpret_cast<void *>(static_cast<intptr_t>(pollfd_.fd)), handle);
+
+    // if everything is alright, add the watch and the handle to our table so we know this relationship
     if (error != am_Error_e::E_OK || handle == 0)
     {
         logError(__func__, "entering watch failed");
     }
     else
     {
-        mMapWatches.insert(std::make_pair(pollfd_.fd, watch));
+        mpSocketHandler->setPollPriority(handle, convertPriority(dispatchPriority));
+        if (static_cast<size_t>(pollfd_.fd) >= mListWatches.size())
+        {
+            watch_s unused;
+            unused.pWatch = NULL;
+            unused.handle = 0;
+            mListWatches.resize(pollfd_.fd + 1, unused);
+        }
+
+        mListWatches[pollfd_.fd].pWatch = watch;
+        mListWatches[pollfd_.fd].handle = handle;
+        mListWatches[pollfd_.fd].listPending.clear();
     }
 }
 
-void CAmCommonAPIWrapper::commonTimerCallback(sh_timerHandle_t handle, void *)
+void CAmCommonAPIWrapper::commonTimerCallback(sh_timerHandle_t handle, void *userData)
 {
-    for ( std::vector<timerHandles>::iterator iter(mpListTimerhandles.begin()); iter != mpListTimerhandles.end(); iter++)
-    {
-        if (iter->handle == handle)
-        {
-            iter->timeout->dispatch();
-        }
-    }
+    // the timeout is the user data of its timer, it is removed together with the timer in deregisterTimeout
+    (void)handle;
+    assert(userData != NULL);
+    static_cast<CommonAPI::Timeout *>(userData)->dispatch();
 }
 
 CAmCommonAPIWrapper *(*getCAPI)() = CAmCommonAPIWrapper::getInstance;
@@ -29,6 +29,7 @@
 #include <cassert>
 #include <cstdlib>
 #include <stdexcept>
+#include <stdint.h>
 #include "CAmLogWrapper.h"
 #include "CAmSocketHandler.h"
 
@@ -49,6 +50,51 @@ namespace am
 
 CAmDbusWrapper *CAmDbusWrapper::mpReference = NULL;
 
+namespace
+{
+
+inline timespec ms2timespec(const int ms)
+{
+    timespec result;
+    result.tv_sec  = ms / 1000;
+    result.tv_nsec = (ms % 1000) * 1000000;
+    return (result);
+}
+
+inline timespec addTimespec(const timespec &a, const timespec &b)
+{
+    timespec result;
+    result.tv_sec  = a.tv_sec + b.tv_sec;
+    result.tv_nsec = a.tv_nsec + b.tv_nsec;
+    if (result.tv_nsec >= 1000000000)
+    {
+        result.tv_sec++;
+        result.tv_nsec -= 1000000000;
+    }
+
+    return (result);
+}
+
+inline bool isBefore(const timespec &a, const timespec &b)
+{
+    return ((a.tv_sec < b.tv_sec) || ((a.tv_sec == b.tv_sec) && (a.tv_nsec < b.tv_nsec)));
+}
+
+/**
+ * the slot index is stored on the DBusTimeout shifted by one, so that NULL still means "not registered"
+ */
+inline void *slot2data(const size_t slot)
+{
+    return ((void *)(uintptr_t)(slot + 1));
+}
+
+inline size_t data2slot(void *data)
+{
+    return ((size_t)(uintptr_t)data - 1);
+}
+
+}
+
 CAmDbusWrapper::CAmDbusWrapper(CAmSocketHandler *socketHandler, DBusBusType type, const std::string &prefix, const std::string &objectPath)
     : pDbusPrepareCallback(this, &CAmDbusWrapper::dbusPrepareCallback)
     , pDbusDispatchCallback(this, &CAmDbusWrapper::dbusDispatchCallback)
@@ -58,7 +104,16 @@ CAmDbusWrapper::CAmDbusWrapper(CAmSocketHandler *socketHandler, DBusBusType type
     , mpDbusConnection(0)
     , mDBusError()
     , mListNodes()
-    , mpListTimerhandles()
+    , mListTimeouts()
+    , mListFreeTimeouts()
+    , mListDueTimeouts()
+    , mTimeoutTimer(0)
+    , mTimeoutTimerExpiry()
+    , mTimeoutTimerArmed(false)
+    , mTimeoutSlack(ms2timespec(DBUS_TIMEOUT_SLACK))
+    , mDispatchBatch(1)
+    , mListBatched()
+    , mpSelf(std::make_shared<CAmDbusWrapper *>(this))
     , mpSocketHandler(socketHandler)
     , mDbusType(type)
 {
@@ -153,15 +208,15 @@ CAmDbusWrapper::CAmDbusWrapper(CAmSocketHandler *socketHandler, DBusBusType type
 
 CAmDbusWrapper::~CAmDbusWrapper()
 {
-    // close the connection again
+    // send what is still batched, then close the connection again
+    flushBatched();
     logInfo("DBusWrapper::~DBusWrapper Closing DBus connection");
     dbus_connection_unref(mpDbusConnection);
 
-    // clean up all timerhandles we created but did not delete before
-    std::vector<sh_timerHandle_t *>::iterator it = mpListTimerhandles.begin();
-    for (; it != mpListTimerhandles.end(); ++it)
+    // the timeout slots are owned by value, only the shared timer needs to go
+    if (mTimeoutTimer != 0)
     {
-        delete *it;
+        mpSocketHandler->removeTimer(mTimeoutTimer);
     }
 }
 
@@ -220,12 +275,12 @@ void CAmDbusWrapper::registerSignalWatch(DBusHandleMessageFunction handler, cons
 DBusHandlerResult CAmDbusWrapper::cbRootIntrospection(DBusConnection *conn, DBusMessage *msg, void *reference)
 {
     // logInfo("DBusWrapper::~cbRootIntrospection called:");
+    (void)conn;
 
     mpReference = (CAmDbusWrapper *)reference;
     std::vector<std::string> nodesList = mpReference->mListNodes;
     DBusMessage             *reply;
     DBusMessageIter          args;
-    dbus_uint32_t            serial = 0;
     if (dbus_message_is_method_call(msg, DBUS_INTERFACE_INTROSPECTABLE, "Introspect"))
     {
         std::vector<std::string>::iterator nodeIter = nodesList.begin();
@@ -250,13 +305,12 @@ DBusHandlerResult CAmDbusWrapper::cbRootIntrospection(DBusConnection *conn, DBus
             logError("DBusWrapper::~cbRootIntrospection DBUS Out Of Memory!");
         }
 
-        // send the reply && flush the connection
-        if (!dbus_connection_send(conn, reply, &serial))
+        // send the reply together with everything else of this mainloop iteration
+        if (!mpReference->sendBatched(reply))
         {
             logError("DBusWrapper::~cbRootIntrospection DBUS Out Of Memory!");
         }
 
-        dbus_connection_flush(conn);
         // free the reply
         dbus_message_unref(reply);
 
@@ -277,6 +331,84 @@ void CAmDbusWrapper::getDBusConnection(DBusConnection * &connection) const
     connection = mpDbusConnection;
 }
 
+/**
+ * sets how far apart D-Bus timeouts may expire and still be handled by the same mainloop timer.
+ * A timeout can be handled up to this slack late or early. The default is DBUS_TIMEOUT_SLACK.
+ * @param slack the slack in ms, 0 switches coalescing off
+ */
+void CAmDbusWrapper::setTimeoutSlack(const unsigned slack)
+{
+    mTimeoutSlack = ms2timespec(slack);
+}
+
+/**
+ * sets how many incoming messages are dispatched in one mainloop round before the other sources get their turn.
+ * @param batch the number of messages, 0 is treated as 1. The default is 1.
+ */
+void CAmDbusWrapper::setDispatchBatch(const unsigned batch)
+{
+    mDispatchBatch = (batch == 0) ? 1 : batch;
+}
+
+/**
+ * queues a message that is sent together with all other batched messages at the end of the current mainloop iteration,
+ * followed by a single flush. Use this for signals that are emitted in bursts, e.g. property changes.
+ * Must be called from the mainloop thread.
+ * @param message the message, a reference is taken so the caller can unref it right away
+ * @return true on success, false if the message could not be queued
+ */
+bool CAmDbusWrapper::sendBatched(DBusMessage *message)
+{
+    assert(message != NULL);
+    if (mpDbusConnection == NULL)
+    {
+        return (false);
+    }
+
+    // only the first message of a batch needs to post the flush, it stays queued even if the wakeup fails
+    if (mListBatched.empty())
+    {
+        std::weak_ptr<CAmDbusWrapper *> self(mpSelf);
+        if (mpSocketHandler->post([self](){
+                    std::shared_ptr<CAmDbusWrapper *> wrapper(self.lock());
+                    if (wrapper)
+                    {
+                        (*wrapper)->flushBatched();
+                    }
+                }) != E_OK)
+        {
+            logError("DBusWrapper::sendBatched could not wake up the mainloop");
+        }
+    }
+
+    mListBatched.push_back(dbus_message_ref(message));
+    return (true);
+}
+
+/**
+ * sends all batched messages and flushes the connection once.
+ */
+void CAmDbusWrapper::flushBatched()
+{
+    if (mListBatched.empty())
+    {
+        return;
+    }
+
+    for (std::vector<DBusMessage *>::iterator it = mListBatched.begin(); it != mListBatched.end(); ++it)
+    {
+        if (!dbus_connection_send(mpDbusConnection, *it, NULL))
+        {
+            logError("DBusWrapper::flushBatched DBUS Out Of Memory!");
+        }
+
+        dbus_message_unref(*it);
+    }
+
+    mListBatched.clear();
+    dbus_connection_flush(mpDbusConnection);
+}
+
 dbus_bool_t CAmDbusWrapper::addWatch(DBusWatch *watch, void *userData)
 {
     mpReference = (CAmDbusWrapper *)userData;
@@ -307,10 +439,10 @@ dbus_bool_t CAmDbusWrapper::addWatchDelegate(DBusWatch *watch, void *userData)
         logInfo("DBusWrapper::addWatchDelegate entered new watch, fd=", dbus_watch_get_unix_fd(watch), "event flag=", event);
         am_Error_e error = mpSocketHandler->addFDPoll(dbus_watch_get_unix_fd(watch), event, &pDbusPrepareCallback, &pDbusFireCallback, &pDbusCheckCallback, &pDbusDispatchCallback, watch, handle);
 
-        // if everything is alright, add the watch and the handle to our map so we know this relationship
+        // if everything is alright, store the handle on the watch so we know this relationship
         if (error == E_OK && handle != 0)
         {
-            mMapHandleWatch.insert(std::make_pair(watch, handle));
+            dbus_watch_set_data(watch, (void *)(uintptr_t)handle, NULL);
             return (true);
         }
 
@@ -330,13 +462,12 @@ void CAmDbusWrapper::removeWatch(DBusWatch *watch, void *userData)
 void CAmDbusWrapper::removeWatchDelegate(DBusWatch *watch, void *userData)
 {
     (void)userData;
-    std::map<DBusWatch *, sh_pollHandle_t>::iterator iterator = mMapHandleWatch.begin();
-    iterator = mMapHandleWatch.find(watch);
-    if (iterator != mMapHandleWatch.end())
+    sh_pollHandle_t handle = (sh_pollHandle_t)(uintptr_t)dbus_watch_get_data(watch);
+    if (handle != 0)
     {
-        mpSocketHandler->removeFDPoll(iterator->second);
-        logInfo("DBusWrapper::removeWatch removed watch with handle", iterator->second);
-        mMapHandleWatch.erase(iterator);
+        mpSocketHandler->removeFDPoll(handle);
+        logInfo("DBusWrapper::removeWatch removed watch with handle", handle);
+        dbus_watch_set_data(watch, NULL, NULL);
     }
     else
     {
@@ -371,11 +502,15 @@ void CAmDbusWrapper::toogleWatchDelegate(DBusWatch *watch, void *userData)
         }
     }
 
-    std::map<DBusWatch *, sh_pollHandle_t>::iterator iterator = mMapHandleWatch.begin();
-    iterator = mMapHandleWatch.find(watch);
-    if (iterator != mMapHandleWatch.end())
+    sh_pollHandle_t handle = (sh_pollHandle_t)(uintptr_t)dbus_watch_get_data(watch);
+    if (handle != 0)
+    {
+        mpSocketHandler->updateEventFlags(handle, event);
+    }
+    else if (event != 0)
     {
-        mpSocketHandler->updateEventFlags(iterator->second, event);
+        // the watch was disabled when it was added, so it has no poll yet
+        addWatchDelegate(watch, userData);
     }
 }
 
@@ -390,26 +525,33 @@ dbus_bool_t CAmDbusWrapper::addTimeoutDelegate(DBusTimeout *timeout, void *userD
 {
     (void)userData;
 
-    if (!dbus_timeout_get_enabled(timeout))
+    // take a slot from the pool, the table only grows to the peak number of pending timeouts
+    size_t slot;
+    if (mListFreeTimeouts.empty())
     {
-        return (false);
+        slot = mListTimeouts.size();
+        mListTimeouts.emplace_back();
+    }
+    else
+    {
+        slot = mListFreeTimeouts.back();
+        mListFreeTimeouts.pop_back();
     }
 
-    // calculate the timeout in timeval
-    timespec pollTimeout;
-    int      localTimeout = dbus_timeout_get_interval(timeout);
-    pollTimeout.tv_sec  = localTimeout / 1000;
-    pollTimeout.tv_nsec = (localTimeout % 1000) * 1000000;
-
-    // prepare handle and callback. new is eval, but there is no other choice because we need the pointer!
-    sh_timerHandle_t *handle = new sh_timerHandle_t;
-    mpListTimerhandles.push_back(handle);
+    dbusTimeout_s &item = mListTimeouts[slot];
+    item.pTimeout = timeout;
+    item.enabled  = false;
 
-    // add the timer to the pollLoop
-    mpSocketHandler->addTimer(pollTimeout, &pDbusTimerCallback, *handle, timeout);
+    // save the slot with dbus context
+    dbus_timeout_set_data(timeout, slot2data(slot), NULL);
 
-    // save the handle with dbus context
-    dbus_timeout_set_data(timeout, handle, NULL);
+    // disabled timeouts are kept in the table, they are armed by toggleTimeout
+    if (dbus_timeout_get_enabled(timeout))
+    {
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        scheduleTimeout(slot, now);
+    }
 
     return (true);
 }
@@ -424,22 +566,20 @@ void CAmDbusWrapper::removeTimeout(DBusTimeout *timeout, void *userData)
 void CAmDbusWrapper::removeTimeoutDelegate(DBusTimeout *timeout, void *userData)
 {
     (void)userData;
-    // get the pointer to the handle and remove the timer
-    sh_timerHandle_t *handle = (sh_timerHandle_t *)dbus_timeout_get_data(timeout);
-    mpSocketHandler->removeTimer(*handle);
-
-    // now go throught the timerlist and remove the pointer, free memory
-    std::vector<sh_timerHandle_t *>::iterator it = mpListTimerhandles.begin();
-    for (; it != mpListTimerhandles.end(); ++it)
+    void *data = dbus_timeout_get_data(timeout);
+    if (data == NULL)
     {
-        if (*it == handle)
-        {
-            mpListTimerhandles.erase(it);
-            break;
-        }
+        logWarning("CAmDbusWrapper::removeTimeoutDelegate unknown timeout");
+        return;
     }
 
-    delete handle;
+    // give the slot back to the pool. The shared timer is left alone: if this was the earliest timeout
+    // the timer fires once without work and rearms itself, which is cheaper than reprogramming it on every removal
+    size_t slot = data2slot(data);
+    mListTimeouts[slot].pTimeout = NULL;
+    mListTimeouts[slot].enabled  = false;
+    mListFreeTimeouts.push_back(slot);
+    dbus_timeout_set_data(timeout, NULL, NULL);
 }
 
 void CAmDbusWrapper::toggleTimeout(DBusTimeout *timeout, void *userData)
@@ -455,9 +595,12 @@ bool am::CAmDbusWrapper::dbusDispatchCallback(const sh_pollHandle_t handle, void
     (void)userData;
     bool returnVal = true;
     dbus_connection_ref(mpDbusConnection);
-    if (dbus_connection_dispatch(mpDbusConnection) == DBUS_DISPATCH_COMPLETE)
+    for (unsigned count = 0; count < mDispatchBatch && returnVal; ++count)
     {
-        returnVal = false;
+        if (dbus_connection_dispatch(mpDbusConnection) == DBUS_DISPATCH_COMPLETE)
+        {
+            returnVal = false;
+        }
     }
 
     dbus_connection_unref(mpDbusConnection);
@@ -533,43 +676,153 @@ void CAmDbusWrapper::dbusPrepareCallback(const sh_pollHandle_t handle, void *use
 void CAmDbusWrapper::toggleTimeoutDelegate(DBusTimeout *timeout, void *userData)
 {
     (void)userData;
-    // get the pointer to the handle and remove the timer
-    sh_timerHandle_t *handle = (sh_timerHandle_t *)dbus_timeout_get_data(timeout);
+    void *data = dbus_timeout_get_data(timeout);
+    if (data == NULL)
+    {
+        logWarning("CAmDbusWrapper::toggleTimeoutDelegate unknown timeout");
+        return;
+    }
 
-    // stop or restart?
+    // stop or restart? A stopped timeout just drops out of the next expiry scan.
+    size_t slot = data2slot(data);
     if (dbus_timeout_get_enabled(timeout))
     {
-        // calculate the timeout in timeval
-        timespec pollTimeout;
-        int      localTimeout = dbus_timeout_get_interval(timeout);
-        pollTimeout.tv_sec  = localTimeout / 1000;
-        pollTimeout.tv_nsec = (localTimeout % 1000) * 1000000;
-        mpSocketHandler->updateTimer(*handle, pollTimeout);
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        scheduleTimeout(slot, now);
     }
     else
     {
-        mpSocketHandler->stopTimer(*handle);
+        mListTimeouts[slot].enabled = false;
     }
 }
 
-void CAmDbusWrapper::dbusTimerCallback(sh_timerHandle_t handle, void *userData)
+/**
+ * (re)starts the timeout in the given slot with its full interval and makes sure the shared timer fires in time for it.
+ * @param slot the slot of the timeout
+ * @param now the current CLOCK_MONOTONIC time
+ */
+void CAmDbusWrapper::scheduleTimeout(const size_t slot, const timespec &now)
 {
-    assert(userData != NULL);
-    for (auto &&timerHandle : mpListTimerhandles)
+    dbusTimeout_s &item = mListTimeouts[slot];
+    item.expiry  = addTimespec(now, ms2timespec(dbus_timeout_get_interval(item.pTimeout)));
+    item.enabled = true;
+
+    // the shared timer only needs to be reprogrammed if it would fire more than the slack too late
+    if (!mTimeoutTimerArmed || isBefore(addTimespec(item.expiry, mTimeoutSlack), mTimeoutTimerExpiry))
+    {
+        armTimeoutTimer(now);
+    }
+}
+
+/**
+ * programs the shared timer for the earliest enabled timeout, or stops it if there is none.
+ * @param now the current CLOCK_MONOTONIC time
+ */
+void CAmDbusWrapper::armTimeoutTimer(const timespec &now)
+{
+    bool     found = false;
+    timespec earliest;
+    for (std::vector<dbusTimeout_s>::const_iterator it = mListTimeouts.begin(); it != mListTimeouts.end(); ++it)
+    {
+        if (it->enabled && (!found || isBefore(it->expiry, earliest)))
+        {
+            earliest = it->expiry;
+            found    = true;
+        }
+    }
+
+    if (!found)
+    {
+        if (mTimeoutTimerArmed)
+        {
+            mpSocketHandler->stopTimer(mTimeoutTimer);
+            mTimeoutTimerArmed = false;
+        }
+
+        return;
+    }
+
+    // the mainloop does not accept a zero timer, so overdue timeouts are handled after 1 ns
+    timespec delay;
+    if (isBefore(now, earliest))
     {
-        if (*timerHandle == handle)
+        delay.tv_sec  = earliest.tv_sec - now.tv_sec;
+        delay.tv_nsec = earliest.tv_nsec - now.tv_nsec;
+        if (delay.tv_nsec < 0)
         {
-            if (dbus_timeout_get_enabled((DBusTimeout *)userData))
-            {
-                mpSocketHandler->restartTimer(handle);
-            }
+            delay.tv_sec--;
+            delay.tv_nsec += 1000000000;
+        }
+    }
+    else
+    {
+        delay.tv_sec  = 0;
+        delay.tv_nsec = 1;
+    }
 
-            dbus_timeout_handle((DBusTimeout *)userData);
+    if (mTimeoutTimer == 0)
+    {
+        if (mpSocketHandler->addTimer(delay, &pDbusTimerCallback, mTimeoutTimer, NULL) != E_OK)
+        {
+            logError("CAmDbusWrapper::armTimeoutTimer could not create the timeout timer");
+            mTimeoutTimer = 0;
             return;
         }
     }
+    else
+    {
+#ifndef WITH_TIMERFD
+        // without timerfd, updateTimer would queue an already active timer a second time
+        mpSocketHandler->stopTimer(mTimeoutTimer);
+#endif
+        mpSocketHandler->updateTimer(mTimeoutTimer, delay);
+    }
+
+    mTimeoutTimerExpiry = earliest;
+    mTimeoutTimerArmed  = true;
+}
+
+void CAmDbusWrapper::dbusTimerCallback(sh_timerHandle_t handle, void *userData)
+{
+    (void)userData;
+    if (handle != mTimeoutTimer)
+    {
+        logWarning("CAmDbusWrapper::dbusTimerCallback Unknown timer handle");
+        return;
+    }
+
+    mTimeoutTimerArmed = false;
+
+    // collect everything that expires within the slack first, dbus_timeout_handle may add or remove timeouts
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const timespec limit = addTimespec(now, mTimeoutSlack);
+    mListDueTimeouts.clear();
+    for (size_t slot = 0; slot < mListTimeouts.size(); ++slot)
+    {
+        if (mListTimeouts[slot].enabled && !isBefore(limit, mListTimeouts[slot].expiry))
+        {
+            mListDueTimeouts.push_back(slot);
+        }
+    }
+
+    for (std::vector<size_t>::const_iterator it = mListDueTimeouts.begin(); it != mListDueTimeouts.end(); ++it)
+    {
+        // the slot may have been removed or reused by a previous handler
+        dbusTimeout_s &item = mListTimeouts[*it];
+        if (!item.enabled || isBefore(limit, item.expiry))
+        {
+            continue;
+        }
+
+        // dbus timeouts repeat until they are removed or disabled
+        DBusTimeout *timeout = item.pTimeout;
+        item.expiry = addTimespec(now, ms2timespec(dbus_timeout_get_interval(timeout)));
+        dbus_timeout_handle(timeout);
+    }
 
-    logWarning("CAmDbusWrapper::dbusTimerCallback Unknown timer handle");
+    armTimeoutTimer(now);
 }
 
 }
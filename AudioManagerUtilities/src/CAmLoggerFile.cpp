@@ -164,9 +164,10 @@ CAmLoggerFile::~CAmLoggerFile()
 
 void CAmLoggerFile::unregisterApp()
 {
-    for (auto &&context : mCtxTable)
+    // unregisterContext erases from the table, so always take the first entry
+    while (!mCtxTable.empty())
     {
-        unregisterContext(context.first);
+        unregisterContext(mCtxTable.begin()->first);
     }
 }
 
@@ -174,9 +174,10 @@ CAmLoggerStdOut::~CAmLoggerStdOut()
 
 void CAmLoggerStdOut::unregisterApp()
 {
-    for (auto &&context : mCtxTable)
+    // unregisterContext erases from the table, so always take the first entry
+    while (!mCtxTable.empty())
     {
-        unregisterContext(context.first);
+        unregisterContext(mCtxTable.begin()->first);
     }
 }
 
@@ -42,6 +42,19 @@
 
 #define END_EVENT (UINT64_MAX >> 1)
 
+namespace
+{
+
+// upper bounds of the timer lateness buckets in ns, the last bucket is open
+const uint64_t LATENESS_BOUNDS[SH_LATENESS_BUCKETS - 1] = { 100000u, 1000000u, 10000000u, 100000000u, 1000000000u };
+
+uint64_t toNs(const timespec &time)
+{
+    return (static_cast<uint64_t>(time.tv_sec) * MAX_NS + static_cast<uint64_t>(time.tv_nsec));
+}
+
+}
+
 namespace am
 {
 
@@ -49,8 +62,10 @@ CAmSocketHandler::CAmSocketHandler()
     : mEventFd(-1)
     , mSignalFd(-1)
     , mDispatchDone(true)
+    , mPolls()
+    , mPollFds()
+    , mReadyPolls()
     , mSetPollKeys(MAX_POLLHANDLE)
-    , mMapShPoll()
     , mSetTimerKeys(MAX_TIMERHANDLE)
     , mListTimer()
     ,
@@ -61,6 +76,10 @@ CAmSocketHandler::CAmSocketHandler()
     mSetSignalhandlerKeys(MAX_POLLHANDLE)
     , mSignalHandlers()
     , mInternalCodes(internal_codes_e::NO_ERROR)
+    , mDispatchQueues()
+    , mDispatchBudget(SH_DISPATCH_BUDGET)
+    , mPosted(nullptr)
+    , mStatistics()
 #ifndef WITH_TIMERFD
     , mStartTime()
 #endif
@@ -72,14 +91,16 @@ CAmSocketHandler::CAmSocketHandler()
             ssize_t  bytes = read(pollfd.fd, &events, sizeof(events));
             if (bytes == sizeof(events))
             {
+                runPosted();
+
                 if (events >= END_EVENT)
                 {
-                    for (auto &elem : mMapShPoll)
+                    for (auto &elem : mPolls)
                     {
-                        if (elem.second.state == poll_states_e::UPDATE ||
-                            elem.second.state == poll_states_e::VALID)
+                        if (elem.state == poll_states_e::UPDATE ||
+                            elem.state == poll_states_e::VALID)
                         {
-                            elem.second.state = poll_states_e::ADD;
+                            elem.state = poll_states_e::ADD;
                         }
                     }
 
@@ -112,9 +133,20 @@ CAmSocketHandler::CAmSocketHandler()
 
 CAmSocketHandler::~CAmSocketHandler()
 {
-    for (const auto &it : mMapShPoll)
+    for (const auto &it : mPolls)
+    {
+        if (it.state != poll_states_e::INVALID)
+        {
+            close(it.pollfdValue.fd);
+        }
+    }
+
+    sh_post_s *item = mPosted.exchange(nullptr);
+    while (item != nullptr)
     {
-        close(it.second.pollfdValue.fd);
+        sh_post_s *next = item->next;
+        delete item;
+        item = next;
     }
 }
 
@@ -130,52 +162,68 @@ void CAmSocketHandler::start_listenting()
     clock_gettime(CLOCK_MONOTONIC, &mStartTime);
 #endif
     timespec buffertime;
-
-    VectorPollfd_t fdPollingArray; //!< the polling array for ppoll
+    timespec wakeupTime{0, 0}; //!< end of the last ppoll, only set if statistics are enabled
 
     while (!mDispatchDone)
     {
-        /* Iterate all times through map and synchronize the polling array accordingly.
-         * In case a new element in map appears the polling array will be extended and
-         * in case an element gets removed the map and the polling array needs to be adapted.
+        /* Iterate all slots and synchronize the polling array accordingly. The polling array
+         * has one entry per slot, free slots carry a negative fd which is ignored by ppoll.
+         * Memory is only allocated here when the registration table has grown.
          */
-        auto fdPollIt = fdPollingArray.begin();
-        for (auto it = mMapShPoll.begin(); it != mMapShPoll.end(); )
+        if (mPollFds.size() != mPolls.size())
+        {
+            pollfd unused;
+            unused.fd      = -1;
+            unused.events  = 0;
+            unused.revents = 0;
+            mPollFds.resize(mPolls.size(), unused);
+            mReadyPolls.reserve(mPolls.size());
+        }
+
+        // slots added by prepare callbacks are synchronized in the next iteration
+        for (uint32_t slot = 0; slot < mPollFds.size(); ++slot)
         {
             // NOTE: The order of the switch/case statement reflects the state flow
-            auto &elem = it->second;
+            auto &elem = mPolls[slot];
             switch (elem.state)
             {
             case poll_states_e::ADD:
                 elem.state = poll_states_e::UPDATE;
-                fdPollIt   = fdPollingArray.emplace(fdPollIt);
-                break;
-
+            // fallthrough
             case poll_states_e::UPDATE:
                 elem.state = poll_states_e::VALID;
                 CAmSocketHandler::prepare(elem);
-                *fdPollIt = elem.pollfdValue;
+                mPollFds[slot] = elem.pollfdValue;
                 break;
 
             case poll_states_e::VALID:
-                // check for multi-thread access
-                assert(fdPollIt != fdPollingArray.end());
-                ++fdPollIt;
-                ++it;
                 break;
 
             case poll_states_e::REMOVE:
-                elem.state = poll_states_e::INVALID;
-                fdPollIt   = fdPollingArray.erase(fdPollIt);
-                break;
-
+                dequeueDispatch(slot);
+                freeSlot(elem);
+            // fallthrough
             case poll_states_e::INVALID:
-                it = mMapShPoll.erase(it);
+                mPollFds[slot].fd      = -1;
+                mPollFds[slot].revents = 0;
                 break;
             }
         }
 
-        if (fdPollingArray.size() != mMapShPoll.size())
+        /* Every polled entry of the array has to belong to a registered slot. Callbacks of this
+         * thread only change states in a way that keeps this intact, so anything else means the
+         * registrations were changed from another thread meanwhile.
+         */
+        uint32_t polled     = 0;
+        uint32_t registered = 0;
+        for (uint32_t slot = 0; slot < mPollFds.size(); ++slot)
+        {
+            const poll_states_e state = mPolls[slot].state;
+            polled     += (mPollFds[slot].fd >= 0);
+            registered += (state == poll_states_e::UPDATE || state == poll_states_e::VALID || state == poll_states_e::REMOVE);
+        }
+
+        if (polled != registered)
         {
             mInternalCodes |= internal_codes_e::MT_ERROR;
             logError("CAmSocketHandler::start_listenting is NOT multi-thread safe!");
@@ -187,40 +235,85 @@ void CAmSocketHandler::start_listenting()
 #endif
 
         // block until something is on a file descriptor
-        int16_t pollStatus = ppoll(&fdPollingArray[0], fdPollingArray.size(), insertTime(buffertime), NULL);
+        const bool measure = mStatistics.enabled;
+        timespec   pollTime;
+        if (measure)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &pollTime);
+            if ((wakeupTime.tv_sec != 0) || (wakeupTime.tv_nsec != 0))
+            {
+                mStatistics.workingNs += toNs(timespecSub(pollTime, wakeupTime));
+            }
+        }
+
+        int16_t pollStatus = ppoll(mPollFds.data(), mPollFds.size(), insertTime(buffertime), NULL);
+        if (measure)
+        {
+            clock_gettime(CLOCK_MONOTONIC, &wakeupTime);
+            mStatistics.blockedNs += toNs(timespecSub(wakeupTime, pollTime));
+            mStatistics.iterations++;
+        }
+
         if (pollStatus > 0)
         {
             // stage 0+1, call firedCB
-            std::list<sh_poll_s *> listPoll;
-            for (auto &it : fdPollingArray)
+            mReadyPolls.clear();
+            for (uint32_t slot = 0; slot < mPollFds.size(); ++slot)
             {
+                pollfd &it = mPollFds[slot];
                 it.revents &= it.events;
                 if (it.revents == 0)
                 {
                     continue;
                 }
 
-                sh_poll_s &pollObj = mMapShPoll.at(it.fd);
+                // callbacks might have changed the registration meanwhile
+                sh_poll_s &pollObj = mPolls[slot];
                 if (pollObj.state != poll_states_e::VALID)
                 {
+                    it.revents = 0;
                     continue;
                 }
 
-                // ensure to copy the revents fired in fdPollingArray
+                // ensure to copy the revents fired in the polling array
                 pollObj.pollfdValue.revents = it.revents;
-                listPoll.push_back(&pollObj);
+                mReadyPolls.push_back(slot);
+                timespec start;
+                if (measure)
+                {
+                    clock_gettime(CLOCK_MONOTONIC, &start);
+                }
+
                 CAmSocketHandler::fire(pollObj);
+                if (measure && pollObj.firedCB)
+                {
+                    recordCallback(pollObj.statistics.fire, pollObj.handle, start);
+                }
+
                 it.revents = 0;
             }
 
-            // stage 2, lets ask around if some dispatching is necessary, the ones who need stay on the list
-            listPoll.remove_if(CAmSocketHandler::noDispatching);
-
-            // stage 3, the ones left need to dispatch, we do this as long as there is something to dispatch..
-            do
+            // stage 2, lets ask around if some dispatching is necessary, the ones who need are queued
+            for (const auto slot : mReadyPolls)
             {
-                listPoll.remove_if(CAmSocketHandler::dispatchingFinished);
-            } while (!listPoll.empty());
+                sh_poll_s &pollObj = mPolls[slot];
+                timespec   start;
+                if (measure)
+                {
+                    clock_gettime(CLOCK_MONOTONIC, &start);
+                }
+
+                const bool dispatchNeeded = !CAmSocketHandler::noDispatching(&pollObj);
+                if (measure && pollObj.checkCB)
+                {
+                    recordCallback(pollObj.statistics.check, pollObj.handle, start);
+                }
+
+                if (dispatchNeeded)
+                {
+                    queueDispatch(slot);
+                }
+            }
         }
         else if ((pollStatus < 0) && (errno != EINTR))
         {
@@ -235,6 +328,9 @@ void CAmSocketHandler::start_listenting()
             timerUp();
 #endif
         }
+
+        // stage 3, dispatch within the budget, the rest is carried over to the next iteration
+        dispatch();
     }
 }
 
@@ -271,6 +367,304 @@ void CAmSocketHandler::exit_mainloop()
     stop_listening();
 }
 
+/**
+ * queues a function to be called in the mainloop. This method is lock-free and can be called from
+ * any thread, the functions are called in the order they were posted.
+ * @param function the function to call
+ * @return E_OK on success, E_NOT_POSSIBLE if the function is empty or the mainloop could not be woken up
+ */
+am_Error_e CAmSocketHandler::post(std::function<void()> function)
+{
+    if (!function)
+    {
+        return (E_NOT_POSSIBLE);
+    }
+
+    sh_post_s *item = new sh_post_s;
+    item->function = std::move(function);
+    item->next     = mPosted.load(std::memory_order_relaxed);
+    while (!mPosted.compare_exchange_weak(item->next, item, std::memory_order_release, std::memory_order_relaxed))
+    {
+    }
+
+    // the function stays queued even if this fails, it is called on the next wakeup
+    const uint64_t value = 1u;
+    if (write(mEventFd, &value, sizeof(value)) < 0)
+    {
+        logError("CAmSocketHandler::post Failed to write to event fd:", mEventFd, std::strerror(errno));
+        return (E_NOT_POSSIBLE);
+    }
+
+    return (E_OK);
+}
+
+/**
+ * queues a function to be called in the mainloop after the given delay. Can be called from any thread.
+ * @param delay the delay, measured from the time of the call
+ * @param function the function to call
+ * @return E_OK on success, E_NOT_POSSIBLE if the function is empty or the mainloop could not be woken up
+ */
+am_Error_e CAmSocketHandler::postDelayed(const timespec &delay, std::function<void()> function)
+{
+    if (!function)
+    {
+        return (E_NOT_POSSIBLE);
+    }
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const timespec deadline = timespecAdd(now, delay);
+    return post([this, deadline, function](){
+            postAt(deadline, function);
+        });
+}
+
+/**
+ * calls all posted functions, is called in the mainloop
+ */
+void CAmSocketHandler::runPosted()
+{
+    sh_post_s *item = mPosted.exchange(nullptr, std::memory_order_acquire);
+
+    // the stack holds the newest function first, reverse it to keep the posting order
+    sh_post_s *ordered = nullptr;
+    while (item != nullptr)
+    {
+        sh_post_s *next = item->next;
+        item->next = ordered;
+        ordered    = item;
+        item       = next;
+    }
+
+    while (ordered != nullptr)
+    {
+        sh_post_s *next = ordered->next;
+        callPosted(ordered->function);
+        delete ordered;
+        ordered = next;
+    }
+}
+
+/**
+ * starts a oneshot timer for a delayed function, is called in the mainloop
+ */
+void CAmSocketHandler::postAt(const timespec &deadline, const std::function<void()> &function)
+{
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    const timespec remaining = timespecSub(deadline, now);
+    if ((remaining.tv_sec == 0) && (remaining.tv_nsec == 0))
+    {
+        callPosted(function);
+        return;
+    }
+
+    sh_timerHandle_t handle;
+    auto callback = [this, function](const sh_timerHandle_t handle, void *){
+            removeTimer(handle);
+            callPosted(function);
+        };
+    if (addTimer(remaining, callback, handle, NULL) != E_OK)
+    {
+        logError("CAmSocketHandler::postDelayed Failed to add timer, function dropped");
+    }
+}
+
+void CAmSocketHandler::callPosted(const std::function<void()> &function)
+{
+    try
+    {
+        function();
+    }
+    catch (std::exception &e)
+    {
+        logError("CAmSocketHandler::callPosted Exception caught", e.what());
+    }
+}
+
+/**
+ * enables or disables the collection of mainloop statistics. When disabled, the mainloop only checks a flag.
+ * When enabled, the fire, check and dispatch callbacks of all polls are timed, the lateness of timer expiries
+ * is measured and the time blocked in ppoll is compared to the time spent working.
+ * Timers started before enabling are measured from their next start on.
+ * @param enable true to collect statistics
+ */
+void CAmSocketHandler::enableStatistics(const bool enable)
+{
+    mStatistics.enabled = enable;
+}
+
+/**
+ * resets all collected statistics
+ */
+void CAmSocketHandler::resetStatistics()
+{
+    const bool enabled = mStatistics.enabled;
+    mStatistics         = sh_statistics_s();
+    mStatistics.enabled = enabled;
+    for (auto &it : mPolls)
+    {
+        it.statistics = sh_pollStatistics_s();
+    }
+
+    for (auto &it : mListTimer)
+    {
+        const timespec expiry = it.expiry;
+        it.statistics = sh_timerStatistics_s();
+        it.expiry     = expiry;
+    }
+}
+
+/**
+ * returns the collected statistics together with the statistics of all registered polls and timers
+ * @param statistics
+ */
+void CAmSocketHandler::getStatistics(sh_statistics_s &statistics) const
+{
+    statistics = mStatistics;
+    for (const auto &it : mPolls)
+    {
+        if (it.state == poll_states_e::INVALID)
+        {
+            continue;
+        }
+
+        statistics.polls.push_back(it.statistics);
+        statistics.polls.back().handle = it.handle;
+        statistics.polls.back().fd     = it.pollfdValue.fd;
+    }
+
+    for (const auto &it : mListTimer)
+    {
+        statistics.timers.push_back(it.statistics);
+        statistics.timers.back().handle = it.handle;
+    }
+}
+
+/**
+ * writes the collected statistics to the log
+ */
+void CAmSocketHandler::dumpStatistics() const
+{
+    sh_statistics_s statistics;
+    getStatistics(statistics);
+    logInfo("CAmSocketHandler::dumpStatistics enabled", statistics.enabled, "iterations", statistics.iterations,
+        "blocked us", statistics.blockedNs / 1000, "working us", statistics.workingNs / 1000,
+        "longest callback us", statistics.longestCallbackNs / 1000, "of handle", statistics.longestCallbackHandle);
+
+    for (const auto &it : statistics.polls)
+    {
+        if ((it.fire.calls == 0) && (it.check.calls == 0) && (it.dispatch.calls == 0))
+        {
+            continue;
+        }
+
+        logInfo("CAmSocketHandler::dumpStatistics poll", it.handle, "fd", it.fd,
+            "fire", it.fire.calls, it.fire.totalNs / 1000, it.fire.maxNs / 1000,
+            "check", it.check.calls, it.check.totalNs / 1000, it.check.maxNs / 1000,
+            "dispatch", it.dispatch.calls, it.dispatch.totalNs / 1000, it.dispatch.maxNs / 1000);
+    }
+
+    for (const auto &it : statistics.timers)
+    {
+        if (it.expiries == 0)
+        {
+            continue;
+        }
+
+        logInfo("CAmSocketHandler::dumpStatistics timer", it.handle, "expiries", it.expiries, "max lateness us", it.maxLatenessNs / 1000,
+            "lateness <0.1ms", it.lateness[0], "<1ms", it.lateness[1], "<10ms", it.lateness[2],
+            "<100ms", it.lateness[3], "<1s", it.lateness[4], ">=1s", it.lateness[5]);
+    }
+}
+
+void CAmSocketHandler::recordCallback(sh_callbackStatistics_s &statistics, const sh_pollHandle_t handle, const timespec &start)
+{
+    timespec end;
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    const uint64_t duration = toNs(timespecSub(end, start));
+    statistics.calls++;
+    statistics.totalNs += duration;
+    statistics.maxNs    = std::max(statistics.maxNs, duration);
+    if (duration > mStatistics.longestCallbackNs)
+    {
+        mStatistics.longestCallbackNs     = duration;
+        mStatistics.longestCallbackHandle = handle;
+    }
+}
+
+/**
+ * remembers when a started timer is expected to expire
+ */
+void CAmSocketHandler::armStatistics(sh_timer_s &timer, const timespec &timeout)
+{
+    if (!mStatistics.enabled)
+    {
+        timer.expiry.tv_sec  = 0;
+        timer.expiry.tv_nsec = 0;
+        return;
+    }
+
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    timer.expiry = timespecAdd(now, timeout);
+}
+
+/**
+ * measures the lateness of a timer expiry
+ */
+void CAmSocketHandler::timerExpired(const sh_timerHandle_t handle)
+{
+    if (!mStatistics.enabled)
+    {
+        return;
+    }
+
+    for (auto &timer : mListTimer)
+    {
+        if (timer.handle != handle)
+        {
+            continue;
+        }
+
+        if ((timer.expiry.tv_sec == 0) && (timer.expiry.tv_nsec == 0))
+        {
+            return;
+        }
+
+        timespec now;
+        clock_gettime(CLOCK_MONOTONIC, &now);
+        const uint64_t lateness = toNs(timespecSub(now, timer.expiry));
+        unsigned bucket = 0;
+        while ((bucket < SH_LATENESS_BUCKETS - 1) && (lateness >= LATENESS_BOUNDS[bucket]))
+        {
+            ++bucket;
+        }
+
+        timer.statistics.expiries++;
+        timer.statistics.lateness[bucket]++;
+        timer.statistics.maxLatenessNs = std::max(timer.statistics.maxLatenessNs, lateness);
+
+#ifdef WITH_TIMERFD
+        // repeating timers expire again one interval later
+        const timespec &interval = timer.countdown.it_interval;
+        if ((interval.tv_sec != 0) || (interval.tv_nsec != 0))
+        {
+            timer.expiry = timespecAdd(timer.expiry, interval);
+            while (toNs(timer.expiry) <= toNs(now))
+            {
+                timer.expiry = timespecAdd(timer.expiry, interval);
+            }
+
+            return;
+        }
+#endif
+        timer.expiry.tv_sec  = 0;
+        timer.expiry.tv_nsec = 0;
+        return;
+    }
+}
+
 void CAmSocketHandler::wakeupWorker(const std::string &func, const uint64_t value)
 {
     if (write(mEventFd, &value, sizeof(value)) < 0)
@@ -421,24 +815,36 @@ am_Error_e CAmSocketHandler::addFDPoll(const int fd,
         return E_NON_EXISTENT;
     }
 
-    const auto elem = mMapShPoll.find(fd);
-    if (elem != mMapShPoll.end())
+    // look for the fd and for a free slot
+    uint32_t slot = SH_NO_SLOT;
+    for (uint32_t it = 0; it < mPolls.size(); ++it)
     {
-        // The fd was already in map therefore we need to trigger an update instead
-        switch (elem->second.state)
+        const sh_poll_s &elem = mPolls[it];
+        if (elem.state == poll_states_e::INVALID)
         {
-        case poll_states_e::REMOVE:
-            pollData.state = poll_states_e::UPDATE;
-            break;
+            if (slot == SH_NO_SLOT)
+            {
+                slot = it;
+            }
 
-        case poll_states_e::INVALID:
-            pollData.state = poll_states_e::ADD;
-            break;
+            continue;
+        }
 
-        default:
+        if (elem.pollfdValue.fd != fd)
+        {
+            continue;
+        }
+
+        // The fd is about to be removed, therefore we reuse its slot and trigger an update instead
+        if (elem.state != poll_states_e::REMOVE)
+        {
             logError("CAmSocketHandler::addFDPoll fd", fd, "already registered!");
             return E_ALREADY_EXISTS;
         }
+
+        pollData.state = poll_states_e::UPDATE;
+        slot           = it;
+        break;
     }
 
     // create a new handle for the poll
@@ -458,8 +864,17 @@ am_Error_e CAmSocketHandler::addFDPoll(const int fd,
     pollData.dispatchCB          = dispatch;
     pollData.userData            = userData;
 
-    // add new data to the list
-    mMapShPoll[fd] = pollData;
+    // add new data to the registration table
+    if (slot == SH_NO_SLOT)
+    {
+        mPolls.push_back(pollData);
+    }
+    else
+    {
+        dequeueDispatch(slot);
+        mPolls[slot] = pollData;
+    }
+
     wakeupWorker("addFDPoll");
 
     handle = pollData.handle;
@@ -513,6 +928,45 @@ am::am_Error_e CAmSocketHandler::addFDPoll(const int fd, const short event, IAmS
     return addFDPoll(fd, event, prepareCB, firedCB, checkCB, dispatchCB, userData, handle);
 }
 
+/**
+ * sets the dispatch priority of a poll. Within one mainloop iteration polls with a higher priority
+ * are dispatched first, polls of the same priority are dispatched round robin.
+ * @param handle the handle of the poll
+ * @param priority the new priority
+ * @return E_OK on success, E_NOT_POSSIBLE if the priority is out of range, E_UNKNOWN if the handle is not known
+ */
+am_Error_e CAmSocketHandler::setPollPriority(const sh_pollHandle_t handle, const sh_priority_e priority)
+{
+    if (priority >= SH_PRIORITY_MAX)
+    {
+        logError("CAmSocketHandler::setPollPriority invalid priority", static_cast<uint16_t>(priority));
+        return (E_NOT_POSSIBLE);
+    }
+
+    for (auto &it : mPolls)
+    {
+        if (it.state != poll_states_e::INVALID && it.handle == handle)
+        {
+            it.priority = priority;
+            return (E_OK);
+        }
+    }
+
+    logWarning("CAmSocketHandler::setPollPriority handle unknown", handle);
+    return (E_UNKNOWN);
+}
+
+/**
+ * sets the maximum number of dispatch calls per mainloop iteration. Polls which still want
+ * to dispatch when the budget is used up are served in the next iteration, so that timers and
+ * other filedescriptors are not starved by a busy source.
+ * @param budget number of dispatch calls, 0 selects the default SH_DISPATCH_BUDGET
+ */
+void CAmSocketHandler::setDispatchBudget(const unsigned budget)
+{
+    mDispatchBudget = (budget == 0 ? SH_DISPATCH_BUDGET : budget);
+}
+
 /**
  * removes a filedescriptor from the poll loop
  * @param handle
@@ -521,11 +975,20 @@ am::am_Error_e CAmSocketHandler::addFDPoll(const int fd, const short event, IAmS
  */
 am_Error_e CAmSocketHandler::removeFDPoll(const sh_pollHandle_t handle)
 {
-    for (auto &it : mMapShPoll)
+    for (auto &it : mPolls)
     {
-        if (it.second.handle == handle)
+        if (it.state != poll_states_e::INVALID && it.handle == handle)
         {
-            it.second.state = (it.second.state == poll_states_e::ADD ? poll_states_e::INVALID : poll_states_e::REMOVE);
+            // slots which never made it into the polling array are freed right away
+            if (it.state == poll_states_e::ADD)
+            {
+                freeSlot(it);
+            }
+            else
+            {
+                it.state = poll_states_e::REMOVE;
+            }
+
             wakeupWorker("removeFDPoll");
             mSetPollKeys.pollHandles.erase(handle);
             return E_OK;
@@ -625,6 +1088,7 @@ am_Error_e CAmSocketHandler::addTimer(const timespec &timeouts, std::function<vo
     timerItem.userData  = userData;
 
     timerItem.handle = handle;
+    armStatistics(timerItem, timeouts);
 
     // we add here the time difference between startTime and currenttime, because this time will be substracted later on in timecorrection
     timespec currentTime;
@@ -682,7 +1146,8 @@ am_Error_e CAmSocketHandler::addTimer(const timespec &timeouts, std::function<vo
         };
 
     err = addFDPoll(timerItem.fd, POLLIN | POLLERR, NULL, actionPoll,
-            [callback](const sh_pollHandle_t handle, void *userData) -> bool {
+            [this, callback](const sh_pollHandle_t handle, void *userData) -> bool {
+                timerExpired(handle);
                 callback(handle, userData);
                 return false;
             },
@@ -691,6 +1156,7 @@ am_Error_e CAmSocketHandler::addTimer(const timespec &timeouts, std::function<vo
     if (err == E_OK)
     {
         timerItem.handle = handle;
+        armStatistics(timerItem, timeouts);
         mListTimer.push_back(timerItem);
         return E_OK;
     }
@@ -778,6 +1244,7 @@ am_Error_e CAmSocketHandler::updateTimer(const sh_timerHandle_t handle, const ti
     }
 
     it->countdown.it_value = timeouts;
+    armStatistics(*it, timeouts);
 
     if (!fdIsValid(it->fd))
     {
@@ -805,6 +1272,7 @@ am_Error_e CAmSocketHandler::updateTimer(const sh_timerHandle_t handle, const ti
         if (it->handle == handle)
         {
             it->countdown = timeouts;
+            armStatistics(*it, timeouts);
             timerItem     = *it;
             found         = true;
             break;
@@ -872,6 +1340,7 @@ am_Error_e CAmSocketHandler::restartTimer(const sh_timerHandle_t handle)
         return (E_NON_EXISTENT);
     }
 
+    armStatistics(*it, it->countdown.it_value);
     if (!fdIsValid(it->fd))
     {
         am_Error_e err = createTimeFD(it->countdown, it->fd);
@@ -897,6 +1366,7 @@ am_Error_e CAmSocketHandler::restartTimer(const sh_timerHandle_t handle)
     {
         if (it->handle == handle)
         {
+            armStatistics(*it, it->countdown);
             timerItem = *it;
             found     = true;
             break;
@@ -991,10 +1461,9 @@ am_Error_e CAmSocketHandler::stopTimer(const sh_timerHandle_t handle)
  */
 am_Error_e CAmSocketHandler::updateEventFlags(const sh_pollHandle_t handle, const short events)
 {
-    for (auto &it : mMapShPoll)
+    for (auto &elem : mPolls)
     {
-        auto &elem = it.second;
-        if (elem.handle != handle)
+        if (elem.state == poll_states_e::INVALID || elem.handle != handle)
         {
             continue;
         }
@@ -1063,6 +1532,11 @@ void CAmSocketHandler::timerUp()
     mListActiveTimer.erase(mListActiveTimer.begin(), it);
 
     // call the callbacks for the timers
+    for (const auto &timer : tempList)
+    {
+        timerExpired(timer.handle);
+    }
+
     std::for_each(tempList.begin(), tempList.end(), CAmSocketHandler::callTimer);
 }
 
@@ -1110,6 +1584,11 @@ void CAmSocketHandler::timerCorrection()
             mListActiveTimer.erase(mListActiveTimer.begin(), it);
 
             // call the callbacks for the timers
+            for (const auto &timer : tempList)
+            {
+                timerExpired(timer.handle);
+            }
+
             std::for_each(tempList.begin(), tempList.end(), CAmSocketHandler::callTimer);
         }
     }
@@ -1141,6 +1620,11 @@ void CAmSocketHandler::prepare(am::CAmSocketHandler::sh_poll_s &row)
  */
 void CAmSocketHandler::fire(const sh_poll_s &a)
 {
+    if (!a.firedCB)
+    {
+        return;
+    }
+
     try
     {
         a.firedCB(a.pollfdValue, a.handle, a.userData);
@@ -1179,6 +1663,155 @@ bool CAmSocketHandler::dispatchingFinished(const sh_poll_s *a)
     return (!a->dispatchCB(a->handle, a->userData));
 }
 
+/**
+ * checks if any poll is waiting for dispatching
+ */
+bool CAmSocketHandler::dispatchPending() const
+{
+    for (const auto &queue : mDispatchQueues)
+    {
+        if (queue.head != SH_NO_SLOT)
+        {
+            return (true);
+        }
+    }
+
+    return (false);
+}
+
+/**
+ * puts a poll at the end of the dispatch queue of its priority
+ */
+void CAmSocketHandler::queueDispatch(const uint32_t slot)
+{
+    sh_poll_s &poll = mPolls[slot];
+    if (poll.dispatchPending)
+    {
+        return;
+    }
+
+    sh_dispatchQueue_s &queue = mDispatchQueues[poll.priority];
+    poll.dispatchPending = true;
+    poll.nextDispatch    = SH_NO_SLOT;
+    if (queue.tail == SH_NO_SLOT)
+    {
+        queue.head = slot;
+    }
+    else
+    {
+        mPolls[queue.tail].nextDispatch = slot;
+    }
+
+    queue.tail = slot;
+}
+
+/**
+ * marks a slot as free and releases its callbacks, so that nothing captured by them
+ * stays alive until the slot is reused.
+ * @param poll the slot
+ */
+void CAmSocketHandler::freeSlot(sh_poll_s &poll)
+{
+    poll.state      = poll_states_e::INVALID;
+    poll.prepareCB  = nullptr;
+    poll.firedCB    = nullptr;
+    poll.checkCB    = nullptr;
+    poll.dispatchCB = nullptr;
+    poll.userData   = NULL;
+}
+
+/**
+ * unlinks a poll from its dispatch queue before the slot is freed or reused
+ */
+void CAmSocketHandler::dequeueDispatch(const uint32_t slot)
+{
+    if (!mPolls[slot].dispatchPending)
+    {
+        return;
+    }
+
+    for (auto &queue : mDispatchQueues)
+    {
+        uint32_t previous = SH_NO_SLOT;
+        for (uint32_t it = queue.head; it != SH_NO_SLOT; it = mPolls[it].nextDispatch)
+        {
+            if (it != slot)
+            {
+                previous = it;
+                continue;
+            }
+
+            const uint32_t next = mPolls[slot].nextDispatch;
+            if (previous == SH_NO_SLOT)
+            {
+                queue.head = next;
+            }
+            else
+            {
+                mPolls[previous].nextDispatch = next;
+            }
+
+            if (queue.tail == slot)
+            {
+                queue.tail = previous;
+            }
+
+            mPolls[slot].dispatchPending = false;
+            mPolls[slot].nextDispatch    = SH_NO_SLOT;
+            return;
+        }
+    }
+}
+
+/**
+ * dispatches the queued polls, highest priority first. A poll which wants to dispatch again is
+ * put at the end of its queue. Stops when the dispatch budget is used up.
+ */
+void CAmSocketHandler::dispatch()
+{
+    unsigned budget = mDispatchBudget;
+    for (auto &queue : mDispatchQueues)
+    {
+        while (queue.head != SH_NO_SLOT)
+        {
+            if (budget == 0)
+            {
+                return;
+            }
+
+            const uint32_t slot = queue.head;
+            sh_poll_s     &poll = mPolls[slot];
+            queue.head = poll.nextDispatch;
+            if (queue.head == SH_NO_SLOT)
+            {
+                queue.tail = SH_NO_SLOT;
+            }
+
+            poll.dispatchPending = false;
+            poll.nextDispatch    = SH_NO_SLOT;
+            --budget;
+
+            const bool measure = mStatistics.enabled;
+            timespec   start;
+            if (measure)
+            {
+                clock_gettime(CLOCK_MONOTONIC, &start);
+            }
+
+            const bool dispatchAgain = !CAmSocketHandler::dispatchingFinished(&poll);
+            if (measure && poll.dispatchCB)
+            {
+                recordCallback(poll.statistics.dispatch, poll.handle, start);
+            }
+
+            if (dispatchAgain)
+            {
+                queueDispatch(slot);
+            }
+        }
+    }
+}
+
 /**
  * is used to set the pointer for the ppoll command
  * @param buffertime
@@ -1186,6 +1819,14 @@ bool CAmSocketHandler::dispatchingFinished(const sh_poll_s *a)
  */
 inline timespec *CAmSocketHandler::insertTime(timespec &buffertime)
 {
+    // do not block while dispatching is pending
+    if (dispatchPending())
+    {
+        buffertime.tv_sec  = 0;
+        buffertime.tv_nsec = 0;
+        return (&buffertime);
+    }
+
 #ifndef WITH_TIMERFD
     if (!mListActiveTimer.empty())
     {
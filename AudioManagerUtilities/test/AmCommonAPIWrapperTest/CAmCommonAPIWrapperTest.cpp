@@ -0,0 +1,127 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#include "CAmCommonAPIWrapperTest.h"
+
+using namespace testing;
+using namespace am;
+
+CAmDelayedDispatchSource::CAmDelayedDispatchSource(CAmSocketHandler *socketHandler, const std::chrono::milliseconds &delay)
+    : mpSocketHandler(socketHandler)
+    , mReadyTime(std::chrono::steady_clock::now() + delay)
+    , prepared(0)
+    , dispatched(0)
+{
+}
+
+bool CAmDelayedDispatchSource::prepare(int64_t &timeout)
+{
+    prepared++;
+    if (check())
+    {
+        return (true);
+    }
+
+    // round up, an early prepare would only ask for another round
+    const auto remaining = std::chrono::duration_cast<std::chrono::microseconds>(mReadyTime - std::chrono::steady_clock::now());
+    timeout = (remaining.count() + 999) / 1000;
+    return (false);
+}
+
+bool CAmDelayedDispatchSource::check()
+{
+    return (std::chrono::steady_clock::now() >= mReadyTime);
+}
+
+bool CAmDelayedDispatchSource::dispatch()
+{
+    dispatched++;
+    mpSocketHandler->stop_listening();
+    return (false);
+}
+
+CAmCommonAPIWrapperTest::CAmCommonAPIWrapperTest()
+    : mSocketHandler()
+    , mpWrapper(NULL)
+{
+}
+
+CAmCommonAPIWrapperTest::~CAmCommonAPIWrapperTest()
+{
+}
+
+void CAmCommonAPIWrapperTest::SetUp()
+{
+    mpWrapper = CAmCommonAPIWrapper::instantiateOnce(&mSocketHandler);
+}
+
+void CAmCommonAPIWrapperTest::TearDown()
+{
+    CAmCommonAPIWrapper::deleteInstance();
+    mpWrapper = NULL;
+}
+
+TEST_F(CAmCommonAPIWrapperTest, sourceReadyAfterItsTimeout)
+{
+    const std::chrono::milliseconds delay(100);
+    CAmDelayedDispatchSource source(&mSocketHandler, delay);
+    std::shared_ptr<CommonAPI::MainLoopContext> context(mpWrapper->getMainLoopContext());
+    const auto start = std::chrono::steady_clock::now();
+
+    // nothing else wakes up the mainloop, only the timeout of the source brings it back
+    context->registerDispatchSource(&source);
+    ASSERT_EQ(mSocketHandler.postDelayed(timespec{2, 0}, [this](){
+                mSocketHandler.stop_listening();
+            }), E_OK);
+    mSocketHandler.start_listenting();
+
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_EQ(source.dispatched, 1u);
+    EXPECT_GE(source.prepared, 2u);
+    EXPECT_GE(elapsed, delay);
+    EXPECT_LT(elapsed, std::chrono::seconds(2));
+
+    context->deregisterDispatchSource(&source);
+}
+
+TEST_F(CAmCommonAPIWrapperTest, readySourceIsNotPreparedAgain)
+{
+    CAmDelayedDispatchSource source(&mSocketHandler, std::chrono::milliseconds(0));
+    std::shared_ptr<CommonAPI::MainLoopContext> context(mpWrapper->getMainLoopContext());
+
+    // after the dispatch no source has a timeout left, so the prepare timer must not fire
+    context->registerDispatchSource(&source);
+    mSocketHandler.start_listenting();
+    ASSERT_EQ(source.dispatched, 1u);
+
+    ASSERT_EQ(mSocketHandler.postDelayed(timespec{0, 200000000}, [this](){
+                mSocketHandler.stop_listening();
+            }), E_OK);
+    mSocketHandler.start_listenting();
+    EXPECT_EQ(source.prepared, 1u);
+    EXPECT_EQ(source.dispatched, 1u);
+
+    context->deregisterDispatchSource(&source);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,62 @@
+/**
+ * SPDX license identifier: MPL-2.0
+ *
+ * Copyright (C) 2012, BMW AG
+ *
+ * This file is part of GENIVI Project AudioManager.
+ *
+ * Contributions are licensed to the GENIVI Alliance under one or more
+ * Contribution License Agreements.
+ *
+ * \copyright
+ * This Source Code Form is subject to the terms of the
+ * Mozilla Public License, v. 2.0. If a  copy of the MPL was not distributed with
+ * this file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ *
+ * For further information see http://www.genivi.org/.
+ *
+ */
+
+#ifndef COMMONAPIWRAPPERTEST_H_
+#define COMMONAPIWRAPPERTEST_H_
+
+#include <chrono>
+#include "gtest/gtest.h"
+#include "CAmCommonAPIWrapper.h"
+#include "CAmSocketHandler.h"
+
+namespace am
+{
+
+    /**
+     * a dispatch source that is not ready before the given delay has passed, it asks to be
+     * prepared again when the delay expires and stops the mainloop when it is dispatched.
+     */
+    class CAmDelayedDispatchSource: public CommonAPI::DispatchSource
+    {
+        CAmSocketHandler *mpSocketHandler;
+        std::chrono::steady_clock::time_point mReadyTime;
+    public:
+        CAmDelayedDispatchSource(CAmSocketHandler *socketHandler, const std::chrono::milliseconds &delay);
+        virtual bool prepare(int64_t &timeout);
+        virtual bool check();
+        virtual bool dispatch();
+
+        unsigned prepared;
+        unsigned dispatched;
+    };
+
+    class CAmCommonAPIWrapperTest: public ::testing::Test
+    {
+    public:
+        CAmCommonAPIWrapperTest();
+        ~CAmCommonAPIWrapperTest();
+        void SetUp();
+        void TearDown();
+
+        CAmSocketHandler mSocketHandler;
+        CAmCommonAPIWrapper *mpWrapper;
+    };
+
+} /* namespace am */
+#endif /* COMMONAPIWRAPPERTEST_H_ */
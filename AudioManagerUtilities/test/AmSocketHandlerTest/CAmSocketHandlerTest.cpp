@@ -32,6 +32,8 @@
 #include <sys/un.h>
 #include <sys/poll.h>
 #include <sys/eventfd.h>
+#include <thread>
+#include <memory>
 #include "CAmLogWrapper.h"
 #include "CAmSocketHandler.h"
 
@@ -52,6 +54,31 @@ static const char * TEST_SOCKET_DATA_FINAL = "finish!";
 
 static const std::chrono::time_point<std::chrono::high_resolution_clock> TP_ZERO;
 
+// allocation counting hook, counts only while enabled
+static bool   gCountAllocations = false;
+static size_t gAllocations      = 0;
+
+void *operator new(size_t size)
+{
+    if (gCountAllocations)
+    {
+        ++gAllocations;
+    }
+
+    void *ptr = malloc(size == 0 ? 1 : size);
+    if (ptr == NULL)
+    {
+        throw std::bad_alloc();
+    }
+
+    return ptr;
+}
+
+void operator delete(void *ptr) noexcept
+{
+    free(ptr);
+}
+
 struct TestUserData
 {
     int i;
@@ -387,6 +414,317 @@ TEST(CAmSocketHandlerTest, fdTest)
     ASSERT_FALSE(myHandler.fatalErrorOccurred());
 }
 
+TEST(CAmSocketHandlerTest, dispatchBudgetBoundsTimerLatency)
+{
+    CAmSocketHandler myHandler;
+    ASSERT_FALSE(myHandler.fatalErrorOccurred());
+
+    // a flooding source: the eventfd is never read, so it fires in every iteration and always wants to dispatch again
+    const auto floodDeadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    unsigned   floodDispatches = 0;
+    int        floodFd = eventfd(1, EFD_NONBLOCK);
+    sh_pollHandle_t floodHandle;
+    ASSERT_EQ(myHandler.addFDPoll(floodFd, POLLIN,
+            NULL,
+            [](const pollfd, const sh_pollHandle_t, void *){},
+            [](const sh_pollHandle_t, void *){ return true; },
+            [&](const sh_pollHandle_t, void *){
+                ++floodDispatches;
+                const auto busyUntil = std::chrono::steady_clock::now() + std::chrono::microseconds(200);
+                while (std::chrono::steady_clock::now() < busyUntil)
+                {
+                }
+                // safety net, an unbounded dispatch loop would never reach the timer otherwise
+                return (std::chrono::steady_clock::now() < floodDeadline);
+            },
+            NULL, floodHandle), E_OK);
+    ASSERT_EQ(myHandler.setPollPriority(floodHandle, SH_PRIORITY_LOW), E_OK);
+    ASSERT_EQ(myHandler.setPollPriority(floodHandle, SH_PRIORITY_MAX), E_NOT_POSSIBLE);
+    ASSERT_EQ(myHandler.setPollPriority(0xFFFF, SH_PRIORITY_HIGH), E_UNKNOWN);
+    myHandler.setDispatchBudget(16);
+
+    // a 10ms timer, measure the lateness of each tick
+    const timespec timeoutTime{0, 10000000};
+    const unsigned ticks = 20;
+    std::chrono::microseconds maxLateness(0);
+    unsigned   tickCount = 0;
+    auto       lastTick = std::chrono::steady_clock::now();
+    sh_timerHandle_t timerHandle;
+    ASSERT_EQ(myHandler.addTimer(timeoutTime, [&](const sh_timerHandle_t handle, void *){
+                const auto now = std::chrono::steady_clock::now();
+                maxLateness = std::max(maxLateness,
+                        std::chrono::duration_cast<std::chrono::microseconds>(now - lastTick) - std::chrono::microseconds(timeoutTime.tv_nsec / 1000));
+                lastTick = now;
+                if (++tickCount == ticks)
+                {
+                    myHandler.stop_listening();
+                }
+                else
+                {
+                    myHandler.restartTimer(handle);
+                }
+            }, timerHandle, NULL), E_OK);
+
+    myHandler.start_listenting();
+
+    EXPECT_EQ(tickCount, ticks);
+    EXPECT_GT(floodDispatches, ticks);
+    // one iteration dispatches at most 16 * 200us, allow generous slack for loaded machines
+    EXPECT_LT(maxLateness, std::chrono::milliseconds(50));
+#ifdef ENABLED_TIMERS_TEST_OUTPUT
+    std::cout << "max timer lateness " << maxLateness.count() << "us, flood dispatches " << floodDispatches << std::endl;
+#endif
+
+    ASSERT_EQ(myHandler.removeFDPoll(floodHandle), E_OK);
+    close(floodFd);
+    ASSERT_FALSE(myHandler.fatalErrorOccurred());
+}
+
+TEST(CAmSocketHandlerTest, steadyStateWithoutAllocations)
+{
+    CAmSocketHandler myHandler;
+    ASSERT_FALSE(myHandler.fatalErrorOccurred());
+
+    const unsigned warmup     = 10;
+    const unsigned iterations = 1000;
+    unsigned       count      = 0;
+    size_t         allocations = 0;
+    unsigned       failedReads = 0;
+
+    // the busy source is never read, so it fires in every iteration and wakes up the idle one
+    int busyFd = eventfd(1, EFD_NONBLOCK);
+    int idleFd = eventfd(0, EFD_NONBLOCK);
+    sh_pollHandle_t busyHandle, idleHandle;
+    ASSERT_EQ(myHandler.addFDPoll(busyFd, POLLIN, NULL,
+            [&](const pollfd, const sh_pollHandle_t, void *){
+                if (++count == warmup)
+                {
+                    gAllocations      = 0;
+                    gCountAllocations = true;
+                }
+                else if (count == warmup + iterations)
+                {
+                    gCountAllocations = false;
+                    allocations       = gAllocations;
+                    myHandler.stop_listening();
+                }
+            },
+            [](const sh_pollHandle_t, void *){ return true; },
+            [idleFd](const sh_pollHandle_t, void *){
+                uint64_t value = 1;
+                return (write(idleFd, &value, sizeof(value)) < 0);
+            },
+            NULL, busyHandle), E_OK);
+    ASSERT_EQ(myHandler.addFDPoll(idleFd, POLLIN, NULL,
+            [&failedReads](const pollfd pollfd, const sh_pollHandle_t, void *){
+                uint64_t value;
+                if (read(pollfd.fd, &value, sizeof(value)) != sizeof(value))
+                {
+                    ++failedReads;
+                }
+            },
+            [](const sh_pollHandle_t, void *){ return true; },
+            [](const sh_pollHandle_t, void *){ return false; },
+            NULL, idleHandle), E_OK);
+
+    myHandler.start_listenting();
+
+    EXPECT_EQ(count, warmup + iterations);
+    EXPECT_EQ(allocations, 0u);
+    EXPECT_EQ(failedReads, 0u);
+
+    ASSERT_EQ(myHandler.removeFDPoll(busyHandle), E_OK);
+    ASSERT_EQ(myHandler.removeFDPoll(idleHandle), E_OK);
+    close(busyFd);
+    close(idleFd);
+    ASSERT_FALSE(myHandler.fatalErrorOccurred());
+}
+
+TEST(CAmSocketHandlerTest, removeFDPollReleasesCallbacks)
+{
+    CAmSocketHandler myHandler;
+    ASSERT_FALSE(myHandler.fatalErrorOccurred());
+
+    std::shared_ptr<int> captured = std::make_shared<int>(0);
+    auto fired = [captured](const pollfd, const sh_pollHandle_t, void *){};
+    int fd = eventfd(0, EFD_NONBLOCK);
+    sh_pollHandle_t handle;
+
+    // never polled, the slot is freed right away
+    ASSERT_EQ(myHandler.addFDPoll(fd, POLLIN, NULL, fired, NULL, NULL, NULL, handle), E_OK);
+    ASSERT_EQ(captured.use_count(), 3);
+    ASSERT_EQ(myHandler.removeFDPoll(handle), E_OK);
+    EXPECT_EQ(captured.use_count(), 2);
+
+    // polled, the slot is freed by the mainloop
+    ASSERT_EQ(myHandler.addFDPoll(fd, POLLIN, NULL, fired, NULL, NULL, NULL, handle), E_OK);
+    ASSERT_EQ(myHandler.post([&](){
+                ASSERT_EQ(myHandler.removeFDPoll(handle), E_OK);
+            }), E_OK);
+    ASSERT_EQ(myHandler.postDelayed(timespec{0, 1000000}, [&](){
+                myHandler.stop_listening();
+            }), E_OK);
+    myHandler.start_listenting();
+    EXPECT_EQ(captured.use_count(), 2);
+
+    close(fd);
+    ASSERT_FALSE(myHandler.fatalErrorOccurred());
+}
+
+TEST(CAmSocketHandlerTest, postFromOtherThreads)
+{
+    CAmSocketHandler myHandler;
+    ASSERT_FALSE(myHandler.fatalErrorOccurred());
+
+    const unsigned threads = 4;
+    const unsigned posts   = 1000;
+    std::vector<unsigned> nextPost(threads, 0);
+    unsigned executed   = 0;
+    bool     inOrder    = true;
+    bool     onMainloop = true;
+    bool     delayedCalled = false;
+    std::chrono::milliseconds delayedAfter(0);
+    const pthread_t mainloopThread = pthread_self();
+
+    auto finish = [&](){
+            if (executed == threads * posts && delayedCalled)
+            {
+                myHandler.stop_listening();
+            }
+        };
+
+    ASSERT_EQ(myHandler.post(std::function<void()>()), E_NOT_POSSIBLE);
+
+    const auto postTime = std::chrono::steady_clock::now();
+    const timespec delay{0, 100000000};
+    ASSERT_EQ(myHandler.postDelayed(delay, [&](){
+                delayedAfter  = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - postTime);
+                delayedCalled = true;
+                finish();
+            }), E_OK);
+
+    std::vector<std::thread> workers;
+    for (unsigned thread = 0; thread < threads; ++thread)
+    {
+        workers.emplace_back([&, thread](){
+                for (unsigned i = 0; i < posts; ++i)
+                {
+                    myHandler.post([&, thread, i](){
+                            inOrder    &= (nextPost[thread] == i);
+                            onMainloop &= (pthread_equal(pthread_self(), mainloopThread) != 0);
+                            nextPost[thread] = i + 1;
+                            ++executed;
+                            finish();
+                        });
+                }
+            });
+    }
+
+    myHandler.start_listenting();
+    for (auto &worker : workers)
+    {
+        worker.join();
+    }
+
+    EXPECT_EQ(executed, threads * posts);
+    EXPECT_TRUE(inOrder);
+    EXPECT_TRUE(onMainloop);
+    EXPECT_TRUE(delayedCalled);
+    EXPECT_GE(delayedAfter, std::chrono::milliseconds(100));
+    ASSERT_FALSE(myHandler.fatalErrorOccurred());
+}
+
+TEST(CAmSocketHandlerTest, statistics)
+{
+    CAmSocketHandler myHandler;
+    ASSERT_FALSE(myHandler.fatalErrorOccurred());
+
+    // a busy source which takes 1ms per dispatch
+    unsigned   dispatches = 0;
+    int        busyFd = eventfd(1, EFD_NONBLOCK);
+    sh_pollHandle_t busyHandle;
+    ASSERT_EQ(myHandler.addFDPoll(busyFd, POLLIN, NULL,
+            [](const pollfd, const sh_pollHandle_t, void *){},
+            [&](const sh_pollHandle_t, void *){ return (dispatches < 20); },
+            [&](const sh_pollHandle_t, void *){
+                ++dispatches;
+                std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                return false;
+            },
+            NULL, busyHandle), E_OK);
+
+    // a 10ms timer which runs 10 times while statistics are enabled
+    myHandler.enableStatistics(true);
+    const timespec timeoutTime{0, 10000000};
+    unsigned   ticks = 0;
+    sh_timerHandle_t timerHandle;
+    ASSERT_EQ(myHandler.addTimer(timeoutTime, [&](const sh_timerHandle_t handle, void *){
+                if (++ticks == 10)
+                {
+                    myHandler.stop_listening();
+                }
+                else
+                {
+                    myHandler.restartTimer(handle);
+                }
+            }, timerHandle, NULL), E_OK);
+
+    myHandler.start_listenting();
+
+    sh_statistics_s statistics;
+    myHandler.getStatistics(statistics);
+    EXPECT_TRUE(statistics.enabled);
+    EXPECT_GT(statistics.iterations, 10u);
+    EXPECT_GT(statistics.blockedNs, 0u);
+    EXPECT_GE(statistics.workingNs, 20u * 1000000u);
+    EXPECT_GE(statistics.longestCallbackNs, 1000000u);
+    EXPECT_EQ(statistics.longestCallbackHandle, busyHandle);
+
+    auto poll = std::find_if(statistics.polls.begin(), statistics.polls.end(), [&](const sh_pollStatistics_s &it){
+            return (it.handle == busyHandle);
+        });
+    ASSERT_NE(poll, statistics.polls.end());
+    EXPECT_EQ(poll->fd, busyFd);
+    EXPECT_GT(poll->fire.calls, 20u);
+    EXPECT_EQ(poll->dispatch.calls, 20u);
+    EXPECT_GE(poll->dispatch.totalNs, 20u * 1000000u);
+    EXPECT_GE(poll->dispatch.maxNs, 1000000u);
+
+    auto timer = std::find_if(statistics.timers.begin(), statistics.timers.end(), [&](const sh_timerStatistics_s &it){
+            return (it.handle == timerHandle);
+        });
+    ASSERT_NE(timer, statistics.timers.end());
+    EXPECT_EQ(timer->expiries, 10u);
+    uint64_t histogram = 0;
+    for (unsigned bucket = 0; bucket < SH_LATENESS_BUCKETS; ++bucket)
+    {
+        histogram += timer->lateness[bucket];
+    }
+
+    EXPECT_EQ(histogram, timer->expiries);
+    EXPECT_LT(timer->maxLatenessNs, 1000000000u);
+    myHandler.dumpStatistics();
+
+    // nothing is collected while disabled
+    myHandler.resetStatistics();
+    myHandler.enableStatistics(false);
+    ticks = 0;
+    ASSERT_EQ(myHandler.restartTimer(timerHandle), E_OK);
+    myHandler.start_listenting();
+    myHandler.getStatistics(statistics);
+    EXPECT_FALSE(statistics.enabled);
+    EXPECT_EQ(statistics.iterations, 0u);
+    EXPECT_EQ(statistics.longestCallbackNs, 0u);
+    for (const auto &it : statistics.polls)
+    {
+        EXPECT_EQ(it.fire.calls, 0u);
+    }
+
+    ASSERT_EQ(myHandler.removeFDPoll(busyHandle), E_OK);
+    close(busyFd);
+    ASSERT_FALSE(myHandler.fatalErrorOccurred());
+}
+
 TEST(CAmSocketHandlerTest, timersOneshot)
 {
     CAmSocketHandler myHandler;
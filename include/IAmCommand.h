@@ -33,7 +33,7 @@ class CAmSocketHandler;
 
 #include "audiomanagertypes.h"
 
-#define CommandVersion "4.1" 
+#define CommandVersion "4.2" 
 namespace am {
 
 /**
@@ -235,6 +235,24 @@ public:
 	 * Returns the current volume for the sink directly out of the database.
 	 */
 	virtual am_Error_e getVolume(const am_sinkID_t sinkID, am_mainVolume_t& mainVolume) const =0;
+	/**
+	 * returns the version of the change journal of the database. Every change of sinks, sources,
+	 * main connections and system properties increases the version.
+	 */
+	virtual uint32_t getJournalVersion() const =0;
+	/**
+	 * returns all changes made after the given version, oldest first. This allows a command plugin
+	 * to update its view of the database without reading all lists again.
+	 * @return E_OK on success, E_NOT_POSSIBLE if the changes are not in the journal anymore. In
+	 * that case the plugin has to resync with getJournalSnapshot.
+	 */
+	virtual am_Error_e getJournalChanges(const uint32_t sinceVersion, std::vector<am_JournalEntry_s>& listChanges) const =0;
+	/**
+	 * returns the main sinks, sources, connections and system properties together with the
+	 * journal version they belong to.
+	 * @return E_OK on success
+	 */
+	virtual am_Error_e getJournalSnapshot(am_JournalSnapshot_s& snapshot) const =0;
 
 };
 
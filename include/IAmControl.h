@@ -32,7 +32,7 @@ class CAmSocketHandler;
 
 #include "audiomanagertypes.h"
 
-#define ControlVersion "6.0"
+#define ControlVersion "6.1"
 namespace am {
 
 /**
@@ -699,6 +699,88 @@ public:
 	 * 	@return E_OK on success, handle removed, E_NON_EXISTENT in case the handle was not foud
 	 */
 	virtual am_Error_e removeHandle(const am_Handle_s handle) = 0; 
+	/**
+	 * enters several sinks in the database in one transaction. Every sink is
+	 * handled like in enterSinkDB, but the observers are informed only once about
+	 * all new sinks.
+	 * listSinkIDs contains the ID for every sink in the order of listSinkData, 0 if
+	 * the sink could not be entered.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e enterSinksDB(const std::vector<am_Sink_s>& listSinkData, std::vector<am_sinkID_t>& listSinkIDs) =0;
+	/**
+	 * enters several sources in the database in one transaction. Every source is
+	 * handled like in enterSourceDB, but the observers are informed only once about
+	 * all new sources.
+	 * listSourceIDs contains the ID for every source in the order of listSourceData,
+	 * 0 if the source could not be entered.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e enterSourcesDB(const std::vector<am_Source_s>& listSourceData, std::vector<am_sourceID_t>& listSourceIDs) =0;
+	/**
+	 * removes several sinks from the DB, the observers are informed only once.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e removeSinksDB(const std::vector<am_sinkID_t>& listSinkIDs) =0;
+	/**
+	 * removes several sources from the DB, the observers are informed only once.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e removeSourcesDB(const std::vector<am_sourceID_t>& listSourceIDs) =0;
+	/**
+	 * enables or disables caching of the answers of IAmControlSend::getConnectionFormatChoice. With the cache enabled the
+	 * router asks only once for every combination of sourceID, sinkID and possible connection formats, the route that is
+	 * passed along is not part of the key. The cache is cleared whenever the routing topology changes, disabling the
+	 * cache clears it as well.
+	 */
+	virtual void setConnectionFormatChoiceCaching(const bool enable) =0;
+	/**
+	 * clears the cache of connection format choices. A controller that uses the cache has to call this whenever its
+	 * choices change, for example because of a changed system state.
+	 */
+	virtual void invalidateConnectionFormatChoices() =0;
+	/**
+	 * calculates the routes from a source to several sinks in one search, this is much faster than calling getRoute for
+	 * every sink. For every sink the same routes are returned as getRoute would return.
+	 * @param listSinkIDs the sinks to calculate routes to, all sinks if the list is empty.
+	 * @param returnList the routes grouped by sink, sinks without a route are left out.
+	 * @return E_OK if at least one route was found, E_NON_EXISTENT if the source does not exist, E_NOT_POSSIBLE otherwise
+	 */
+	virtual am_Error_e getRoutesToAllSinks(const bool onlyfree, const am_sourceID_t sourceID, const std::vector<am_sinkID_t>& listSinkIDs, std::vector<am_Route_s>& returnList) =0;
+	/**
+	 * calculates the routes from several sources to a sink in one search, this is much faster than calling getRoute for
+	 * every source. For every source the same routes are returned as getRoute would return, routes with the same
+	 * length may come in a different order.
+	 * @param listSourceIDs the sources to calculate routes from, all sources if the list is empty.
+	 * @param returnList the routes grouped by source, sources without a route are left out.
+	 * @return E_OK if at least one route was found, E_NON_EXISTENT if the sink does not exist, E_NOT_POSSIBLE otherwise
+	 */
+	virtual am_Error_e getRoutesFromAllSources(const bool onlyfree, const am_sinkID_t sinkID, const std::vector<am_sourceID_t>& listSourceIDs, std::vector<am_Route_s>& returnList) =0;
+	/**
+	 * calculates the routes for several pairs of sources and sinks. The routing graph is searched for the pairs in
+	 * parallel on the routing threads of the AudioManager, getConnectionFormatChoice is still called on the mainloop.
+	 * @param listPairs the sourceIDs and sinkIDs to calculate routes for.
+	 * @param listRoutes the routes of every pair at the same position as the pair, empty if there is none.
+	 * @return E_OK if routes were found for all pairs, E_NON_EXISTENT if a source or sink does not exist, E_NOT_POSSIBLE otherwise
+	 */
+	virtual am_Error_e getRoutes(const bool onlyfree, const std::vector<std::pair<am_sourceID_t, am_sinkID_t> >& listPairs, std::vector<std::vector<am_Route_s> >& listRoutes) =0;
+	/**
+	 * returns the version of the change journal of the database. Every change of sinks, sources,
+	 * main connections and system properties increases the version.
+	 */
+	virtual uint32_t getJournalVersion() const =0;
+	/**
+	 * returns all changes made after the given version, oldest first.
+	 * @return E_OK on success, E_NOT_POSSIBLE if the changes are not in the journal anymore. In
+	 * that case the controller has to resync with getJournalSnapshot.
+	 */
+	virtual am_Error_e getJournalChanges(const uint32_t sinceVersion, std::vector<am_JournalEntry_s>& listChanges) const =0;
+	/**
+	 * returns the main sinks, sources, connections and system properties together with the
+	 * journal version they belong to.
+	 * @return E_OK on success
+	 */
+	virtual am_Error_e getJournalSnapshot(am_JournalSnapshot_s& snapshot) const =0;
 
 };
 
@@ -1065,6 +1147,83 @@ public:
 	 * This hook is fired whenever the timing information of a connection has changed.
 	 */
 	virtual void hookSystemSingleTimingInformationChanged(const am_connectionID_t connectionID, const am_timeSync_t time) =0;
+	/**
+	 * is called when a routing adaptor registers several sinks at once. A controller
+	 * should enter them with IAmControlReceive::enterSinksDB to keep the batch.
+	 * The default implementation calls hookSystemRegisterSink for every sink.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e hookSystemRegisterSinks(const std::vector<am_Sink_s>& listSinkData, std::vector<am_sinkID_t>& listSinkIDs)
+	{
+		am_Error_e error = E_OK;
+		listSinkIDs.assign(listSinkData.size(), 0);
+		for (size_t i = 0; i < listSinkData.size(); i++)
+		{
+			am_Error_e result = hookSystemRegisterSink(listSinkData[i], listSinkIDs[i]);
+			if (result != E_OK && error == E_OK)
+			{
+				error = result;
+			}
+		}
+		return error;
+	}
+	/**
+	 * is called when a routing adaptor deregisters several sinks at once.
+	 * The default implementation calls hookSystemDeregisterSink for every sink.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e hookSystemDeregisterSinks(const std::vector<am_sinkID_t>& listSinkIDs)
+	{
+		am_Error_e error = E_OK;
+		for (size_t i = 0; i < listSinkIDs.size(); i++)
+		{
+			am_Error_e result = hookSystemDeregisterSink(listSinkIDs[i]);
+			if (result != E_OK && error == E_OK)
+			{
+				error = result;
+			}
+		}
+		return error;
+	}
+	/**
+	 * is called when a routing adaptor registers several sources at once. A
+	 * controller should enter them with IAmControlReceive::enterSourcesDB to keep the
+	 * batch.
+	 * The default implementation calls hookSystemRegisterSource for every source.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e hookSystemRegisterSources(const std::vector<am_Source_s>& listSourceData, std::vector<am_sourceID_t>& listSourceIDs)
+	{
+		am_Error_e error = E_OK;
+		listSourceIDs.assign(listSourceData.size(), 0);
+		for (size_t i = 0; i < listSourceData.size(); i++)
+		{
+			am_Error_e result = hookSystemRegisterSource(listSourceData[i], listSourceIDs[i]);
+			if (result != E_OK && error == E_OK)
+			{
+				error = result;
+			}
+		}
+		return error;
+	}
+	/**
+	 * is called when a routing adaptor deregisters several sources at once.
+	 * The default implementation calls hookSystemDeregisterSource for every source.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e hookSystemDeregisterSources(const std::vector<am_sourceID_t>& listSourceIDs)
+	{
+		am_Error_e error = E_OK;
+		for (size_t i = 0; i < listSourceIDs.size(); i++)
+		{
+			am_Error_e result = hookSystemDeregisterSource(listSourceIDs[i]);
+			if (result != E_OK && error == E_OK)
+			{
+				error = result;
+			}
+		}
+		return error;
+	}
 
 
 };
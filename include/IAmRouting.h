@@ -35,7 +35,7 @@ class CAmSocketHandler;
 
 #include "audiomanagertypes.h"
 
-#define RoutingVersion "6.0"
+#define RoutingVersion "6.1"
 namespace am {
 
 /**
@@ -365,6 +365,32 @@ public:
 	 * E_OK in case of success
 	 */
 	virtual am_Error_e getDomainOfCrossfader(const am_crossfaderID_t crossfader, am_domainID_t& domainID) const = 0;
+	/**
+	 * Registers several sinks in one call. The sinks are handed to the controller and
+	 * entered into the database as one batch, observers are notified once.
+	 * listSinkIDs contains the ID for every sink in the order of listSinkData, 0 if
+	 * the sink could not be registered.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e registerSinks(const std::vector<am_Sink_s>& listSinkData, std::vector<am_sinkID_t>& listSinkIDs) =0;
+	/**
+	 * deregisters several sinks in one call.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e deregisterSinks(const std::vector<am_sinkID_t>& listSinkIDs) =0;
+	/**
+	 * Registers several sources in one call. The sources are handed to the controller
+	 * and entered into the database as one batch, observers are notified once.
+	 * listSourceIDs contains the ID for every source in the order of listSourceData, 0
+	 * if the source could not be registered.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e registerSources(const std::vector<am_Source_s>& listSourceData, std::vector<am_sourceID_t>& listSourceIDs) =0;
+	/**
+	 * deregisters several sources in one call.
+	 * @return E_OK on success, otherwise the first error that occured
+	 */
+	virtual am_Error_e deregisterSources(const std::vector<am_sourceID_t>& listSourceIDs) =0;
 
 };
 
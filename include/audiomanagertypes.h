@@ -1476,6 +1476,76 @@ public:
 	 */
 	am_time_t time;
 
+};
+
+/**
+ * the elements tracked by the change journal of the database
+ */
+enum am_JournalElement_e
+{
+	/**
+	 * elementID is a sinkID
+	 */
+	JE_SINK = 0,
+	/**
+	 * elementID is a sourceID
+	 */
+	JE_SOURCE = 1,
+	/**
+	 * elementID is a mainConnectionID
+	 */
+	JE_MAIN_CONNECTION = 2,
+	/**
+	 * elementID is the type of the system property
+	 */
+	JE_SYSTEM_PROPERTY = 3
+};
+
+/**
+ * the kind of change recorded in the change journal of the database
+ */
+enum am_JournalOperation_e
+{
+	JO_ADDED = 0,
+	JO_CHANGED = 1,
+	JO_REMOVED = 2
+};
+
+/**
+ * one change of the database. Only the element is named, the current values have
+ * to be read with the usual getters.
+ */
+struct am_JournalEntry_s
+{
+
+public:
+	/**
+	 * version of the database after the change
+	 */
+	uint32_t version;
+	am_JournalElement_e element;
+	am_JournalOperation_e operation;
+	uint16_t elementID;
+
+};
+
+/**
+ * full state of the database as seen by the command side, used to resync when the
+ * journal does not reach back far enough.
+ */
+struct am_JournalSnapshot_s
+{
+
+public:
+	/**
+	 * journal version the snapshot belongs to
+	 */
+	uint32_t version;
+	std::vector<am_SinkType_s> listMainSinks;
+	std::vector<am_SourceType_s> listMainSources;
+	std::vector<am_MainConnectionType_s> listMainConnections;
+	std::vector<am_SystemProperty_s> listSystemProperties;
+
 };
 }
 #endif // !defined(EA_E0F066FD_E6D8_4ca9_84C3_D0C02AF09BF8__INCLUDED_)